@@ -1,16 +1,69 @@
 'use server';
 
 import { exec } from 'child_process';
+import { constants as fsConstants } from 'fs';
+import fs from 'fs/promises';
 import { promisify } from 'util';
-import { AssemblyData, AssemblyInstruction } from '@/types/profiler';
+import { AssemblyData, AssemblyInstruction, FunctionSymbol } from '@/types/profiler';
+import { ElfFile, isElf, parseElf } from '@/lib/elf';
+import { disassembleRange, hasBuiltinDisassembler } from '@/lib/disassembler';
 
 const execAsync = promisify(exec);
 
+// Object files read in-process, kept while unchanged; the oldest is dropped past the limit
+const MAX_CACHED_IMAGES = 8;
+const imageCache = new Map<string, { mtimeMs: number; buffer: Buffer; elf: ElfFile }>();
+
+// The parsed ELF image of an object file, or null when it is not ELF
+async function loadImage(objectFile: string): Promise<{ buffer: Buffer; elf: ElfFile } | null> {
+  const stats = await fs.stat(objectFile);
+  let image = imageCache.get(objectFile);
+  if (!image || image.mtimeMs !== stats.mtimeMs) {
+    const buffer = await fs.readFile(objectFile);
+    if (!isElf(buffer)) return null;
+    image = { mtimeMs: stats.mtimeMs, buffer, elf: parseElf(buffer) };
+    imageCache.delete(objectFile);
+    imageCache.set(objectFile, image);
+    if (imageCache.size > MAX_CACHED_IMAGES) {
+      imageCache.delete(imageCache.keys().next().value!);
+    }
+  }
+  return image;
+}
+
+/**
+ * Disassemble [startAddress, endAddress) without objdump when the object
+ * is an ELF file for an architecture with a built-in decoder (RISC-V,
+ * AArch64). Returns null for anything else, e.g. x86-64 objects.
+ */
+async function disassembleInProcess(
+  objectFile: string,
+  startAddress: string,
+  endAddress: string
+): Promise<AssemblyData | null> {
+  try {
+    const image = await loadImage(objectFile);
+    if (!image || !hasBuiltinDisassembler(image.elf)) return null;
+
+    const instructions = disassembleRange(image.buffer, image.elf, parseInt(startAddress, 16), parseInt(endAddress, 16));
+    return instructions ? { startAddress, endAddress, instructions } : null;
+  } catch {
+    return null;
+  }
+}
+
+/**
+ * Disassemble [startAddress, endAddress). RISC-V and AArch64 objects are
+ * decoded in-process unless source lines are wanted; those, and every other
+ * architecture, go through objdump, falling back to the built-in decoder
+ * (without source lines) when objdump fails or lists nothing.
+ */
 export async function getAssemblyCode(
   objectFile: string,
   startAddress: string,
   endAddress: string,
-  objdumpCommand: string = 'objdump'
+  objdumpCommand: string = 'objdump',
+  withLineNumbers: boolean = false
 ): Promise<AssemblyData | null> {
   try {
     // Validate input
@@ -21,14 +74,19 @@ export async function getAssemblyCode(
 
     // Check if file exists and is readable
     try {
-      await execAsync(`test -r "${objectFile}"`);
+      await fs.access(objectFile, fsConstants.R_OK);
     } catch (error) {
       // Silently fail without logging to console
       throw new Error(`Cannot access file: ${objectFile}. Please check file permissions.`);
     }
 
+    if (!withLineNumbers) {
+      const builtin = await disassembleInProcess(objectFile, startAddress, endAddress);
+      if (builtin) return builtin;
+    }
+
     // Construct objdump command with proper escaping
-    const command = `${objdumpCommand} -C -d --start-address=${startAddress} --stop-address=${endAddress} "${objectFile}"`;
+    const command = `${objdumpCommand} -C -d${withLineNumbers ? ' -l' : ''} --start-address=${startAddress} --stop-address=${endAddress} "${objectFile}"`;
     
     // console.log('Executing objdump command:', command);
     
@@ -47,7 +105,7 @@ export async function getAssemblyCode(
       
       if (!stdout || stdout.trim().length === 0) {
         console.warn('objdump returned empty output');
-        return {
+        return (withLineNumbers && await disassembleInProcess(objectFile, startAddress, endAddress)) || {
           startAddress,
           endAddress,
           instructions: []
@@ -57,8 +115,16 @@ export async function getAssemblyCode(
       // Parse objdump output
       const instructions: AssemblyInstruction[] = [];
       const lines = stdout.split('\n');
+      let sourceLine: number | undefined;
       
       for (const line of lines) {
+        // With -l, "/path/to/file.c:42" lines give the source line of the instructions below
+        const lineMatch = withLineNumbers ? line.match(/^\S.*:(\d+)(?: \(discriminator \d+\))?$/) : null;
+        if (lineMatch) {
+          sourceLine = parseInt(lineMatch[1], 10);
+          continue;
+        }
+
         // Match assembly instruction lines (e.g., "  401000:	55                   	push   %rbp")
         const match = line.match(/^\s*([0-9a-f]+):\s+(.+)$/);
         if (match) {
@@ -67,17 +133,29 @@ export async function getAssemblyCode(
           
           instructions.push({
             pc,
-            instruction
+            instruction,
+            ...(sourceLine !== undefined ? { line: sourceLine } : {})
           });
         }
       }
 
+      // A host objdump lists nothing for a foreign architecture
+      if (instructions.length === 0 && withLineNumbers) {
+        const builtin = await disassembleInProcess(objectFile, startAddress, endAddress);
+        if (builtin) return builtin;
+      }
+
       return {
         startAddress,
         endAddress,
         instructions
       };
     } catch (execError: any) {
+      // Without a usable (cross) objdump, RISC-V and AArch64 objects are
+      // decoded in-process, without source lines
+      const builtin = withLineNumbers ? await disassembleInProcess(objectFile, startAddress, endAddress) : null;
+      if (builtin) return builtin;
+
       // Log only error message, not full stack trace
       console.error('Error executing objdump:', execError.message || execError.code || 'Unknown error');
       if (execError.code === 'ENOENT') {
@@ -130,4 +208,103 @@ export async function getAssemblyForFunction(
   }
   
   return assemblyData;
-}
\ No newline at end of file
+}
+// nm from the same toolchain as the configured objdump, e.g. riscv32-unknown-elf-nm
+const nmCommandFor = (objdumpCommand: string) => objdumpCommand.replace(/objdump$/, 'nm');
+
+// Symbol tables are cached per object file and re-read when the file changes
+const symbolCache = new Map<string, { mtimeMs: number; symbols: FunctionSymbol[] }>();
+
+// Function symbols from the ELF symbol table: no source locations and no
+// demangling, but no (cross) nm either
+async function readElfFunctionSymbols(objectFile: string): Promise<FunctionSymbol[] | null> {
+  try {
+    const image = await loadImage(objectFile);
+    if (!image || image.elf.functions.length === 0) return null;
+    return image.elf.functions.map(symbol => ({
+      address: '0x' + symbol.address.toString(16),
+      size: symbol.size,
+      type: { local: 't', global: 'T', weak: 'W' }[symbol.binding],
+      name: symbol.name,
+      ...(symbol.file ? { file: symbol.file } : {})
+    }));
+  } catch {
+    return null;
+  }
+}
+
+/**
+ * Sized function symbols of an object file from `nm -S -l`, sorted by
+ * address, with their source location when the file has debug info. When
+ * nm fails (e.g. no cross nm for a RISC-V or AArch64 object), the ELF
+ * symbol table is read directly.
+ */
+export async function getFunctionSymbols(
+  objectFile: string,
+  objdumpCommand: string = 'objdump'
+): Promise<FunctionSymbol[] | null> {
+  try {
+    const stats = await fs.stat(objectFile);
+    const cached = symbolCache.get(objectFile);
+    if (cached && cached.mtimeMs === stats.mtimeMs) return cached.symbols;
+
+    const { stdout } = await execAsync(
+      `${nmCommandFor(objdumpCommand)} -S -C -l --defined-only "${objectFile}"`,
+      { maxBuffer: 1024 * 1024 * 64 }
+    );
+    const symbols: FunctionSymbol[] = [];
+    for (const line of stdout.split('\n')) {
+      // "0000000000401126 000000000000000b T normalB\t/path/to/file.c:15", the location only with debug info
+      const match = line.match(/^([0-9a-f]+)\s+([0-9a-f]+)\s+([tTwW])\s+([^\t]+)(?:\t(.+):(\d+))?$/);
+      if (!match) continue;
+      const size = parseInt(match[2], 16);
+      if (size > 0) {
+        symbols.push({
+          address: '0x' + match[1].replace(/^0+(?=.)/, ''),
+          size,
+          type: match[3],
+          name: match[4],
+          ...(match[5] && match[5] !== '??' ? { file: match[5], line: parseInt(match[6], 10) } : {})
+        });
+      }
+    }
+    symbols.sort((a, b) => parseInt(a.address, 16) - parseInt(b.address, 16));
+    symbolCache.set(objectFile, { mtimeMs: stats.mtimeMs, symbols });
+    return symbols;
+  } catch (error: any) {
+    const symbols = await readElfFunctionSymbols(objectFile);
+    if (symbols) {
+      const stats = await fs.stat(objectFile);
+      symbolCache.set(objectFile, { mtimeMs: stats.mtimeMs, symbols });
+      return symbols;
+    }
+    if (objectFile && !objectFile.includes('???')) {
+      console.error('Error reading symbols:', error.message || 'Unknown error');
+    }
+    return null;
+  }
+}
+
+/**
+ * Disassemble the whole function symbol containing `pc`, including parts
+ * that never ran, with the source line of each instruction.
+ */
+export async function getAssemblyForSymbol(
+  objectFile: string,
+  pc: string,
+  objdumpCommand: string = 'objdump'
+): Promise<{ symbol: FunctionSymbol; assembly: AssemblyData } | null> {
+  const symbols = await getFunctionSymbols(objectFile, objdumpCommand);
+  if (!symbols) return null;
+
+  const target = parseInt(pc, 16);
+  const symbol = symbols.find(s => {
+    const start = parseInt(s.address, 16);
+    return target >= start && target < start + s.size;
+  });
+  if (!symbol) return null;
+
+  const endAddress = '0x' + (parseInt(symbol.address, 16) + symbol.size).toString(16);
+  const assembly = await getAssemblyCode(objectFile, symbol.address, endAddress, objdumpCommand, true);
+  return assembly ? { symbol, assembly } : null;
+}
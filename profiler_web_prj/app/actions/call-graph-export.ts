@@ -0,0 +1,125 @@
+'use server';
+
+import fs from 'fs/promises';
+import { createWriteStream } from 'fs';
+import os from 'os';
+import path from 'path';
+import { execFile } from 'child_process';
+import { promisify } from 'util';
+import { CachegrindParser } from '@/lib/cachegrind-parser';
+import { buildCallGraph } from '@/lib/call-graph';
+import { DotClusterBy, generateDot } from '@/lib/dot-export';
+import { collapseFrames, FrameCollapseRules } from '@/lib/frame-collapse';
+import { foldRecursion } from '@/lib/recursion-fold';
+import { GraphPruner, PruneThresholds } from '@/lib/graph-prune';
+import { resolveOutputPath } from '@/lib/output-paths';
+import { fileVersion, snapshotKey, withSnapshot } from '@/lib/profile-snapshots';
+
+const execFileAsync = promisify(execFile);
+
+export interface CallGraphExportOptions {
+  format: 'dot' | 'svg';
+  clusterBy?: DotClusterBy;
+  collapseRules?: FrameCollapseRules;
+  foldRecursion?: boolean;
+  pruneThresholds?: PruneThresholds;
+  dotCommand?: string;
+}
+
+// Write generator chunks to a file, waiting for the stream to drain when its buffer fills
+async function writeChunks(filePath: string, chunks: Iterable<string>): Promise<void> {
+  const stream = createWriteStream(filePath, { encoding: 'utf-8' });
+  const finished = new Promise<void>((resolve, reject) => {
+    stream.on('finish', resolve);
+    stream.on('error', reject);
+  });
+  for (const chunk of chunks) {
+    if (!stream.write(chunk)) {
+      await new Promise<void>(resolve => stream.once('drain', resolve));
+    }
+  }
+  stream.end();
+  await finished;
+}
+
+/**
+ * Export the call graph of a dump in output/ as DOT, and optionally render
+ * it to SVG with the local graphviz `dot` binary. The same frame collapsing,
+ * recursion folding and pruning as in the viewer are applied first. The
+ * files are written to a private temporary directory, so concurrent exports
+ * never share a name and nothing is left under output/, and the requested
+ * format is returned.
+ */
+export async function exportCallGraph(serverPath: string, options: CallGraphExportOptions): Promise<{
+  success: boolean;
+  content?: string;
+  nodeCount?: number;
+  edgeCount?: number;
+  elapsedMs?: number;
+  error?: string;
+}> {
+  try {
+    const startTime = Date.now();
+    const resolvedPath = resolveOutputPath(serverPath);
+    if (!resolvedPath) {
+      return { success: false, error: 'Access denied: Path is outside output directory' };
+    }
+
+    // Line and instruction detail is not needed for a function-level graph
+    let data = await withSnapshot(snapshotKey(['profile-summary', await fileVersion(resolvedPath)]), async () =>
+      new CachegrindParser(await fs.readFile(resolvedPath, 'utf-8'), {}, { granularity: 'function' }).parse());
+    if (options.collapseRules) data = collapseFrames(data, options.collapseRules);
+    if (options.foldRecursion) data = foldRecursion(data);
+    if (options.pruneThresholds) data = new GraphPruner(data).prune(options.pruneThresholds);
+    const graph = buildCallGraph(data);
+
+    const exportDir = await fs.mkdtemp(path.join(os.tmpdir(), 'callgraph-export-'));
+    try {
+      const baseName = path.basename(resolvedPath);
+      const dotPath = path.join(exportDir, `${baseName}.dot`);
+      await writeChunks(dotPath, generateDot(graph, data.events, {
+        clusterBy: options.clusterBy,
+        title: baseName
+      }));
+
+      const result = {
+        success: true,
+        nodeCount: graph.nodes.size,
+        edgeCount: graph.edges.length
+      };
+
+      if (options.format === 'svg') {
+        const svgPath = path.join(exportDir, `${baseName}.svg`);
+        try {
+          await execFileAsync(options.dotCommand || 'dot', ['-Tsvg', '-o', svgPath, dotPath], {
+            maxBuffer: 1024 * 1024 * 10
+          });
+        } catch (execError: any) {
+          if (execError.code === 'ENOENT') {
+            throw new Error('Graphviz dot not found. Install graphviz or export DOT instead.');
+          }
+          throw new Error(`dot failed: ${execError.stderr || execError.message}`);
+        }
+        return {
+          ...result,
+          content: await fs.readFile(svgPath, 'utf-8'),
+          elapsedMs: Date.now() - startTime
+        };
+      }
+
+      return {
+        ...result,
+        content: await fs.readFile(dotPath, 'utf-8'),
+        elapsedMs: Date.now() - startTime
+      };
+    } finally {
+      await fs.rm(exportDir, { recursive: true, force: true });
+    }
+  } catch (error) {
+    console.error('Error exporting call graph:', error);
+    return {
+      success: false,
+      error: error instanceof Error ? error.message : 'Failed to export call graph'
+    };
+  }
+}
@@ -0,0 +1,181 @@
+'use server';
+
+import fs from 'fs/promises';
+import {
+  CoverageDiffEntry,
+  CoverageFileSummary,
+  LineCoverage,
+  diffCoverage,
+  scanLineCoverage,
+  summarizeCoverage,
+  unionCoverage
+} from '@/lib/coverage-bitset';
+import { isSharedLibraryObject } from '@/lib/call-graph';
+import {
+  ExecutedCode,
+  NeverExecutedReport,
+  findNeverExecuted,
+  mergeExecutedCode,
+  scanExecutedCode
+} from '@/lib/never-executed';
+import { findProfileFiles, mapWithConcurrency, resolveOutputPath, toProjectRelative } from '@/lib/output-paths';
+import { FunctionSymbol } from '@/types/profiler';
+import { getFunctionSymbols } from './assembly';
+
+// Per-dump coverage is cached by path and invalidated on mtime/size change
+const coverageCache = new Map<string, { mtimeMs: number; size: number; coverage: LineCoverage }>();
+
+async function loadRunCoverage(absolutePath: string): Promise<LineCoverage> {
+  const stats = await fs.stat(absolutePath);
+  const cached = coverageCache.get(absolutePath);
+  if (cached && cached.mtimeMs === stats.mtimeMs && cached.size === stats.size) {
+    return cached.coverage;
+  }
+  const content = await fs.readFile(absolutePath, 'utf-8');
+  const coverage = scanLineCoverage(content);
+  coverageCache.set(absolutePath, { mtimeMs: stats.mtimeMs, size: stats.size, coverage });
+  return coverage;
+}
+
+export async function listCoverageRuns(directory: string = 'output'): Promise<{
+  success: boolean;
+  runs?: string[];
+  error?: string;
+}> {
+  try {
+    const resolvedPath = resolveOutputPath(directory);
+    if (!resolvedPath) {
+      return { success: false, error: 'Access denied: Path is outside output directory' };
+    }
+    const files = await findProfileFiles(resolvedPath);
+    return { success: true, runs: files.map(toProjectRelative) };
+  } catch (error) {
+    console.error('Error listing coverage runs:', error);
+    return {
+      success: false,
+      error: error instanceof Error ? error.message : 'Failed to list profile runs'
+    };
+  }
+}
+
+export async function computeCoverageUnion(directory: string = 'output'): Promise<{
+  success: boolean;
+  runCount?: number;
+  files?: CoverageFileSummary[];
+  totalCompiledLines?: number;
+  totalCoveredLines?: number;
+  elapsedMs?: number;
+  error?: string;
+}> {
+  try {
+    const startTime = Date.now();
+    const resolvedPath = resolveOutputPath(directory);
+    if (!resolvedPath) {
+      return { success: false, error: 'Access denied: Path is outside output directory' };
+    }
+
+    const runFiles = await findProfileFiles(resolvedPath);
+    const runs = await mapWithConcurrency(runFiles, 8, loadRunCoverage);
+    const files = summarizeCoverage(unionCoverage(runs));
+
+    return {
+      success: true,
+      runCount: runFiles.length,
+      files,
+      totalCompiledLines: files.reduce((sum, f) => sum + f.compiledLines, 0),
+      totalCoveredLines: files.reduce((sum, f) => sum + f.coveredLines, 0),
+      elapsedMs: Date.now() - startTime
+    };
+  } catch (error) {
+    console.error('Error computing coverage union:', error);
+    return {
+      success: false,
+      error: error instanceof Error ? error.message : 'Failed to compute coverage union'
+    };
+  }
+}
+
+export async function diffRunCoverage(baseRun: string, headRun: string): Promise<{
+  success: boolean;
+  files?: CoverageDiffEntry[];
+  error?: string;
+}> {
+  try {
+    const basePath = resolveOutputPath(baseRun);
+    const headPath = resolveOutputPath(headRun);
+    if (!basePath || !headPath) {
+      return { success: false, error: 'Access denied: Path is outside output directory' };
+    }
+
+    const [base, head] = await Promise.all([loadRunCoverage(basePath), loadRunCoverage(headPath)]);
+    return { success: true, files: diffCoverage(base, head) };
+  } catch (error) {
+    console.error('Error diffing coverage:', error);
+    return {
+      success: false,
+      error: error instanceof Error ? error.message : 'Failed to diff coverage'
+    };
+  }
+}
+
+const MAX_REPORTED = 500;
+
+/**
+ * Functions of the application objects that no run under `directory`
+ * executed, with their code size from the objects' symbol tables. Shared
+ * libraries are left out. Object files must still exist at the path the
+ * dumps recorded.
+ */
+export async function findNeverExecutedCode(directory: string = 'output', objdumpCommand: string = 'objdump'): Promise<{
+  success: boolean;
+  runCount?: number;
+  report?: NeverExecutedReport;
+  missingObjects?: string[];
+  elapsedMs?: number;
+  error?: string;
+}> {
+  try {
+    const startTime = Date.now();
+    const resolvedPath = resolveOutputPath(directory);
+    if (!resolvedPath) {
+      return { success: false, error: 'Access denied: Path is outside output directory' };
+    }
+
+    // Runs are merged as they are scanned and not cached, so only the union stays in memory
+    const runFiles = await findProfileFiles(resolvedPath);
+    const executed: ExecutedCode = { addresses: new Map(), functions: new Map() };
+    await mapWithConcurrency(runFiles, 8, async runFile => {
+      mergeExecutedCode(executed, scanExecutedCode(await fs.readFile(runFile, 'utf-8')));
+    });
+
+    const objectFiles = new Set([...executed.addresses.keys(), ...executed.functions.keys()]);
+    const symbolsByObject = new Map<string, FunctionSymbol[]>();
+    const missingObjects: string[] = [];
+    for (const objectFile of Array.from(objectFiles)) {
+      if (isSharedLibraryObject(objectFile)) continue;
+      const symbols = await getFunctionSymbols(objectFile, objdumpCommand);
+      if (symbols) symbolsByObject.set(objectFile, symbols);
+      else missingObjects.push(objectFile);
+    }
+
+    const report = findNeverExecuted(symbolsByObject, executed);
+    return {
+      success: true,
+      runCount: runFiles.length,
+      report: {
+        functions: report.functions.slice(0, MAX_REPORTED),
+        files: report.files.slice(0, MAX_REPORTED),
+        directories: report.directories.slice(0, MAX_REPORTED),
+        objects: report.objects
+      },
+      missingObjects,
+      elapsedMs: Date.now() - startTime
+    };
+  } catch (error) {
+    console.error('Error finding never-executed code:', error);
+    return {
+      success: false,
+      error: error instanceof Error ? error.message : 'Failed to find never-executed code'
+    };
+  }
+}
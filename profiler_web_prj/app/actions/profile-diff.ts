@@ -0,0 +1,144 @@
+'use server';
+
+import fs from 'fs/promises';
+import { CachegrindParser } from '@/lib/cachegrind-parser';
+import { resolveOutputPath } from '@/lib/output-paths';
+import { fileVersion, snapshotKey, withSnapshot } from '@/lib/profile-snapshots';
+import { FileCostDelta, diffProfileLines } from '@/lib/profile-diff';
+import { AssemblyData, CachegrindData, FunctionSymbol } from '@/types/profiler';
+import { getAssemblyForSymbol } from './assembly';
+import { loadSourceFiles } from './source-files';
+
+async function loadProfile(absolutePath: string, srcSubdir: string): Promise<CachegrindData> {
+  const sourceFiles = await loadSourceFiles([srcSubdir]);
+  const key = snapshotKey([
+    'profile-lines',
+    await fileVersion(absolutePath),
+    ...Object.keys(sourceFiles).sort().flatMap(name => [name, sourceFiles[name]])
+  ]);
+  return withSnapshot(key, async () =>
+    new CachegrindParser(await fs.readFile(absolutePath, 'utf-8'), sourceFiles, { granularity: 'line' }).parse());
+}
+
+/**
+ * Compare line costs of two runs. Each run is read against its own src/
+ * subdirectory, so the two source versions can be checked out side by side
+ * (e.g. src/v1 and src/v2) and their lines aligned before diffing.
+ */
+export async function compareProfileLines(
+  baseRun: string,
+  headRun: string,
+  baseSrcSubdir: string,
+  headSrcSubdir: string,
+  event?: string
+): Promise<{
+  success: boolean;
+  event?: string;
+  events?: string[];
+  files?: FileCostDelta[];
+  error?: string;
+}> {
+  try {
+    const basePath = resolveOutputPath(baseRun);
+    const headPath = resolveOutputPath(headRun);
+    if (!basePath || !headPath) {
+      return { success: false, error: 'Access denied: Path is outside output directory' };
+    }
+
+    const [base, head] = await Promise.all([
+      loadProfile(basePath, baseSrcSubdir),
+      loadProfile(headPath, headSrcSubdir)
+    ]);
+    const events = head.events.filter(e => base.events.includes(e));
+    if (events.length === 0) {
+      return { success: false, error: 'The two runs have no event in common' };
+    }
+    const costEvent = event && events.includes(event)
+      ? event
+      : (events.includes('Cy') ? 'Cy' : (events.includes('Ir') ? 'Ir' : events[0]));
+
+    return { success: true, event: costEvent, events, files: diffProfileLines(base, head, costEvent) };
+  } catch (error) {
+    console.error('Error comparing profiles:', error);
+    return {
+      success: false,
+      error: error instanceof Error ? error.message : 'Failed to compare profiles'
+    };
+  }
+}
+
+/**
+ * Disassemble the whole symbol of `functionName` from the object file one
+ * run recorded, with that run's per-instruction costs. When several source
+ * files define the name, the most expensive definition is used. Two of
+ * these are aligned with diffAssembly() to compare builds.
+ */
+export async function getRunFunctionAssembly(
+  run: string,
+  functionName: string,
+  objdumpCommand: string = 'objdump'
+): Promise<{
+  success: boolean;
+  events?: string[];
+  file?: string;
+  symbol?: FunctionSymbol;
+  assembly?: AssemblyData;
+  error?: string;
+}> {
+  try {
+    const runPath = resolveOutputPath(run);
+    if (!runPath) {
+      return { success: false, error: 'Access denied: Path is outside output directory' };
+    }
+
+    const summary = await withSnapshot(snapshotKey(['profile-summary', await fileVersion(runPath)]), async () =>
+      new CachegrindParser(await fs.readFile(runPath, 'utf-8'), {}, { granularity: 'function' }).parse());
+    const costEvent = summary.events.includes('Cy') ? 'Cy' : (summary.events.includes('Ir') ? 'Ir' : summary.events[0]);
+    let file: string | undefined;
+    Object.entries(summary.fileCoverage).forEach(([fileName, fileData]) => {
+      const candidate = fileData.functions[functionName];
+      if (candidate && (!file || (candidate.totals[costEvent] || 0) >
+        (summary.fileCoverage[file].functions[functionName].totals[costEvent] || 0))) {
+        file = fileName;
+      }
+    });
+    if (!file) {
+      return { success: false, error: `Function ${functionName} not found in ${run}` };
+    }
+    const objectFile = summary.fileCoverage[file].objectFile;
+    if (!objectFile) {
+      return { success: false, error: `No object file recorded for ${functionName} in ${run}` };
+    }
+
+    // Re-read with instruction detail for this function only
+    const content = await fs.readFile(runPath, 'utf-8');
+    const detail = new CachegrindParser(content, {}, {
+      granularity: 'function',
+      detailFunction: { file, functionName }
+    }).parse();
+    const pcData = detail.fileCoverage[file]?.functions[functionName]?.pcData;
+    const firstPc = Object.keys(pcData || {}).sort((a, b) => parseInt(a, 16) - parseInt(b, 16))[0];
+    if (!pcData || !firstPc) {
+      return { success: false, error: `${run} has no instruction-level costs; record it with --dump-instr=yes` };
+    }
+
+    const result = await getAssemblyForSymbol(objectFile, firstPc, objdumpCommand);
+    if (!result) {
+      return { success: false, error: `Could not disassemble ${functionName} from ${objectFile}` };
+    }
+    result.assembly.instructions.forEach(inst => {
+      const pcInfo = pcData[inst.pc];
+      if (pcInfo) {
+        inst.events = pcInfo.events;
+        inst.executed = pcInfo.executed;
+      }
+    });
+    return { success: true, events: summary.events, file, symbol: result.symbol, assembly: result.assembly };
+  } catch (error) {
+    console.error('Error loading function assembly:', error);
+    return {
+      success: false,
+      error: error instanceof Error ? error.message : 'Failed to load function assembly'
+    };
+  }
+}
@@ -1,8 +1,10 @@
 'use server';
 
 import { CachegrindParser } from '@/lib/cachegrind-parser';
-import { CachegrindData } from '@/types/profiler';
-import { readSourceFile, listSourceFiles } from './source-files';
+import { resolveOutputPath } from '@/lib/output-paths';
+import { fileVersion, snapshotKey, withSnapshot } from '@/lib/profile-snapshots';
+import { CachegrindData, FunctionData, ParseGranularity } from '@/types/profiler';
+import { loadSourceFiles } from './source-files';
 import fs from 'fs/promises';
 import path from 'path';
 
@@ -15,6 +17,11 @@ export async function parseCachegrindFile(formData: FormData): Promise<{
   try {
     const file = formData.get('file') as File;
     const srcSubdirsJson = formData.get('srcSubdirs') as string | null;
+    const granularityValue = formData.get('granularity') as string | null;
+    const serverPath = formData.get('serverPath') as string | null;
+    const granularity: ParseGranularity = granularityValue === 'function' || granularityValue === 'line'
+      ? granularityValue
+      : 'instr';
     
     if (!file) {
       return { success: false, error: 'No file provided' };
@@ -40,28 +47,24 @@ export async function parseCachegrindFile(formData: FormData): Promise<{
     }
     
     // Read source files from all configured directories
-    const sourceFiles: Record<string, string> = {};
-    
-    for (const subdir of srcSubdirs) {
-      const srcFileList = await listSourceFiles(subdir);
-      
-      for (const srcFile of srcFileList) {
-        const fileContent = await readSourceFile(srcFile);
-        if (fileContent) {
-          // Store with full relative path
-          sourceFiles[srcFile] = fileContent;
-          
-          // Also store with "src/" prefix for path resolution
-          sourceFiles[`src/${srcFile}`] = fileContent;
-        }
-      }
-    }
+    const sourceFiles = await loadSourceFiles(srcSubdirs);
     
-    const parser = new CachegrindParser(content, sourceFiles);
-    const data = parser.parse();
+    // Parsed once per dump, granularity and source tree across all server processes
+    const key = snapshotKey([
+      'profile',
+      granularity,
+      content,
+      ...Object.keys(sourceFiles).sort().flatMap(name => [name, sourceFiles[name]])
+    ]);
+    const data = await withSnapshot(key, () => new CachegrindParser(content, sourceFiles, { granularity }).parse());
     
     // Update the project name to include the actual filename
     data.projectName = `Analysis - ${file.name}`;
+    
+    // Dumps from output/ can be re-read later to load detail that was skipped
+    if (serverPath && resolveOutputPath(serverPath)) {
+      data.sourceDump = serverPath;
+    }
 
     return { success: true, data, filename: file.name };
   } catch (error) {
@@ -197,4 +200,40 @@ export async function readServerFile(filePath: string): Promise<{
       error: error instanceof Error ? error.message : 'Failed to read server file' 
     };
   }
-}
\ No newline at end of file
+}
+/**
+ * Re-read a dump from output/ and return full line and instruction detail
+ * for one function. Used when the profile was loaded at a coarser granularity.
+ */
+export async function loadFunctionDetail(serverPath: string, fileName: string, functionName: string): Promise<{
+  success: boolean;
+  functionData?: FunctionData;
+  error?: string;
+}> {
+  try {
+    const resolvedPath = resolveOutputPath(serverPath);
+    if (!resolvedPath) {
+      return { success: false, error: 'Access denied: Path is outside output directory' };
+    }
+
+    const key = snapshotKey(['function-detail', await fileVersion(resolvedPath), fileName, functionName]);
+    const functionData = await withSnapshot(key, async () => {
+      const content = await fs.readFile(resolvedPath, 'utf-8');
+      const parser = new CachegrindParser(content, {}, {
+        granularity: 'function',
+        detailFunction: { file: fileName, functionName }
+      });
+      return parser.parse().fileCoverage[fileName]?.functions[functionName] ?? null;
+    });
+    if (!functionData) {
+      return { success: false, error: `Function ${functionName} not found in ${serverPath}` };
+    }
+    return { success: true, functionData };
+  } catch (error) {
+    console.error('Error loading function detail:', error);
+    return {
+      success: false,
+      error: error instanceof Error ? error.message : 'Failed to load function detail'
+    };
+  }
+}
@@ -43,6 +43,11 @@ async function* walkDirectory(dir: string): AsyncGenerator<string> {
 
 export async function listSourceFiles(subdir: string = ''): Promise<string[]> {
   try {
+    // Security: Ensure the subdirectory stays within src directory
+    if (path.normalize(subdir).split(path.sep).includes('..')) {
+      console.error(`Invalid path traversal attempt: ${subdir}`);
+      return [];
+    }
     const srcPath = path.join(process.cwd(), 'src', subdir);
     const sourceFiles: string[] = [];
     
@@ -65,4 +70,54 @@ export async function listSourceFiles(subdir: string = ''): Promise<string[]> {
     console.error('Failed to list source files:', error);
     return [];
   }
-}
\ No newline at end of file
+}
+
+// Deep enough for src/<project>/<version>/ layouts without walking whole trees
+const MAX_SUBDIRECTORY_DEPTH = 3;
+
+/**
+ * List the directories below src/ (relative to it, '' for src/ itself), so
+ * runs built from different checkouts such as src/v1 and src/v2 can be
+ * picked without adding them to a fixed list.
+ */
+export async function listSrcSubdirectories(): Promise<string[]> {
+  const srcRoot = path.join(process.cwd(), 'src');
+  const found: string[] = [''];
+  const walk = async (dir: string, depth: number) => {
+    if (depth >= MAX_SUBDIRECTORY_DEPTH) return;
+    const entries = await fs.readdir(dir, { withFileTypes: true }).catch(() => []);
+    for (const entry of entries) {
+      if (!entry.isDirectory() || entry.name.startsWith('.')) continue;
+      const fullPath = path.join(dir, entry.name);
+      found.push(path.relative(srcRoot, fullPath).split(path.sep).join('/'));
+      await walk(fullPath, depth + 1);
+    }
+  };
+  await walk(srcRoot, 0);
+  return found.sort();
+}
+
+/**
+ * Read every source file under the configured src/ subdirectories, keyed
+ * both by src-relative path and with a "src/" prefix for path resolution.
+ */
+export async function loadSourceFiles(srcSubdirs: string[]): Promise<Record<string, string>> {
+  const sourceFiles: Record<string, string> = {};
+  
+  for (const subdir of srcSubdirs) {
+    const srcFileList = await listSourceFiles(subdir);
+    
+    for (const srcFile of srcFileList) {
+      const fileContent = await readSourceFile(srcFile);
+      if (fileContent) {
+        // Store with full relative path
+        sourceFiles[srcFile] = fileContent;
+        
+        // Also store with "src/" prefix for path resolution
+        sourceFiles[`src/${srcFile}`] = fileContent;
+      }
+    }
+  }
+  
+  return sourceFiles;
+}
@@ -0,0 +1,63 @@
+'use server';
+
+import { resolveSourcePath } from '@/lib/path-utils';
+import { loadSnapshot, snapshotKey, withSnapshot } from '@/lib/profile-snapshots';
+import { hasSourceScope, scheduleSourceIndexing, sourceIndexProgress, sourceScopeKey } from '@/lib/source-index-store';
+import { loadSourceFiles } from './source-files';
+
+// What a scope covers, stored as a snapshot so any server process can rebuild it
+interface SourceScopeDescription {
+  srcSubdirs: string[];
+  files: string[];
+}
+
+const scopeSnapshotKey = (scope: string) => snapshotKey(['source-scope', scope]);
+
+/**
+ * Resolve the source files a profile references and index them in the
+ * background for /api/source-search. Returns once indexing is queued, with
+ * the scope key that searches over these files must pass.
+ */
+export async function indexProfileSources(srcSubdirs: string[], files: string[]): Promise<{
+  success: boolean;
+  scope?: string;
+  queued?: number;
+  error?: string;
+}> {
+  try {
+    const dirs = srcSubdirs.length > 0 ? srcSubdirs : [''];
+    const scope = sourceScopeKey(dirs, files);
+    await withSnapshot(scopeSnapshotKey(scope), (): SourceScopeDescription => ({ srcSubdirs: dirs, files }));
+
+    const sourceFiles = await loadSourceFiles(dirs);
+    const resolved: Array<{ file: string; content: string }> = [];
+    files.forEach(file => {
+      const content = resolveSourcePath(file, sourceFiles);
+      if (content) resolved.push({ file, content });
+    });
+    scheduleSourceIndexing(scope, resolved);
+    return { success: true, scope, queued: resolved.length };
+  } catch (error) {
+    console.error('Error indexing source files:', error);
+    return {
+      success: false,
+      error: error instanceof Error ? error.message : 'Failed to index source files'
+    };
+  }
+}
+
+/**
+ * Start indexing `scope` in this process if it was indexed by another
+ * (cluster worker) only. False when no process has described the scope.
+ */
+export async function ensureSourceScope(scope: string): Promise<boolean> {
+  if (hasSourceScope(scope)) return true;
+  const description = await loadSnapshot<SourceScopeDescription>(scopeSnapshotKey(scope));
+  if (!description) return false;
+  return (await indexProfileSources(description.srcSubdirs, description.files)).success;
+}
+
+export async function getSourceIndexProgress(scope: string): Promise<{ indexed: number; total: number; done: boolean }> {
+  await ensureSourceScope(scope);
+  return sourceIndexProgress(scope);
+}
@@ -0,0 +1,50 @@
+'use server';
+
+import { ImpactSelection, RunCost, parseImpactTarget } from '@/lib/test-impact';
+import { getTestImpactIndex } from '@/lib/test-impact-store';
+
+export async function queryTestImpact(directory: string, targetSpec: string): Promise<{
+  success: boolean;
+  runs?: RunCost[];
+  costEvent?: string;
+  runCount?: number;
+  elapsedMs?: number;
+  error?: string;
+}> {
+  try {
+    const index = await getTestImpactIndex(directory);
+    const startTime = performance.now();
+    const runs = index.runsForTarget(parseImpactTarget(targetSpec));
+    return {
+      success: true,
+      runs,
+      costEvent: index.costEvent,
+      runCount: index.runCount,
+      elapsedMs: performance.now() - startTime
+    };
+  } catch (error) {
+    console.error('Error querying test impact:', error);
+    return {
+      success: false,
+      error: error instanceof Error ? error.message : 'Failed to query test impact'
+    };
+  }
+}
+
+export async function selectImpactedRuns(directory: string, targetSpecs: string[]): Promise<{
+  success: boolean;
+  selection?: ImpactSelection;
+  error?: string;
+}> {
+  try {
+    const index = await getTestImpactIndex(directory);
+    const targets = targetSpecs.filter(spec => spec.trim()).map(parseImpactTarget);
+    return { success: true, selection: index.selectRuns(targets) };
+  } catch (error) {
+    console.error('Error selecting impacted runs:', error);
+    return {
+      success: false,
+      error: error instanceof Error ? error.message : 'Failed to select runs'
+    };
+  }
+}
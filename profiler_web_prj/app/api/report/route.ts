@@ -0,0 +1,59 @@
+import fs from 'fs/promises';
+import path from 'path';
+import { NextRequest, NextResponse } from 'next/server';
+import { loadSourceFiles } from '@/app/actions/source-files';
+import { CachegrindParser } from '@/lib/cachegrind-parser';
+import { collapseFrames, DEFAULT_COLLAPSE_RULES } from '@/lib/frame-collapse';
+import { GraphPruner, DEFAULT_PRUNE_THRESHOLDS } from '@/lib/graph-prune';
+import { resolveOutputPath } from '@/lib/output-paths';
+import { buildStaticReport } from '@/lib/static-report';
+
+/**
+ * Static HTML report of a dump in output/, for scripts and ticket attachments.
+ *
+ *   GET /api/report?dump=output/callgrind.out.123[&event=Ir][&src=["","v2"]]
+ *       -> a single HTML file that opens in a browser with no server
+ *
+ * `src` is a JSON array of src/ subdirectories to read sources from; the
+ * src/ root by default. Default frame collapsing and pruning are applied.
+ */
+export async function GET(request: NextRequest) {
+  const params = request.nextUrl.searchParams;
+  const dump = params.get('dump');
+  if (!dump) {
+    return NextResponse.json({ error: 'Missing dump parameter' }, { status: 400 });
+  }
+  const resolvedPath = resolveOutputPath(dump);
+  if (!resolvedPath) {
+    return NextResponse.json({ error: 'Access denied: Path is outside output directory' }, { status: 403 });
+  }
+
+  let srcSubdirs = [''];
+  try {
+    const parsed = JSON.parse(params.get('src') || '[""]');
+    if (Array.isArray(parsed)) srcSubdirs = parsed;
+  } catch {
+    // Use the src/ root
+  }
+
+  try {
+    const content = await fs.readFile(resolvedPath, 'utf-8');
+    const data = new CachegrindParser(content, await loadSourceFiles(srcSubdirs), { granularity: 'line' }).parse();
+    const graphData = new GraphPruner(collapseFrames(data, DEFAULT_COLLAPSE_RULES)).prune(DEFAULT_PRUNE_THRESHOLDS);
+    data.projectName = `Analysis - ${path.basename(resolvedPath)}`;
+
+    const html = await buildStaticReport(data, graphData, { costEvent: params.get('event') || undefined });
+    return new Response(html, {
+      headers: {
+        'Content-Type': 'text/html; charset=utf-8',
+        'Content-Disposition': `attachment; filename="${path.basename(resolvedPath)}-report.html"`
+      }
+    });
+  } catch (error) {
+    console.error('Error building report:', error);
+    return NextResponse.json(
+      { error: error instanceof Error ? error.message : 'Failed to build report' },
+      { status: 500 }
+    );
+  }
+}
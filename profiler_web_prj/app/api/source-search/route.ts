@@ -0,0 +1,43 @@
+import { NextRequest, NextResponse } from 'next/server';
+import { ensureSourceScope } from '@/app/actions/source-search';
+import { searchSources, sourceIndexProgress } from '@/lib/source-index-store';
+
+/**
+ * Full-text search over one profile's indexed source files; `scope` is the
+ * key returned by indexProfileSources. A server process that has not
+ * indexed the scope yet starts indexing it from the scope's snapshot, and
+ * the first searches there report partial progress.
+ *
+ *   GET /api/source-search?q=memcpy&scope=<key>
+ *       -> newline-delimited JSON, one {"file", "hits": [{"line", "text"}]}
+ *          object per matching file as it is found, then a final
+ *          {"done": true, "indexed", "total"} line
+ */
+export async function GET(request: NextRequest) {
+  const query = request.nextUrl.searchParams.get('q');
+  const scope = request.nextUrl.searchParams.get('scope');
+  if (!query || !scope) {
+    return NextResponse.json({ error: 'Missing q or scope parameter' }, { status: 400 });
+  }
+
+  await ensureSourceScope(scope);
+  const encoder = new TextEncoder();
+  const results = searchSources(scope, query);
+  const stream = new ReadableStream<Uint8Array>({
+    pull(controller) {
+      // One matching file per pull, so the client sees hits while the rest are scanned
+      const next = results.next();
+      if (next.done) {
+        const progress = sourceIndexProgress(scope);
+        controller.enqueue(encoder.encode(`${JSON.stringify({ done: true, indexed: progress.indexed, total: progress.total })}\n`));
+        controller.close();
+        return;
+      }
+      controller.enqueue(encoder.encode(`${JSON.stringify(next.value)}\n`));
+    }
+  });
+
+  return new Response(stream, {
+    headers: { 'Content-Type': 'application/x-ndjson; charset=utf-8', 'Cache-Control': 'no-store' }
+  });
+}
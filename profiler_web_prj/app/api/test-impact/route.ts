@@ -0,0 +1,50 @@
+import { NextRequest, NextResponse } from 'next/server';
+import { parseImpactTarget } from '@/lib/test-impact';
+import { getTestImpactIndex } from '@/lib/test-impact-store';
+
+/**
+ * Test impact queries for CI scripts.
+ *
+ *   GET  /api/test-impact?target=src/io.c:read_file[&dir=output/nightly]
+ *        -> runs that executed the target, heaviest first
+ *   POST /api/test-impact  { "targets": ["src/io.c:42", "parse_args"], "dir": "output" }
+ *        -> minimal set of runs that executes every target
+ */
+export async function GET(request: NextRequest) {
+  const target = request.nextUrl.searchParams.get('target');
+  const directory = request.nextUrl.searchParams.get('dir') || 'output';
+  if (!target) {
+    return NextResponse.json({ error: 'Missing target parameter' }, { status: 400 });
+  }
+
+  try {
+    const index = await getTestImpactIndex(directory);
+    return NextResponse.json({
+      target: parseImpactTarget(target),
+      costEvent: index.costEvent,
+      runs: index.runsForTarget(parseImpactTarget(target))
+    });
+  } catch (error) {
+    return NextResponse.json(
+      { error: error instanceof Error ? error.message : 'Failed to query test impact' },
+      { status: 500 }
+    );
+  }
+}
+
+export async function POST(request: NextRequest) {
+  try {
+    const body = await request.json();
+    const targets: unknown = body?.targets;
+    if (!Array.isArray(targets) || targets.some(t => typeof t !== 'string')) {
+      return NextResponse.json({ error: 'targets must be an array of strings' }, { status: 400 });
+    }
+    const index = await getTestImpactIndex(typeof body.dir === 'string' ? body.dir : 'output');
+    return NextResponse.json(index.selectRuns((targets as string[]).map(parseImpactTarget)));
+  } catch (error) {
+    return NextResponse.json(
+      { error: error instanceof Error ? error.message : 'Failed to select runs' },
+      { status: 500 }
+    );
+  }
+}
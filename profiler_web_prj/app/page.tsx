@@ -1,19 +1,33 @@
 'use client';
 
-import { useState } from 'react';
+import { useState, useEffect } from 'react';
 import { FileUpload } from '@/components/file-upload';
 import { ServerFileBrowser } from '@/components/server-file-browser';
 import { ProfilerDashboard } from '@/components/profiler-dashboard';
 import { LoadingSpinner } from '@/components/loading-spinner';
+import { CoverageCorpus } from '@/components/coverage-corpus';
 import { parseCachegrindFile, readServerFile } from '@/app/actions/profiler';
-import { CachegrindData } from '@/types/profiler';
-import { BarChart3, AlertCircle, Upload, HardDrive } from 'lucide-react';
+import { CachegrindData, ParseGranularity } from '@/types/profiler';
+import { BarChart3, AlertCircle, Upload, HardDrive, Layers } from 'lucide-react';
 
 export default function Home() {
   const [isProcessing, setIsProcessing] = useState(false);
   const [data, setData] = useState<CachegrindData | null>(null);
   const [error, setError] = useState<string | null>(null);
-  const [fileSource, setFileSource] = useState<'client' | 'server'>('client');
+  const [fileSource, setFileSource] = useState<'client' | 'server' | 'corpus'>('client');
+  const [granularity, setGranularity] = useState<ParseGranularity>('instr');
+
+  useEffect(() => {
+    const saved = localStorage.getItem('profiler-granularity');
+    if (saved === 'function' || saved === 'line' || saved === 'instr') {
+      setGranularity(saved);
+    }
+  }, []);
+
+  const handleGranularityChange = (value: ParseGranularity) => {
+    setGranularity(value);
+    localStorage.setItem('profiler-granularity', value);
+  };
 
   const handleFileSelect = async (file: File) => {
     setIsProcessing(true);
@@ -22,6 +36,7 @@ export default function Home() {
     try {
       const formData = new FormData();
       formData.append('file', file);
+      formData.append('granularity', granularity);
       
       // Add source directories configuration
       const savedSubdirs = localStorage.getItem('profiler-src-subdirs');
@@ -64,6 +79,8 @@ export default function Home() {
       // Parse the file
       const formData = new FormData();
       formData.append('file', file);
+      formData.append('granularity', granularity);
+      formData.append('serverPath', filePath);
       
       // Add source directories configuration
       const savedSubdirs = localStorage.getItem('profiler-src-subdirs');
@@ -125,7 +142,7 @@ export default function Home() {
               </button>
               <button
                 onClick={() => setFileSource('server')}
-                className={`flex items-center gap-2 px-6 py-3 rounded-r-lg transition-colors ${
+                className={`flex items-center gap-2 px-6 py-3 transition-colors ${
                   fileSource === 'server' 
                     ? 'bg-blue-500 text-white' 
                     : 'bg-white text-gray-700 hover:bg-gray-100'
@@ -134,21 +151,49 @@ export default function Home() {
                 <HardDrive className="w-4 h-4" />
                 Browse Server Files
               </button>
+              <button
+                onClick={() => setFileSource('corpus')}
+                className={`flex items-center gap-2 px-6 py-3 rounded-r-lg transition-colors ${
+                  fileSource === 'corpus' 
+                    ? 'bg-blue-500 text-white' 
+                    : 'bg-white text-gray-700 hover:bg-gray-100'
+                }`}
+              >
+                <Layers className="w-4 h-4" />
+                Test Coverage
+              </button>
             </div>
           </div>
 
+          {fileSource !== 'corpus' && (
+            <div className="flex justify-center items-center gap-2 mb-6 text-sm text-gray-600">
+              <span>Detail to load:</span>
+              <select
+                value={granularity}
+                onChange={(e) => handleGranularityChange(e.target.value as ParseGranularity)}
+                className="px-2 py-1 border border-gray-300 rounded focus:outline-none focus:ring-2 focus:ring-blue-500 bg-white"
+              >
+                <option value="instr">Instructions (full)</option>
+                <option value="line">Source lines</option>
+                <option value="function">Functions only</option>
+              </select>
+            </div>
+          )}
+
           {!isProcessing && !error && (
             fileSource === 'client' ? (
               <FileUpload 
                 onFileSelect={handleFileSelect}
                 isProcessing={isProcessing}
               />
-            ) : (
+            ) : fileSource === 'server' ? (
               <ServerFileBrowser
                 onFileSelect={handleServerFileSelect}
                 isProcessing={isProcessing}
                 initialDirectory="output"
               />
+            ) : (
+              <CoverageCorpus initialDirectory="output" />
             )
           )}
 
@@ -0,0 +1,35 @@
+// Multi-process production server: `npm run build && npm run start:cluster`.
+//
+// Forks PROFILER_WORKERS processes (default: one per core) that all serve
+// the built app on PORT through Node's cluster module. Parsing and GC then
+// happen per process, so one large profile no longer stalls every user.
+// Parse results are shared through the on-disk snapshots in
+// lib/profile-snapshots.ts. The source search index is built per worker:
+// each worker indexes a profile's sources from the shared scope snapshot
+// the first time it is asked about them.
+
+import cluster from 'node:cluster';
+import http from 'node:http';
+import os from 'node:os';
+import next from 'next';
+
+const port = parseInt(process.env.PORT || '3000', 10);
+const hostname = process.env.HOSTNAME || '0.0.0.0';
+const workers = parseInt(process.env.PROFILER_WORKERS || '', 10) || os.availableParallelism();
+
+if (cluster.isPrimary) {
+  console.log(`Starting ${workers} server workers on http://${hostname}:${port}`);
+  for (let i = 0; i < workers; i++) cluster.fork();
+
+  // Replace workers that die, unless they are failing on startup
+  const startedAt = Date.now();
+  cluster.on('exit', (worker, code, signal) => {
+    console.error(`Worker ${worker.process.pid} exited (${signal || code})`);
+    if (Date.now() - startedAt > 10_000) cluster.fork();
+  });
+} else {
+  const app = next({ dev: false, hostname, port });
+  const handle = app.getRequestHandler();
+  await app.prepare();
+  http.createServer((req, res) => handle(req, res)).listen(port, hostname);
+}
@@ -0,0 +1,162 @@
+'use client';
+
+import { useMemo, useState } from 'react';
+import { AlertCircle } from 'lucide-react';
+import { AssemblyInstruction } from '@/types/profiler';
+import { getRunFunctionAssembly } from '@/app/actions/profile-diff';
+import { AssemblyDiffKind, diffAssembly } from '@/lib/assembly-diff';
+import { cn } from '@/lib/utils';
+
+interface AssemblyDiffViewProps {
+  baseRun: string;
+  headRun: string;
+}
+
+const ROW_STYLES: Record<AssemblyDiffKind, string> = {
+  same: '',
+  changed: 'bg-amber-50',
+  removed: 'bg-red-50',
+  added: 'bg-green-50'
+};
+
+// Instruction text without the encoding bytes objdump prints first
+const instructionText = (inst: AssemblyInstruction) => {
+  const parts = inst.instruction.split('\t');
+  return (parts.length > 1 ? parts.slice(1).join(' ') : parts[0]).trim();
+};
+
+export function AssemblyDiffView({ baseRun, headRun }: AssemblyDiffViewProps) {
+  const [functionName, setFunctionName] = useState('');
+  const [sides, setSides] = useState<{ base: AssemblyInstruction[]; head: AssemblyInstruction[]; events: string[] } | null>(null);
+  const [event, setEvent] = useState('');
+  const [ignoreAddresses, setIgnoreAddresses] = useState(true);
+  const [ignoreRegisters, setIgnoreRegisters] = useState(false);
+  const [isLoading, setIsLoading] = useState(false);
+  const [error, setError] = useState<string | null>(null);
+
+  const handleLoad = async () => {
+    const name = functionName.trim();
+    if (!name || !baseRun || !headRun) return;
+    setIsLoading(true);
+    setError(null);
+    try {
+      const objdumpCommand = localStorage.getItem('profiler-objdump-command') || 'objdump';
+      const [base, head] = await Promise.all([
+        getRunFunctionAssembly(baseRun, name, objdumpCommand),
+        getRunFunctionAssembly(headRun, name, objdumpCommand)
+      ]);
+      if (!base.success || !head.success) {
+        setError(base.error || head.error || 'Failed to load assembly');
+        setSides(null);
+        return;
+      }
+      const events = (head.events || []).filter(e => (base.events || []).includes(e));
+      setSides({ base: base.assembly!.instructions, head: head.assembly!.instructions, events });
+      if (!events.includes(event)) {
+        setEvent(events.includes('Cy') ? 'Cy' : (events.includes('Ir') ? 'Ir' : events[0] || ''));
+      }
+    } finally {
+      setIsLoading(false);
+    }
+  };
+
+  const rows = useMemo(
+    () => sides ? diffAssembly(sides.base, sides.head, { ignoreAddresses, ignoreRegisters }) : [],
+    [sides, ignoreAddresses, ignoreRegisters]
+  );
+
+  const cost = (inst?: AssemblyInstruction) => inst?.events?.[event] || 0;
+  const baseTotal = rows.reduce((sum, row) => sum + cost(row.base), 0);
+  const headTotal = rows.reduce((sum, row) => sum + cost(row.head), 0);
+  const changedRows = rows.filter(row => row.kind !== 'same').length;
+
+  const costCell = (inst?: AssemblyInstruction) => (
+    <td className="py-0.5 px-2 text-right text-gray-700 whitespace-nowrap">
+      {inst && cost(inst) > 0 ? cost(inst).toLocaleString() : ''}
+    </td>
+  );
+
+  return (
+    <div className="mt-6 pt-4 border-t border-gray-200">
+      <div className="flex items-center gap-2 mb-3">
+        <input
+          type="text"
+          value={functionName}
+          onChange={(e) => setFunctionName(e.target.value)}
+          onKeyDown={(e) => e.key === 'Enter' && handleLoad()}
+          placeholder="Function name"
+          className="flex-1 px-2 py-1.5 text-sm border border-gray-300 rounded font-mono focus:outline-none focus:ring-2 focus:ring-blue-500"
+        />
+        <label className="flex items-center gap-1 text-xs text-gray-600">
+          <input type="checkbox" checked={ignoreAddresses} onChange={(e) => setIgnoreAddresses(e.target.checked)} />
+          Ignore addresses
+        </label>
+        <label className="flex items-center gap-1 text-xs text-gray-600">
+          <input type="checkbox" checked={ignoreRegisters} onChange={(e) => setIgnoreRegisters(e.target.checked)} />
+          Ignore registers
+        </label>
+        {sides && sides.events.length > 0 && (
+          <select
+            value={event}
+            onChange={(e) => setEvent(e.target.value)}
+            className="px-2 py-1 text-sm border border-gray-300 rounded focus:outline-none focus:ring-2 focus:ring-blue-500"
+          >
+            {sides.events.map(e => <option key={e} value={e}>{e}</option>)}
+          </select>
+        )}
+        <button
+          onClick={handleLoad}
+          disabled={isLoading || !functionName.trim()}
+          className="px-4 py-1.5 bg-blue-500 text-white rounded-lg hover:bg-blue-600 transition-colors text-sm disabled:opacity-50"
+        >
+          {isLoading ? 'Loading...' : 'Diff assembly'}
+        </button>
+      </div>
+
+      {error && (
+        <div className="flex items-center gap-2 text-red-600 text-sm mb-3">
+          <AlertCircle className="w-4 h-4" />
+          {error}
+        </div>
+      )}
+
+      {sides && (
+        <>
+          <div className="text-sm text-gray-600 mb-2">
+            {sides.base.length.toLocaleString()} → {sides.head.length.toLocaleString()} instructions,{' '}
+            {changedRows.toLocaleString()} differ; {event} {baseTotal.toLocaleString()} → {headTotal.toLocaleString()}
+            <span className={cn("ml-1 font-medium", headTotal > baseTotal ? "text-red-600" : "text-green-600")}>
+              ({headTotal > baseTotal ? '+' : ''}{(headTotal - baseTotal).toLocaleString()})
+            </span>
+          </div>
+          <div className="max-h-[32rem] overflow-auto border border-gray-100 rounded-lg">
+            <table className="w-full text-xs font-mono">
+              <thead className="sticky top-0 bg-white">
+                <tr className="border-b border-gray-200 text-gray-700">
+                  <th className="text-left py-1 px-2 font-medium">Base</th>
+                  <th className="text-right py-1 px-2 font-medium">{event}</th>
+                  <th className="text-left py-1 px-2 font-medium">Head</th>
+                  <th className="text-right py-1 px-2 font-medium">{event}</th>
+                </tr>
+              </thead>
+              <tbody>
+                {rows.map((row, i) => (
+                  <tr key={i} className={cn("border-b border-gray-50", ROW_STYLES[row.kind])}>
+                    <td className="py-0.5 px-2 text-gray-800 whitespace-nowrap">
+                      {row.base && <><span className="text-gray-400 mr-2">{row.base.pc}</span>{instructionText(row.base)}</>}
+                    </td>
+                    {costCell(row.base)}
+                    <td className="py-0.5 px-2 text-gray-800 whitespace-nowrap">
+                      {row.head && <><span className="text-gray-400 mr-2">{row.head.pc}</span>{instructionText(row.head)}</>}
+                    </td>
+                    {costCell(row.head)}
+                  </tr>
+                ))}
+              </tbody>
+            </table>
+          </div>
+        </>
+      )}
+    </div>
+  );
+}
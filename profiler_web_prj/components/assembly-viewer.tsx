@@ -215,6 +215,7 @@ export function AssemblyViewer({
             return (
               <tr
                 key={`${inst.pc}-${index}`}
+                id={`asm-pc-${inst.pc}`}
                 onClick={() => onPcClick?.(inst.pc)}
                 className={cn(
                   "border-b cursor-pointer transition-all",
@@ -0,0 +1,154 @@
+'use client';
+
+import { Fragment, useMemo, useState } from 'react';
+import { Shuffle, ChevronRight, ChevronDown } from 'lucide-react';
+import { CachegrindData } from '@/types/profiler';
+import { buildCallGraph } from '@/lib/call-graph';
+import { CallSiteKind, findPolymorphicCallSites } from '@/lib/call-sites';
+import { cn } from '@/lib/utils';
+
+interface CallSitesViewProps {
+  data: CachegrindData;
+  onViewCode?: (fileName: string, functionName: string, line?: number) => void;
+}
+
+const MAX_SHOWN = 100;
+
+const KIND_STYLES: Record<CallSiteKind, { label: string; className: string; title: string }> = {
+  devirtualize: {
+    label: 'devirtualize',
+    className: 'bg-green-100 text-green-700',
+    title: 'One target takes all calls; a direct call would do'
+  },
+  speculative: {
+    label: 'speculative',
+    className: 'bg-blue-100 text-blue-700',
+    title: 'One target dominates; guard a direct call to it and fall back to the indirect call'
+  },
+  polymorphic: {
+    label: 'polymorphic',
+    className: 'bg-gray-100 text-gray-700',
+    title: 'A few targets share the calls'
+  },
+  megamorphic: {
+    label: 'megamorphic',
+    className: 'bg-amber-100 text-amber-700',
+    title: 'Calls are spread over many targets'
+  }
+};
+
+export function CallSitesView({ data, onViewCode }: CallSitesViewProps) {
+  const [event, setEvent] = useState(
+    data.events.includes('Cy') ? 'Cy' : (data.events.includes('Ir') ? 'Ir' : data.events[0])
+  );
+  const [expanded, setExpanded] = useState<Set<string>>(new Set());
+  const graph = useMemo(() => buildCallGraph(data), [data]);
+  const sites = useMemo(() => findPolymorphicCallSites(graph, event), [graph, event]);
+
+  const toggle = (key: string) => {
+    setExpanded(prev => {
+      const next = new Set(prev);
+      if (next.has(key)) next.delete(key);
+      else next.add(key);
+      return next;
+    });
+  };
+
+  return (
+    <div className="bg-white rounded-xl shadow-sm p-6 border border-gray-100">
+      <div className="flex items-center justify-between mb-4">
+        <div className="flex items-center gap-2">
+          <Shuffle className="w-5 h-5 text-orange-600" />
+          <h3 className="text-lg font-semibold text-gray-800">Indirect Call Sites</h3>
+        </div>
+        <select
+          value={event}
+          onChange={(e) => setEvent(e.target.value)}
+          className="px-2 py-1 text-sm border border-gray-300 rounded focus:outline-none focus:ring-2 focus:ring-blue-500"
+        >
+          {data.events.map(e => <option key={e} value={e}>{e}</option>)}
+        </select>
+      </div>
+
+      {sites.length === 0 ? (
+        <p className="text-sm text-gray-500">
+          No call site reached more than one function. Call sites are identified by PC, so the dump needs --dump-instr=yes.
+        </p>
+      ) : (
+        <div className="overflow-x-auto max-h-[32rem] overflow-y-auto">
+          <div className="text-sm text-gray-600 mb-2">
+            {sites.length.toLocaleString()} call sites with several targets, most expensive first
+          </div>
+          <table className="w-full">
+            <thead className="sticky top-0 bg-white">
+              <tr className="border-b border-gray-200">
+                <th className="text-left py-2 px-3 text-sm font-medium text-gray-700">Call site</th>
+                <th className="text-right py-2 px-3 text-sm font-medium text-gray-700">Calls</th>
+                <th className="text-right py-2 px-3 text-sm font-medium text-gray-700">Targets</th>
+                <th className="text-right py-2 px-3 text-sm font-medium text-gray-700" title="Entropy of the target distribution in bits">Entropy</th>
+                <th className="text-left py-2 px-3 text-sm font-medium text-gray-700">Top target</th>
+                <th className="text-right py-2 px-3 text-sm font-medium text-gray-700">{event}</th>
+                <th className="text-left py-2 px-3 text-sm font-medium text-gray-700"></th>
+              </tr>
+            </thead>
+            <tbody>
+              {sites.slice(0, MAX_SHOWN).map(site => {
+                const key = `${site.caller.key}@${site.sourcePc}`;
+                const isOpen = expanded.has(key);
+                const kind = KIND_STYLES[site.kind];
+                return (
+                  <Fragment key={key}>
+                    <tr className="border-b border-gray-100 hover:bg-gray-50 cursor-pointer" onClick={() => toggle(key)}>
+                      <td className="py-2 px-3 text-xs font-mono text-gray-800">
+                        <span className="inline-flex items-center gap-1">
+                          {isOpen ? <ChevronDown className="w-3 h-3" /> : <ChevronRight className="w-3 h-3" />}
+                          {site.caller.functionName}
+                          <span className="text-gray-400">@{site.sourcePc}</span>
+                        </span>
+                      </td>
+                      <td className="py-2 px-3 text-sm text-right text-gray-800">{site.calls.toLocaleString()}</td>
+                      <td className="py-2 px-3 text-sm text-right text-gray-600">{site.targets.length}</td>
+                      <td className="py-2 px-3 text-sm text-right text-gray-600">{site.entropy.toFixed(2)}</td>
+                      <td className="py-2 px-3 text-xs font-mono text-gray-700 truncate max-w-xs">
+                        {site.targets[0].callee.functionName}
+                        <span className="ml-1 text-gray-400">{(site.targets[0].share * 100).toFixed(1)}%</span>
+                      </td>
+                      <td className="py-2 px-3 text-sm text-right text-gray-800">{site.inclusive.toLocaleString()}</td>
+                      <td className="py-2 px-3 text-xs">
+                        <span className={cn("px-2 py-0.5 rounded", kind.className)} title={kind.title}>{kind.label}</span>
+                      </td>
+                    </tr>
+                    {isOpen && site.targets.map(target => (
+                      <tr key={`${key}->${target.callee.key}`} className="bg-gray-50 border-b border-gray-100">
+                        <td className="py-1 pl-10 pr-3 text-xs font-mono">
+                          <button
+                            onClick={() => onViewCode?.(target.callee.file, target.callee.functionName, target.callee.data?.startLine)}
+                            className={cn(onViewCode && target.callee.data ? "hover:underline text-blue-700" : "cursor-default text-gray-700")}
+                            title={target.callee.file}
+                          >
+                            {target.callee.functionName}
+                          </button>
+                        </td>
+                        <td className="py-1 px-3 text-xs text-right text-gray-700">{target.calls.toLocaleString()}</td>
+                        <td colSpan={3} className="py-1 px-3">
+                          <div className="flex items-center gap-2">
+                            <div className="w-32 bg-gray-200 rounded h-2 overflow-hidden">
+                              <div className="bg-orange-400 h-2" style={{ width: `${target.share * 100}%` }} />
+                            </div>
+                            <span className="text-xs text-gray-500">{(target.share * 100).toFixed(1)}%</span>
+                          </div>
+                        </td>
+                        <td className="py-1 px-3 text-xs text-right text-gray-700">{target.inclusive.toLocaleString()}</td>
+                        <td />
+                      </tr>
+                    ))}
+                  </Fragment>
+                );
+              })}
+            </tbody>
+          </table>
+        </div>
+      )}
+    </div>
+  );
+}
@@ -1,20 +1,26 @@
 'use client';
 
 import { useState, useEffect, useMemo, useCallback, useRef } from 'react';
-import { ChevronDown, ChevronRight, Clock, Cpu, Search, Filter, BarChart3, GitBranch } from 'lucide-react';
+import { ChevronDown, ChevronRight, Clock, Cpu, Search, Filter, BarChart3, GitBranch, Repeat, Download } from 'lucide-react';
 import { CachegrindData, CallInfo, CallTreeNode } from '@/types/profiler';
 import { cn } from '@/lib/utils';
 import { CallTreeSearchEngine, debounce } from '@/lib/call-tree-search';
 import { EntryPointMatcher } from '@/lib/entry-point-matcher';
+import { DotClusterBy } from '@/lib/dot-export';
 import { FlowChartView } from './flow-chart-view';
+import { RecursionDetails } from './recursion-details';
 
 interface CallTreeViewerProps {
   data: CachegrindData;
   entryPoint?: string | null;
   onViewCode?: (fileName: string, functionName: string) => void;
+  recursionFolded?: boolean;
+  onRecursionFoldedChange?: (folded: boolean) => void;
+  onExportGraph?: (format: 'dot' | 'svg', clusterBy: DotClusterBy) => Promise<void>;
+  canExportSvg?: boolean;
 }
 
-export function CallTreeViewer({ data, entryPoint: initialEntryPoint, onViewCode }: CallTreeViewerProps) {
+export function CallTreeViewer({ data, entryPoint: initialEntryPoint, onViewCode, recursionFolded = false, onRecursionFoldedChange, onExportGraph, canExportSvg = false }: CallTreeViewerProps) {
   const [viewMode, setViewMode] = useState<'tree' | 'caller' | 'callee'>('tree');
   const [filterDepth, setFilterDepth] = useState(10);
   const [customDepth, setCustomDepth] = useState(1);
@@ -35,6 +41,18 @@ export function CallTreeViewer({ data, entryPoint: initialEntryPoint, onViewCode
   const [splitPosition, setSplitPosition] = useState(50); // Percentage for split view
   const splitContainerRef = useRef<HTMLDivElement>(null);
   const [isDragging, setIsDragging] = useState(false);
+  const [exportClusterBy, setExportClusterBy] = useState<DotClusterBy>('object');
+  const [isExporting, setIsExporting] = useState(false);
+
+  const handleExport = async (format: 'dot' | 'svg') => {
+    if (!onExportGraph) return;
+    setIsExporting(true);
+    try {
+      await onExportGraph(format, exportClusterBy);
+    } finally {
+      setIsExporting(false);
+    }
+  };
   const scrollPositions = useRef<{ [key: string]: number | string | undefined }>({ tree: 0, caller: 0, callee: 0, previousMode: undefined });
   const scrollContainerRef = useRef<HTMLDivElement>(null);
   
@@ -105,7 +123,9 @@ export function CallTreeViewer({ data, entryPoint: initialEntryPoint, onViewCode
         totalTime: selfCycles,
         selfTime: selfCycles,
         children: [],
-        calls: funcData.calls
+        calls: funcData.calls,
+        recursion: funcData.recursion,
+        prunedCalls: funcData.prunedCalls
       };
       
       return node;
@@ -703,6 +723,23 @@ export function CallTreeViewer({ data, entryPoint: initialEntryPoint, onViewCode
                     {node.pcStart} - {node.pcEnd}
                   </span>
                 )}
+                {node.recursion && (
+                  <span
+                    className="flex items-center gap-1 text-xs text-purple-700 bg-purple-50 px-1.5 py-0.5 rounded"
+                    title={`${node.recursion.reentries.toLocaleString()} recursive calls folded`}
+                  >
+                    <Repeat size={10} />
+                    {node.recursion.maxDepth ? `${node.recursion.maxDepth} levels` : 'recursive'}
+                  </span>
+                )}
+                {node.prunedCalls && (
+                  <span
+                    className="text-xs text-gray-500 bg-gray-100 px-1.5 py-0.5 rounded"
+                    title="Calls below the pruning thresholds, merged into one entry"
+                  >
+                    {node.prunedCalls.toLocaleString()} pruned
+                  </span>
+                )}
               </div>
               <div className="flex items-center gap-4 text-xs text-gray-600 mt-1">
                 <span className="flex items-center gap-1">
@@ -1047,6 +1084,18 @@ export function CallTreeViewer({ data, entryPoint: initialEntryPoint, onViewCode
               </button>
             </div>
             
+            {onRecursionFoldedChange && (
+              <label className="flex items-center gap-2 px-3 py-2 bg-white rounded-lg border">
+                <input
+                  type="checkbox"
+                  checked={recursionFolded}
+                  onChange={(e) => onRecursionFoldedChange(e.target.checked)}
+                  className="rounded"
+                />
+                <span className="text-sm">Fold Recursion</span>
+              </label>
+            )}
+            
             <label className="flex items-center gap-2 px-3 py-2 bg-white rounded-lg border">
               <input
                 type="checkbox"
@@ -1056,6 +1105,39 @@ export function CallTreeViewer({ data, entryPoint: initialEntryPoint, onViewCode
               />
               <span className="text-sm">Show Flow Chart</span>
             </label>
+            
+            {onExportGraph && (
+              <div className="flex items-center gap-2 px-3 py-1 bg-white rounded-lg border">
+                <Download size={14} className="text-gray-600" />
+                <select
+                  value={exportClusterBy}
+                  onChange={(e) => setExportClusterBy(e.target.value as DotClusterBy)}
+                  className="text-sm border-none bg-transparent focus:outline-none"
+                  title="Group nodes in the exported graph"
+                >
+                  <option value="object">By object</option>
+                  <option value="file">By file</option>
+                  <option value="none">No clusters</option>
+                </select>
+                <button
+                  onClick={() => handleExport('dot')}
+                  disabled={isExporting}
+                  className="px-2 py-1 text-sm text-gray-700 hover:bg-gray-100 rounded disabled:opacity-50"
+                >
+                  DOT
+                </button>
+                {canExportSvg && (
+                  <button
+                    onClick={() => handleExport('svg')}
+                    disabled={isExporting}
+                    className="px-2 py-1 text-sm text-gray-700 hover:bg-gray-100 rounded disabled:opacity-50"
+                    title="Rendered on the server with graphviz"
+                  >
+                    SVG
+                  </button>
+                )}
+              </div>
+            )}
           </div>
         </div>
       </div>
@@ -1137,6 +1219,10 @@ export function CallTreeViewer({ data, entryPoint: initialEntryPoint, onViewCode
                     </div>
                   )}
 
+                  {selectedFunction?.recursion && (
+                    <RecursionDetails recursion={selectedFunction.recursion} metricName={metricName} />
+                  )}
+
                   <div className="border rounded-lg p-4 bg-gray-50">
                     <h4 className="font-semibold text-gray-900 mb-3">Summary Statistics</h4>
                     <div className="space-y-2 text-sm">
@@ -1238,6 +1324,10 @@ export function CallTreeViewer({ data, entryPoint: initialEntryPoint, onViewCode
                 </div>
               )}
 
+              {selectedFunction?.recursion && (
+                <RecursionDetails recursion={selectedFunction.recursion} metricName={metricName} />
+              )}
+
               <div className="border rounded-lg p-4 bg-gray-50">
                 <h4 className="font-semibold text-gray-900 mb-3">Summary Statistics</h4>
                 <div className="space-y-2 text-sm">
@@ -0,0 +1,197 @@
+'use client';
+
+import { Fragment, useMemo, useState } from 'react';
+import { Snowflake, ChevronRight, ChevronDown } from 'lucide-react';
+import { CachegrindData } from '@/types/profiler';
+import { getAssemblyForSymbol } from '@/app/actions/assembly';
+import { ColdCodeMeasure, executedPcsOf, measureColdCode, rankColdFunctions } from '@/lib/cold-regions';
+import { cn } from '@/lib/utils';
+
+interface ColdRegionsViewProps {
+  data: CachegrindData;
+  onViewCode?: (fileName: string, functionName: string, line?: number) => void;
+}
+
+const MIN_SHARES = [0.001, 0.005, 0.01, 0.05];
+const MAX_SHOWN = 50;
+const MAX_DISASSEMBLED = 20;
+
+// Collapse sorted line numbers into ranges, e.g. [1,2,3,7] -> "1-3, 7"
+const formatLines = (lines: number[]): string => {
+  const ranges: string[] = [];
+  for (let i = 0; i < lines.length; i++) {
+    let j = i;
+    while (j + 1 < lines.length && lines[j + 1] === lines[j] + 1) j++;
+    ranges.push(i === j ? `${lines[i]}` : `${lines[i]}-${lines[j]}`);
+    i = j;
+  }
+  return ranges.join(', ');
+};
+
+export function ColdRegionsView({ data, onViewCode }: ColdRegionsViewProps) {
+  const [event, setEvent] = useState(
+    data.events.includes('Cy') ? 'Cy' : (data.events.includes('Ir') ? 'Ir' : data.events[0])
+  );
+  const [minShare, setMinShare] = useState(0.005);
+  const [measures, setMeasures] = useState<Map<string, ColdCodeMeasure>>(new Map());
+  const [expanded, setExpanded] = useState<string | null>(null);
+  const [isMeasuring, setIsMeasuring] = useState(false);
+  const [measureError, setMeasureError] = useState<string | null>(null);
+
+  const functions = useMemo(
+    () => rankColdFunctions(data, event, minShare, measures),
+    [data, event, minShare, measures]
+  );
+
+  // Disassemble the whole symbol of each hot function, cold parts included
+  const handleMeasure = async () => {
+    setIsMeasuring(true);
+    setMeasureError(null);
+    const objdumpCommand = localStorage.getItem('profiler-objdump-command') || 'objdump';
+    const pending = functions
+      .filter(fn => !measures.has(`${fn.file}:${fn.functionName}`) && data.fileCoverage[fn.file]?.objectFile && fn.data.pcData)
+      .slice(0, MAX_DISASSEMBLED);
+    const next = new Map(measures);
+    let failed = 0;
+    for (const fn of pending) {
+      const executed = executedPcsOf(fn.data);
+      const firstPc = Math.min(...Array.from(executed));
+      const result = Number.isFinite(firstPc)
+        ? await getAssemblyForSymbol(data.fileCoverage[fn.file].objectFile!, '0x' + firstPc.toString(16), objdumpCommand)
+        : null;
+      if (result && result.assembly.instructions.length > 0) {
+        next.set(`${fn.file}:${fn.functionName}`, measureColdCode(result.assembly.instructions, executed));
+      } else {
+        failed++;
+      }
+    }
+    if (failed > 0) setMeasureError(`Could not disassemble ${failed} of ${pending.length} functions`);
+    setMeasures(next);
+    setIsMeasuring(false);
+  };
+
+  const hasPcData = data.granularity === undefined || data.granularity === 'instr';
+
+  return (
+    <div className="bg-white rounded-xl shadow-sm p-6 border border-gray-100">
+      <div className="flex items-center justify-between mb-4">
+        <div className="flex items-center gap-2">
+          <Snowflake className="w-5 h-5 text-sky-600" />
+          <h3 className="text-lg font-semibold text-gray-800">Cold Code in Hot Functions</h3>
+        </div>
+        <div className="flex items-center gap-3">
+          <select
+            value={event}
+            onChange={(e) => setEvent(e.target.value)}
+            className="px-2 py-1 text-sm border border-gray-300 rounded focus:outline-none focus:ring-2 focus:ring-blue-500"
+          >
+            {data.events.map(e => <option key={e} value={e}>{e}</option>)}
+          </select>
+          <select
+            value={minShare}
+            onChange={(e) => setMinShare(parseFloat(e.target.value))}
+            className="px-2 py-1 text-sm border border-gray-300 rounded focus:outline-none focus:ring-2 focus:ring-blue-500"
+          >
+            {MIN_SHARES.map(share => <option key={share} value={share}>≥ {share * 100}% of total</option>)}
+          </select>
+          <button
+            onClick={handleMeasure}
+            disabled={isMeasuring || !hasPcData || functions.length === 0}
+            className="px-3 py-1.5 bg-blue-500 text-white rounded-lg hover:bg-blue-600 transition-colors text-sm disabled:opacity-50"
+            title={hasPcData
+              ? 'Measure cold bytes and instructions with objdump'
+              : 'Needs a profile loaded at instruction granularity'}
+          >
+            {isMeasuring ? 'Measuring...' : 'Measure bytes'}
+          </button>
+        </div>
+      </div>
+      <p className="text-xs text-gray-500 mb-3">
+        Hot functions ranked by how much of their code never ran. Unmeasured functions are estimated from compiled source lines.
+      </p>
+      {measureError && <p className="text-xs text-amber-700 mb-2">{measureError}</p>}
+
+      {functions.length === 0 ? (
+        <p className="text-sm text-gray-500">No function reaches this share of {event}.</p>
+      ) : (
+        <div className="overflow-x-auto max-h-[32rem] overflow-y-auto">
+          <table className="w-full">
+            <thead className="sticky top-0 bg-white">
+              <tr className="border-b border-gray-200">
+                <th className="text-left py-2 px-3 text-sm font-medium text-gray-700">Function</th>
+                <th className="text-right py-2 px-3 text-sm font-medium text-gray-700">{event}</th>
+                <th className="text-right py-2 px-3 text-sm font-medium text-gray-700">Cold</th>
+                <th className="text-right py-2 px-3 text-sm font-medium text-gray-700">Cold code</th>
+                <th className="text-right py-2 px-3 text-sm font-medium text-gray-700">Regions</th>
+              </tr>
+            </thead>
+            <tbody>
+              {functions.slice(0, MAX_SHOWN).map(fn => {
+                const key = `${fn.file}:${fn.functionName}`;
+                const isOpen = expanded === key;
+                return (
+                  <Fragment key={key}>
+                    <tr className="border-b border-gray-100 hover:bg-gray-50">
+                      <td className="py-2 px-3 text-xs font-mono text-gray-800">
+                        <span className="inline-flex items-center gap-1">
+                          {fn.measure && fn.measure.regions.length > 0 ? (
+                            <button onClick={() => setExpanded(isOpen ? null : key)} className="text-gray-500">
+                              {isOpen ? <ChevronDown className="w-3 h-3" /> : <ChevronRight className="w-3 h-3" />}
+                            </button>
+                          ) : <span className="w-3" />}
+                          <button
+                            onClick={() => onViewCode?.(fn.file, fn.functionName, fn.data.uncoveredLines[0])}
+                            className={cn(onViewCode ? "hover:underline text-blue-700" : "cursor-default")}
+                            title={fn.file}
+                          >
+                            {fn.functionName}
+                          </button>
+                        </span>
+                      </td>
+                      <td className="py-2 px-3 text-sm text-right text-gray-800">
+                        {fn.cost.toLocaleString()}
+                        <span className="ml-1 text-xs text-gray-400">{(fn.share * 100).toFixed(1)}%</span>
+                      </td>
+                      <td className="py-2 px-3 text-sm text-right font-medium text-sky-700">
+                        {(fn.coldFraction * 100).toFixed(1)}%
+                      </td>
+                      <td className="py-2 px-3 text-xs text-right text-gray-600 whitespace-nowrap">
+                        {fn.measure
+                          ? `${fn.measure.coldBytes.toLocaleString()} / ${fn.measure.totalBytes.toLocaleString()} bytes, ${fn.measure.coldInstructions.toLocaleString()} instr`
+                          : `${fn.coldLines} / ${fn.compiledLines} lines`}
+                      </td>
+                      <td className="py-2 px-3 text-sm text-right text-gray-600">
+                        {fn.measure ? fn.measure.regions.length : '-'}
+                      </td>
+                    </tr>
+                    {isOpen && fn.measure!.regions.map(region => (
+                      <tr key={`${key}@${region.start}`} className="bg-gray-50 border-b border-gray-100">
+                        <td className="py-1 pl-10 pr-3 text-xs font-mono text-gray-600">
+                          0x{region.start.toString(16)}-0x{region.end.toString(16)}
+                        </td>
+                        <td colSpan={2} className="py-1 px-3 text-xs text-gray-600">
+                          {region.lines.length > 0 && (
+                            <button
+                              onClick={() => onViewCode?.(fn.file, fn.functionName, region.lines[0])}
+                              className={cn(onViewCode ? "hover:underline text-blue-700" : "cursor-default")}
+                            >
+                              lines {formatLines(region.lines)}
+                            </button>
+                          )}
+                        </td>
+                        <td className="py-1 px-3 text-xs text-right text-gray-600">
+                          {region.bytes} bytes, {region.instructions} instr
+                        </td>
+                        <td />
+                      </tr>
+                    ))}
+                  </Fragment>
+                );
+              })}
+            </tbody>
+          </table>
+        </div>
+      )}
+    </div>
+  );
+}
@@ -0,0 +1,325 @@
+'use client';
+
+import { useEffect, useMemo, useRef, useState } from 'react';
+import { AlertCircle, Maximize2 } from 'lucide-react';
+import { AssemblyData, JumpInfo, PcLineData } from '@/types/profiler';
+import { getAssemblyForFunction, getAssemblyForSymbol } from '@/app/actions/assembly';
+import { buildControlFlowGraph, CfgBlock } from '@/lib/control-flow-graph';
+import { BLOCK_HEIGHT, BLOCK_WIDTH, CfgLayout, layoutInWorker } from '@/lib/control-flow-layout';
+import { cn } from '@/lib/utils';
+
+interface ControlFlowGraphViewProps {
+  objectFile: string;
+  pcData: Record<string, PcLineData>;
+  jumps?: JumpInfo[];
+  availableEvents: string[];
+  selectedPc?: string | null;
+  onBlockClick?: (block: CfgBlock) => void;
+  isDarkTheme?: boolean;
+}
+
+const PADDING = 24;
+const MIN_SCALE = 0.02;
+const MAX_SCALE = 4;
+const LOOP_COLOR = '#ea580c';
+
+// Cold to hot: pale yellow through orange to red
+const heatColor = (ratio: number) => `hsl(${Math.round(55 - 55 * ratio)}, 90%, ${Math.round(88 - 38 * ratio)}%)`;
+
+export function ControlFlowGraphView({
+  objectFile,
+  pcData,
+  jumps,
+  availableEvents,
+  selectedPc,
+  onBlockClick,
+  isDarkTheme = false
+}: ControlFlowGraphViewProps) {
+  const [assembly, setAssembly] = useState<AssemblyData | null>(null);
+  const [layout, setLayout] = useState<CfgLayout | null>(null);
+  const [event, setEvent] = useState(() =>
+    availableEvents.includes('Cy') ? 'Cy' : (availableEvents.includes('Ir') ? 'Ir' : availableEvents[0] || ''));
+  const [view, setView] = useState({ scale: 1, x: 0, y: 0 });
+  const [size, setSize] = useState({ width: 0, height: 0 });
+  const [hovered, setHovered] = useState<CfgBlock | null>(null);
+  const [isLoading, setIsLoading] = useState(false);
+  const [error, setError] = useState<string | null>(null);
+  const containerRef = useRef<HTMLDivElement>(null);
+  const canvasRef = useRef<HTMLCanvasElement>(null);
+  const dragRef = useRef<{ x: number; y: number; moved: boolean } | null>(null);
+
+  // The whole symbol is disassembled so blocks that never ran still show up
+  useEffect(() => {
+    const firstPc = Object.keys(pcData).sort((a, b) => parseInt(a, 16) - parseInt(b, 16))[0];
+    if (!firstPc) return;
+    let cancelled = false;
+    setIsLoading(true);
+    setError(null);
+    (async () => {
+      try {
+        const objdumpCommand = localStorage.getItem('profiler-objdump-command') || 'objdump';
+        const symbol = await getAssemblyForSymbol(objectFile, firstPc, objdumpCommand);
+        const data = symbol?.assembly || await getAssemblyForFunction(objectFile, pcData, objdumpCommand);
+        if (cancelled) return;
+        data?.instructions.forEach(inst => {
+          const info = pcData[inst.pc];
+          if (info) {
+            inst.events = info.events;
+            inst.executed = info.executed;
+          }
+        });
+        setAssembly(data);
+        if (!data) setError('No assembly found for this function');
+      } catch (err: any) {
+        console.error('Error fetching assembly:', err);
+        if (!cancelled) setError(err.message || 'Failed to load assembly code');
+      } finally {
+        if (!cancelled) setIsLoading(false);
+      }
+    })();
+    return () => { cancelled = true; };
+  }, [objectFile, pcData]);
+
+  const graph = useMemo(
+    () => assembly ? buildControlFlowGraph(assembly.instructions, jumps, pcData) : null,
+    [assembly, jumps, pcData]
+  );
+
+  useEffect(() => {
+    if (!graph) return;
+    let cancelled = false;
+    const forward = graph.edges.filter(edge => !edge.backEdge);
+    layoutInWorker({
+      blockCount: graph.blocks.length,
+      from: Int32Array.from(forward, edge => edge.from),
+      to: Int32Array.from(forward, edge => edge.to)
+    }).then(result => {
+      if (!cancelled) setLayout(result);
+    });
+    return () => { cancelled = true; };
+  }, [graph]);
+
+  useEffect(() => {
+    const container = containerRef.current;
+    if (!container) return;
+    const observer = new ResizeObserver(entries => {
+      const rect = entries[0].contentRect;
+      setSize({ width: Math.floor(rect.width), height: Math.floor(rect.height) });
+    });
+    observer.observe(container);
+    return () => observer.disconnect();
+  }, []);
+
+  const fitToView = () => {
+    if (!layout || size.width === 0) return;
+    const scale = Math.min(
+      MAX_SCALE,
+      Math.max(MIN_SCALE, Math.min((size.width - 2 * PADDING) / Math.max(layout.width, 1), (size.height - 2 * PADDING) / Math.max(layout.height, 1), 1))
+    );
+    setView({ scale, x: (size.width - layout.width * scale) / 2, y: PADDING });
+  };
+
+  // Fit a newly laid out graph once the pane has a size
+  useEffect(fitToView, [layout, size.width > 0]); // eslint-disable-line react-hooks/exhaustive-deps
+
+  const maxCost = useMemo(
+    () => graph ? graph.blocks.reduce((max, block) => Math.max(max, block.costs[event] || 0), 0) : 0,
+    [graph, event]
+  );
+  const maxCount = useMemo(
+    () => graph ? graph.edges.reduce((max, edge) => Math.max(max, edge.count || 0), 0) : 0,
+    [graph]
+  );
+  const selectedBlock = useMemo(() => {
+    if (!graph || !selectedPc) return -1;
+    const pc = parseInt(selectedPc, 16);
+    return graph.blocks.findIndex(block => pc >= parseInt(block.startPc, 16) && pc <= parseInt(block.endPc, 16));
+  }, [graph, selectedPc]);
+
+  useEffect(() => {
+    const canvas = canvasRef.current;
+    if (!canvas || !graph || !layout || size.width === 0 || layout.x.length !== graph.blocks.length) return;
+    const ratio = window.devicePixelRatio || 1;
+    canvas.width = size.width * ratio;
+    canvas.height = size.height * ratio;
+    const ctx = canvas.getContext('2d');
+    if (!ctx) return;
+    ctx.setTransform(ratio, 0, 0, ratio, 0, 0);
+    ctx.clearRect(0, 0, size.width, size.height);
+    ctx.translate(view.x, view.y);
+    ctx.scale(view.scale, view.scale);
+
+    // Visible region in graph coordinates; blocks and edges outside it are skipped
+    const left = -view.x / view.scale - BLOCK_WIDTH;
+    const top = -view.y / view.scale - BLOCK_HEIGHT;
+    const right = (size.width - view.x) / view.scale;
+    const bottom = (size.height - view.y) / view.scale;
+    const visible = (b: number) => layout.x[b] >= left && layout.x[b] <= right && layout.y[b] >= top && layout.y[b] <= bottom;
+
+    const edgeWidth = (count?: number) =>
+      count && maxCount > 0 ? 1 + 6 * Math.log(count + 1) / Math.log(maxCount + 1) : 1;
+    graph.edges.forEach(edge => {
+      if (!visible(edge.from) && !visible(edge.to)) {
+        const [y1, y2] = [layout.y[edge.from], layout.y[edge.to]];
+        if (Math.max(y1, y2) < top || Math.min(y1, y2) > bottom) return;
+      }
+      const x1 = layout.x[edge.from] + BLOCK_WIDTH / 2;
+      const y1 = layout.y[edge.from] + BLOCK_HEIGHT;
+      const x2 = layout.x[edge.to] + BLOCK_WIDTH / 2;
+      const y2 = layout.y[edge.to];
+      ctx.lineWidth = edgeWidth(edge.count) / Math.max(view.scale, 0.25);
+      ctx.strokeStyle = edge.backEdge ? LOOP_COLOR : (edge.count === 0 ? '#d1d5db' : (isDarkTheme ? '#9ca3af' : '#6b7280'));
+      ctx.setLineDash(edge.kind === 'fallthrough' ? [4, 3] : []);
+      ctx.beginPath();
+      ctx.moveTo(x1, y1);
+      if (edge.backEdge) {
+        // Loop back edges bend around the right side of the blocks
+        const side = Math.max(layout.x[edge.from], layout.x[edge.to]) + BLOCK_WIDTH + 24;
+        ctx.bezierCurveTo(side, y1 + 24, side, y2 - 24, x2 + BLOCK_WIDTH / 2, y2 + BLOCK_HEIGHT / 2);
+      } else {
+        ctx.bezierCurveTo(x1, (y1 + y2) / 2, x2, (y1 + y2) / 2, x2, y2);
+      }
+      ctx.stroke();
+    });
+    ctx.setLineDash([]);
+
+    const showText = view.scale >= 0.45;
+    ctx.font = '11px ui-monospace, monospace';
+    ctx.textBaseline = 'top';
+    graph.blocks.forEach((block, b) => {
+      if (!visible(b)) return;
+      const cost = block.costs[event] || 0;
+      ctx.fillStyle = !block.executed ? (isDarkTheme ? '#374151' : '#e5e7eb') : heatColor(maxCost > 0 ? cost / maxCost : 0);
+      ctx.fillRect(layout.x[b], layout.y[b], BLOCK_WIDTH, BLOCK_HEIGHT);
+      ctx.lineWidth = b === selectedBlock ? 3 : (block.loopDepth > 0 ? 1 + block.loopDepth : 1);
+      ctx.strokeStyle = b === selectedBlock ? '#2563eb' : (block.loopDepth > 0 ? LOOP_COLOR : '#9ca3af');
+      ctx.strokeRect(layout.x[b], layout.y[b], BLOCK_WIDTH, BLOCK_HEIGHT);
+      if (showText) {
+        ctx.fillStyle = '#1f2937';
+        ctx.fillText(`${block.startPc}${block.loopHeader ? ' ⟲' : ''}`, layout.x[b] + 6, layout.y[b] + 6);
+        ctx.fillStyle = '#4b5563';
+        ctx.fillText(`${cost.toLocaleString()} ${event} · ${block.instructions.length} insn`, layout.x[b] + 6, layout.y[b] + 22);
+      }
+    });
+  }, [graph, layout, view, size, event, maxCost, maxCount, selectedBlock, isDarkTheme]);
+
+  // Zoom around the cursor; registered by hand so the page does not scroll
+  useEffect(() => {
+    const canvas = canvasRef.current;
+    if (!canvas) return;
+    const handleWheel = (e: WheelEvent) => {
+      e.preventDefault();
+      const bounds = canvas.getBoundingClientRect();
+      const px = e.clientX - bounds.left;
+      const py = e.clientY - bounds.top;
+      setView(current => {
+        const scale = Math.min(MAX_SCALE, Math.max(MIN_SCALE, current.scale * Math.exp(-e.deltaY * 0.0015)));
+        return {
+          scale,
+          x: px - (px - current.x) * scale / current.scale,
+          y: py - (py - current.y) * scale / current.scale
+        };
+      });
+    };
+    canvas.addEventListener('wheel', handleWheel, { passive: false });
+    return () => canvas.removeEventListener('wheel', handleWheel);
+  }, []);
+
+  const hitTest = (e: React.MouseEvent<HTMLCanvasElement>): CfgBlock | null => {
+    if (!graph || !layout) return null;
+    const bounds = e.currentTarget.getBoundingClientRect();
+    const x = (e.clientX - bounds.left - view.x) / view.scale;
+    const y = (e.clientY - bounds.top - view.y) / view.scale;
+    const b = graph.blocks.findIndex((_, i) =>
+      x >= layout.x[i] && x < layout.x[i] + BLOCK_WIDTH && y >= layout.y[i] && y < layout.y[i] + BLOCK_HEIGHT);
+    return b >= 0 ? graph.blocks[b] : null;
+  };
+
+  const executedBlocks = graph ? graph.blocks.filter(block => block.executed).length : 0;
+
+  return (
+    <div className={cn("h-full flex flex-col", isDarkTheme ? "bg-gray-900" : "bg-gray-50")}>
+      <div className={cn(
+        "flex items-center gap-3 px-4 py-1.5 border-b text-xs",
+        isDarkTheme ? "border-gray-700 text-gray-300" : "border-gray-200 text-gray-600"
+      )}>
+        {graph && (
+          <span>
+            {graph.blocks.length.toLocaleString()} blocks ({executedBlocks.toLocaleString()} executed),{' '}
+            {graph.edges.length.toLocaleString()} edges, {graph.loopCount.toLocaleString()} loops
+            {!jumps?.length && ' · no jump counts (record with --collect-jumps=yes)'}
+          </span>
+        )}
+        <div className="ml-auto flex items-center gap-2">
+          <select
+            value={event}
+            onChange={(e) => setEvent(e.target.value)}
+            className="px-2 py-0.5 text-xs border border-gray-300 rounded text-gray-800 focus:outline-none focus:ring-2 focus:ring-blue-500"
+          >
+            {availableEvents.map(e => <option key={e} value={e}>{e}</option>)}
+          </select>
+          <button
+            onClick={fitToView}
+            className="p-1 rounded hover:bg-gray-200 text-gray-600"
+            title="Fit graph to view"
+          >
+            <Maximize2 className="w-3.5 h-3.5" />
+          </button>
+        </div>
+      </div>
+
+      <div ref={containerRef} className="relative flex-1 overflow-hidden">
+        {(isLoading || error || (graph && !layout)) && (
+          <div className={cn(
+            "absolute inset-0 flex items-center justify-center text-sm",
+            error ? "text-red-500" : "text-gray-500"
+          )}>
+            {error ? (
+              <span className="flex items-center gap-2"><AlertCircle className="w-4 h-4" />{error}</span>
+            ) : 'Building control-flow graph...'}
+          </div>
+        )}
+        <canvas
+          ref={canvasRef}
+          style={{ width: size.width, height: size.height }}
+          className="cursor-pointer"
+          onMouseDown={(e) => { dragRef.current = { x: e.clientX, y: e.clientY, moved: false }; }}
+          onMouseMove={(e) => {
+            const drag = dragRef.current;
+            if (drag && e.buttons === 1) {
+              const dx = e.clientX - drag.x;
+              const dy = e.clientY - drag.y;
+              if (!drag.moved && Math.abs(dx) + Math.abs(dy) < 3) return;
+              drag.moved = true;
+              drag.x = e.clientX;
+              drag.y = e.clientY;
+              setView(current => ({ ...current, x: current.x + dx, y: current.y + dy }));
+              return;
+            }
+            const block = hitTest(e);
+            if (block !== hovered) setHovered(block);
+          }}
+          onMouseUp={(e) => {
+            const moved = dragRef.current?.moved;
+            dragRef.current = null;
+            if (moved) return;
+            const block = hitTest(e);
+            if (block) onBlockClick?.(block);
+          }}
+          onMouseLeave={() => { dragRef.current = null; setHovered(null); }}
+        />
+        {hovered && (
+          <div className="absolute top-2 right-2 bg-white/95 border border-gray-200 rounded-lg shadow px-3 py-2 text-xs pointer-events-none max-w-md">
+            <div className="font-mono text-gray-800">
+              {hovered.startPc} – {hovered.endPc}{hovered.line ? ` · line ${hovered.line}` : ''}
+            </div>
+            <div className="text-gray-500">
+              {Object.entries(hovered.costs).map(([name, value]) => `${name} ${value.toLocaleString()}`).join(' · ') || 'not executed'}
+              {hovered.loopDepth > 0 && ` · loop depth ${hovered.loopDepth}`}
+            </div>
+          </div>
+        )}
+      </div>
+    </div>
+  );
+}
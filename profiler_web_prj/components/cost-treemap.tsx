@@ -0,0 +1,204 @@
+'use client';
+
+import { useEffect, useMemo, useRef, useState } from 'react';
+import { LayoutGrid, ChevronRight } from 'lucide-react';
+import { CachegrindData } from '@/types/profiler';
+import { buildCostTree, costTreePath, CostTreeNode, squarify, TreemapRect } from '@/lib/cost-tree';
+import { cn } from '@/lib/utils';
+
+interface CostTreemapProps {
+  data: CachegrindData;
+  onViewCode?: (fileName: string, functionName: string) => void;
+}
+
+const HEIGHT = 420;
+const HEADER = 16; // label strip above nested rectangles
+const MIN_SIZE = 2; // rectangles smaller than this are not drawn
+
+const KIND_LABELS: Record<string, string> = {
+  object: 'object',
+  directory: 'directory',
+  file: 'file',
+  function: 'function'
+};
+
+const hueOf = (name: string) => {
+  let hash = 0;
+  for (let i = 0; i < name.length; i++) hash = (hash * 31 + name.charCodeAt(i)) | 0;
+  return Math.abs(hash) % 360;
+};
+
+export function CostTreemap({ data, onViewCode }: CostTreemapProps) {
+  const tree = useMemo(() => buildCostTree(data), [data]);
+  const [eventIndex, setEventIndex] = useState(() =>
+    Math.max(0, data.events.indexOf(data.events.includes('Cy') ? 'Cy' : 'Ir')));
+  const [current, setCurrent] = useState<CostTreeNode>(tree);
+  const [hovered, setHovered] = useState<TreemapRect | null>(null);
+  const [width, setWidth] = useState(0);
+  const containerRef = useRef<HTMLDivElement>(null);
+  const canvasRef = useRef<HTMLCanvasElement>(null);
+
+  useEffect(() => setCurrent(tree), [tree]);
+
+  useEffect(() => {
+    const container = containerRef.current;
+    if (!container) return;
+    const observer = new ResizeObserver(entries => setWidth(Math.floor(entries[0].contentRect.width)));
+    observer.observe(container);
+    return () => observer.disconnect();
+  }, []);
+
+  // Two levels are laid out: the current node's children, and their children nested inside
+  const layout = useMemo(() => {
+    const outer = squarify(current.children, eventIndex, 0, 0, width, HEIGHT);
+    const inner: TreemapRect[] = [];
+    outer.forEach(rect => {
+      if (rect.node.children.length === 0 || rect.width < 4 * HEADER || rect.height < 2 * HEADER) return;
+      inner.push(...squarify(rect.node.children, eventIndex, rect.x + 1, rect.y + HEADER, rect.width - 2, rect.height - HEADER - 1));
+    });
+    return { outer, inner };
+  }, [current, eventIndex, width]);
+
+  useEffect(() => {
+    const canvas = canvasRef.current;
+    if (!canvas || width === 0) return;
+    const ratio = window.devicePixelRatio || 1;
+    canvas.width = width * ratio;
+    canvas.height = HEIGHT * ratio;
+    const ctx = canvas.getContext('2d');
+    if (!ctx) return;
+    ctx.setTransform(ratio, 0, 0, ratio, 0, 0);
+    ctx.clearRect(0, 0, width, HEIGHT);
+    ctx.font = '11px ui-monospace, monospace';
+    ctx.textBaseline = 'top';
+
+    const drawLabel = (text: string, x: number, y: number, maxWidth: number) => {
+      if (maxWidth < 24) return;
+      let label = text;
+      while (label.length > 1 && ctx.measureText(label).width > maxWidth) label = label.slice(0, -2);
+      if (label !== text) label = `${label.slice(0, -1)}…`;
+      ctx.fillText(label, x, y);
+    };
+
+    layout.outer.forEach(rect => {
+      if (rect.width < MIN_SIZE || rect.height < MIN_SIZE) return;
+      const hue = hueOf(rect.node.name);
+      ctx.fillStyle = `hsl(${hue}, 45%, 72%)`;
+      ctx.fillRect(rect.x, rect.y, rect.width, rect.height);
+      ctx.strokeStyle = '#ffffff';
+      ctx.lineWidth = 2;
+      ctx.strokeRect(rect.x, rect.y, rect.width, rect.height);
+      ctx.fillStyle = '#1f2937';
+      drawLabel(rect.node.name, rect.x + 4, rect.y + 3, rect.width - 8);
+    });
+
+    layout.inner.forEach(rect => {
+      if (rect.width < MIN_SIZE || rect.height < MIN_SIZE) return;
+      const hue = hueOf(rect.node.parent?.name || rect.node.name);
+      ctx.fillStyle = `hsl(${hue}, 55%, ${rect.node.kind === 'function' ? 85 : 80}%)`;
+      ctx.fillRect(rect.x, rect.y, rect.width, rect.height);
+      ctx.strokeStyle = `hsl(${hue}, 30%, 60%)`;
+      ctx.lineWidth = 0.5;
+      ctx.strokeRect(rect.x, rect.y, rect.width, rect.height);
+      if (rect.height >= 14) {
+        ctx.fillStyle = '#374151';
+        drawLabel(rect.node.name, rect.x + 3, rect.y + 2, rect.width - 6);
+      }
+    });
+
+    if (hovered) {
+      ctx.strokeStyle = '#1d4ed8';
+      ctx.lineWidth = 2;
+      ctx.strokeRect(hovered.x + 1, hovered.y + 1, hovered.width - 2, hovered.height - 2);
+    }
+  }, [layout, width, hovered]);
+
+  const hitTest = (x: number, y: number): TreemapRect | null => {
+    const contains = (rect: TreemapRect) =>
+      x >= rect.x && x < rect.x + rect.width && y >= rect.y && y < rect.y + rect.height;
+    return layout.inner.find(contains) || layout.outer.find(contains) || null;
+  };
+
+  const eventPosition = (e: React.MouseEvent<HTMLCanvasElement>) => {
+    const bounds = e.currentTarget.getBoundingClientRect();
+    return { x: e.clientX - bounds.left, y: e.clientY - bounds.top };
+  };
+
+  const handleClick = (e: React.MouseEvent<HTMLCanvasElement>) => {
+    const { x, y } = eventPosition(e);
+    const rect = hitTest(x, y);
+    if (!rect) return;
+    if (rect.node.kind === 'function') {
+      const file = rect.node.parent?.path;
+      if (file) onViewCode?.(file, rect.node.name);
+    } else if (rect.node.children.length > 0) {
+      setCurrent(rect.node);
+      setHovered(null);
+    }
+  };
+
+  const total = tree.values[eventIndex];
+  const share = (node: CostTreeNode) => total > 0 ? `${((node.values[eventIndex] / total) * 100).toFixed(2)}%` : '-';
+
+  return (
+    <div className="bg-white rounded-xl shadow-sm p-6 border border-gray-100">
+      <div className="flex items-center justify-between mb-4">
+        <div className="flex items-center gap-2">
+          <LayoutGrid className="w-5 h-5 text-indigo-600" />
+          <h3 className="text-lg font-semibold text-gray-800">Cost Map</h3>
+        </div>
+        <select
+          value={eventIndex}
+          onChange={(e) => setEventIndex(parseInt(e.target.value, 10))}
+          className="px-2 py-1 text-sm border border-gray-300 rounded focus:outline-none focus:ring-2 focus:ring-blue-500"
+        >
+          {data.events.map((event, i) => <option key={event} value={i}>{event}</option>)}
+        </select>
+      </div>
+
+      {/* Breadcrumb */}
+      <div className="flex items-center flex-wrap gap-1 mb-3 text-sm">
+        {costTreePath(current).map((node, i, path) => (
+          <span key={`${node.kind}:${node.path}`} className="flex items-center gap-1">
+            {i > 0 && <ChevronRight className="w-3 h-3 text-gray-400" />}
+            <button
+              onClick={() => setCurrent(node)}
+              disabled={i === path.length - 1}
+              className={cn(
+                "font-mono text-xs",
+                i === path.length - 1 ? "text-gray-800 font-semibold" : "text-blue-700 hover:underline"
+              )}
+              title={node.path}
+            >
+              {node.name}
+            </button>
+          </span>
+        ))}
+        <span className="ml-2 text-xs text-gray-500">{current.values[eventIndex].toLocaleString()} ({share(current)})</span>
+      </div>
+
+      <div ref={containerRef} className="relative w-full" style={{ height: HEIGHT }}>
+        <canvas
+          ref={canvasRef}
+          style={{ width: '100%', height: HEIGHT }}
+          className="cursor-pointer"
+          onClick={handleClick}
+          onMouseMove={(e) => {
+            const { x, y } = eventPosition(e);
+            const rect = hitTest(x, y);
+            if (rect?.node !== hovered?.node) setHovered(rect);
+          }}
+          onMouseLeave={() => setHovered(null)}
+        />
+        {hovered && (
+          <div className="absolute top-2 right-2 bg-white/95 border border-gray-200 rounded-lg shadow px-3 py-2 text-xs pointer-events-none max-w-sm">
+            <div className="font-mono text-gray-800 break-all">{hovered.node.name}</div>
+            <div className="text-gray-500">
+              {KIND_LABELS[hovered.node.kind]} · {hovered.node.values[eventIndex].toLocaleString()} {data.events[eventIndex]} · {share(hovered.node)}
+            </div>
+          </div>
+        )}
+      </div>
+    </div>
+  );
+}
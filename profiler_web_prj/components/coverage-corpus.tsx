@@ -0,0 +1,246 @@
+'use client';
+
+import { useEffect, useState } from 'react';
+import { Layers, GitCompare, AlertCircle } from 'lucide-react';
+import { computeCoverageUnion, diffRunCoverage, listCoverageRuns } from '@/app/actions/coverage';
+import { CoverageDiffEntry, CoverageFileSummary } from '@/lib/coverage-bitset';
+import { cn, formatPercentage, getCoverageColor } from '@/lib/utils';
+import { TestImpactPanel } from './test-impact-panel';
+import { ProfileCostDiff } from './profile-cost-diff';
+import { NeverExecutedPanel } from './never-executed-panel';
+
+interface CoverageCorpusProps {
+  initialDirectory?: string;
+}
+
+// Collapse sorted line numbers into ranges, e.g. [1,2,3,7] -> "1-3, 7"
+const formatLineRanges = (lines: number[], limit: number = 20): string => {
+  const ranges: string[] = [];
+  let i = 0;
+  while (i < lines.length && ranges.length < limit) {
+    let j = i;
+    while (j + 1 < lines.length && lines[j + 1] === lines[j] + 1) j++;
+    ranges.push(i === j ? `${lines[i]}` : `${lines[i]}-${lines[j]}`);
+    i = j + 1;
+  }
+  return i < lines.length ? `${ranges.join(', ')}, ...` : ranges.join(', ');
+};
+
+export function CoverageCorpus({ initialDirectory = 'output' }: CoverageCorpusProps) {
+  const [directory, setDirectory] = useState(initialDirectory);
+  const [runs, setRuns] = useState<string[]>([]);
+  const [isLoading, setIsLoading] = useState(false);
+  const [error, setError] = useState<string | null>(null);
+
+  const [union, setUnion] = useState<{
+    runCount: number;
+    files: CoverageFileSummary[];
+    totalCompiledLines: number;
+    totalCoveredLines: number;
+    elapsedMs: number;
+  } | null>(null);
+
+  const [baseRun, setBaseRun] = useState('');
+  const [headRun, setHeadRun] = useState('');
+  const [diff, setDiff] = useState<CoverageDiffEntry[] | null>(null);
+
+  useEffect(() => {
+    listCoverageRuns(directory).then(result => {
+      if (result.success && result.runs) {
+        setRuns(result.runs);
+        setBaseRun(result.runs[0] || '');
+        setHeadRun(result.runs[1] || result.runs[0] || '');
+      }
+    });
+  }, [directory]);
+
+  const handleUnion = async () => {
+    setIsLoading(true);
+    setError(null);
+    try {
+      const result = await computeCoverageUnion(directory);
+      if (result.success && result.files) {
+        setUnion({
+          runCount: result.runCount || 0,
+          files: result.files,
+          totalCompiledLines: result.totalCompiledLines || 0,
+          totalCoveredLines: result.totalCoveredLines || 0,
+          elapsedMs: result.elapsedMs || 0
+        });
+      } else {
+        setError(result.error || 'Failed to compute coverage');
+      }
+    } finally {
+      setIsLoading(false);
+    }
+  };
+
+  const handleDiff = async () => {
+    if (!baseRun || !headRun) return;
+    setIsLoading(true);
+    setError(null);
+    try {
+      const result = await diffRunCoverage(baseRun, headRun);
+      if (result.success && result.files) {
+        setDiff(result.files);
+      } else {
+        setError(result.error || 'Failed to compare runs');
+      }
+    } finally {
+      setIsLoading(false);
+    }
+  };
+
+  const totalPercentage = union && union.totalCompiledLines > 0
+    ? (union.totalCoveredLines / union.totalCompiledLines) * 100
+    : 0;
+
+  return (
+    <div className="w-full max-w-4xl mx-auto space-y-6">
+      {/* Union */}
+      <div className="bg-white rounded-xl shadow-lg border border-gray-200">
+        <div className="flex items-center justify-between px-6 py-4 border-b border-gray-200">
+          <div className="flex items-center gap-3">
+            <Layers className="w-5 h-5 text-gray-600" />
+            <h3 className="text-lg font-semibold text-gray-800">Combined Coverage</h3>
+          </div>
+          <div className="flex items-center gap-2">
+            <input
+              type="text"
+              value={directory}
+              onChange={(e) => setDirectory(e.target.value)}
+              className="px-3 py-1.5 border border-gray-300 rounded-lg focus:outline-none focus:ring-2 focus:ring-blue-500 font-mono text-sm w-56"
+            />
+            <button
+              onClick={handleUnion}
+              disabled={isLoading}
+              className="px-4 py-1.5 bg-blue-500 text-white rounded-lg hover:bg-blue-600 transition-colors text-sm disabled:opacity-50"
+            >
+              Merge {runs.length} runs
+            </button>
+          </div>
+        </div>
+
+        {error && (
+          <div className="px-6 py-3 flex items-center gap-2 text-red-600 text-sm">
+            <AlertCircle className="w-4 h-4" />
+            {error}
+          </div>
+        )}
+
+        {union && (
+          <div className="p-6">
+            <div className="grid grid-cols-3 gap-4 mb-4">
+              <div className="bg-gray-50 rounded-lg p-4">
+                <div className="text-sm text-gray-600 mb-1">Runs</div>
+                <div className="text-2xl font-bold text-gray-800">{union.runCount.toLocaleString()}</div>
+              </div>
+              <div className="bg-gray-50 rounded-lg p-4">
+                <div className="text-sm text-gray-600 mb-1">Covered Lines</div>
+                <div className="text-2xl font-bold text-gray-800">
+                  {union.totalCoveredLines.toLocaleString()} / {union.totalCompiledLines.toLocaleString()}
+                </div>
+              </div>
+              <div className="bg-gray-50 rounded-lg p-4">
+                <div className="text-sm text-gray-600 mb-1">Coverage</div>
+                <div className={cn("text-2xl font-bold", getCoverageColor(totalPercentage))}>
+                  {formatPercentage(totalPercentage)}
+                </div>
+                <div className="text-xs text-gray-500 mt-1">merged in {union.elapsedMs.toLocaleString()} ms</div>
+              </div>
+            </div>
+
+            <div className="max-h-96 overflow-y-auto">
+              <table className="w-full">
+                <thead className="sticky top-0 bg-white">
+                  <tr className="border-b border-gray-200">
+                    <th className="text-left py-2 px-3 text-sm font-medium text-gray-700">File</th>
+                    <th className="text-right py-2 px-3 text-sm font-medium text-gray-700">Covered</th>
+                    <th className="text-right py-2 px-3 text-sm font-medium text-gray-700">Compiled</th>
+                    <th className="text-right py-2 px-3 text-sm font-medium text-gray-700">Coverage</th>
+                  </tr>
+                </thead>
+                <tbody>
+                  {union.files.map(file => (
+                    <tr key={file.file} className="border-b border-gray-100 hover:bg-gray-50">
+                      <td className="py-2 px-3 text-sm text-gray-800 font-mono truncate max-w-md" title={file.file}>
+                        {file.file}
+                      </td>
+                      <td className="py-2 px-3 text-sm text-right text-gray-800">{file.coveredLines.toLocaleString()}</td>
+                      <td className="py-2 px-3 text-sm text-right text-gray-600">{file.compiledLines.toLocaleString()}</td>
+                      <td className={cn("py-2 px-3 text-sm text-right font-medium", getCoverageColor(file.coveragePercentage))}>
+                        {formatPercentage(file.coveragePercentage)}
+                      </td>
+                    </tr>
+                  ))}
+                </tbody>
+              </table>
+            </div>
+          </div>
+        )}
+      </div>
+
+      {/* Diff */}
+      <div className="bg-white rounded-xl shadow-lg border border-gray-200">
+        <div className="flex items-center gap-3 px-6 py-4 border-b border-gray-200">
+          <GitCompare className="w-5 h-5 text-gray-600" />
+          <h3 className="text-lg font-semibold text-gray-800">Compare Runs</h3>
+        </div>
+        <div className="p-6">
+          <div className="flex items-center gap-2 mb-4">
+            <select
+              value={baseRun}
+              onChange={(e) => setBaseRun(e.target.value)}
+              className="flex-1 px-2 py-1.5 text-sm border border-gray-300 rounded font-mono"
+            >
+              {runs.map(run => <option key={run} value={run}>{run}</option>)}
+            </select>
+            <span className="text-sm text-gray-500">→</span>
+            <select
+              value={headRun}
+              onChange={(e) => setHeadRun(e.target.value)}
+              className="flex-1 px-2 py-1.5 text-sm border border-gray-300 rounded font-mono"
+            >
+              {runs.map(run => <option key={run} value={run}>{run}</option>)}
+            </select>
+            <button
+              onClick={handleDiff}
+              disabled={isLoading || !baseRun || !headRun}
+              className="px-4 py-1.5 bg-blue-500 text-white rounded-lg hover:bg-blue-600 transition-colors text-sm disabled:opacity-50"
+            >
+              Compare
+            </button>
+          </div>
+
+          {diff && (diff.length === 0 ? (
+            <p className="text-sm text-gray-500">Both runs cover exactly the same lines.</p>
+          ) : (
+            <div className="max-h-96 overflow-y-auto space-y-3">
+              {diff.map(entry => (
+                <div key={entry.file} className="border border-gray-100 rounded-lg p-3">
+                  <div className="font-mono text-sm text-gray-800 mb-1 truncate" title={entry.file}>{entry.file}</div>
+                  {entry.newlyCovered.length > 0 && (
+                    <div className="text-xs text-green-700">
+                      +{entry.newlyCovered.length} newly covered: {formatLineRanges(entry.newlyCovered)}
+                    </div>
+                  )}
+                  {entry.lost.length > 0 && (
+                    <div className="text-xs text-red-700">
+                      -{entry.lost.length} no longer covered: {formatLineRanges(entry.lost)}
+                    </div>
+                  )}
+                </div>
+              ))}
+            </div>
+          ))}
+        </div>
+      </div>
+
+      <ProfileCostDiff runs={runs} />
+
+      <TestImpactPanel directory={directory} />
+
+      <NeverExecutedPanel directory={directory} />
+    </div>
+  );
+}
@@ -1,13 +1,15 @@
 'use client';
 
 import React, { useState, useEffect, useRef, useCallback } from 'react';
-import { FileText, Code, Activity, Cpu, Zap, GitBranch, AlertCircle, Settings, Eye, Code2, Sun, Moon, AlignLeft, AlignRight, ChevronUp, ChevronDown } from 'lucide-react';
-import { FileCoverage, FunctionData } from '@/types/profiler';
+import { FileText, Code, Activity, Cpu, Zap, GitBranch, AlertCircle, Settings, Eye, Code2, Sun, Moon, AlignLeft, AlignRight, ChevronUp, ChevronDown, Workflow } from 'lucide-react';
+import { FileCoverage, FunctionData, ParseGranularity } from '@/types/profiler';
 import { formatPercentage, getCoverageColor, cn } from '@/lib/utils';
 import Prism from 'prismjs';
 import 'prismjs/components/prism-c';
 import 'prismjs/components/prism-cpp';
 import { AssemblyViewer } from './assembly-viewer';
+import { ControlFlowGraphView } from './control-flow-graph-view';
+import { CfgBlock } from '@/lib/control-flow-graph';
 
 // Custom CSS for unified dark theme code display
 const codeStyles = `
@@ -177,6 +179,9 @@ interface FileViewerProps {
   onSelectedEventsChange?: (events: string[]) => void;
   eventAlignLeft?: boolean;
   onEventAlignLeftChange?: (align: boolean) => void;
+  granularity?: ParseGranularity;
+  onLoadDetail?: (functionName: string) => Promise<void>;
+  focusLine?: number | null; // highlight and scroll to this line when opened
 }
 
 interface HotspotSettings {
@@ -192,7 +197,10 @@ export function FileViewer({
   selectedEvents: propsSelectedEvents,
   onSelectedEventsChange,
   eventAlignLeft: propsEventAlignLeft,
-  onEventAlignLeftChange
+  onEventAlignLeftChange,
+  granularity = 'instr',
+  onLoadDetail,
+  focusLine
 }: FileViewerProps) {
   // Handle missing or empty source code
   const sourceCode = fileData?.sourceCode || '';
@@ -206,7 +214,14 @@ export function FileViewer({
   
   // Get function data and line range
   const functionData = selectedFunction ? fileData.functions?.[selectedFunction] : null;
-  const functionLineNumbers = functionData ? Object.keys(functionData.lines || {}).map(Number).sort((a, b) => a - b) : [];
+  const functionLineNumbers = functionData
+    ? (Object.keys(functionData.lines || {}).length > 0
+        ? Object.keys(functionData.lines).map(Number)
+        : [...functionData.coveredLines, ...functionData.uncoveredLines] // parsed at function granularity
+      ).sort((a, b) => a - b)
+    : [];
+  const isDetailMissing = !!functionData && granularity !== 'instr' && !functionData.pcData;
+  const [isLoadingDetail, setIsLoadingDetail] = useState(false);
   const minLine = functionLineNumbers.length > 0 ? Math.min(...functionLineNumbers) : 1;
   const maxLine = functionLineNumbers.length > 0 ? Math.max(...functionLineNumbers) : allLines.length;
   
@@ -254,6 +269,7 @@ export function FileViewer({
   // State for highlighted lines
   const [highlightedCodeLine, setHighlightedCodeLine] = useState<number | null>(null);
   const [highlightedAssemblyPc, setHighlightedAssemblyPc] = useState<string | null>(null);
+  const [showControlFlowGraph, setShowControlFlowGraph] = useState(false);
   
   // State for theme
   const [isDarkTheme, setIsDarkTheme] = useState(false);
@@ -410,6 +426,23 @@ export function FileViewer({
     }
   }, [pcToLineMap]);
 
+  // Select the block's first instruction and bring it and its source line into view
+  const handleBlockClick = useCallback((block: CfgBlock) => {
+    handleAssemblyLineClick(block.startPc);
+    const lineNumber = pcToLineMap().get(block.startPc) ?? block.line;
+    if (lineNumber !== undefined) {
+      setHighlightedCodeLine(lineNumber);
+      document.getElementById(`source-line-${lineNumber}`)?.scrollIntoView({ block: 'center' });
+    }
+    document.getElementById(`asm-pc-${block.startPc}`)?.scrollIntoView({ block: 'center' });
+  }, [handleAssemblyLineClick, pcToLineMap]);
+
+  useEffect(() => {
+    if (!focusLine) return;
+    setHighlightedCodeLine(focusLine);
+    document.getElementById(`source-line-${focusLine}`)?.scrollIntoView({ block: 'center' });
+  }, [focusLine, filename, selectedFunction]);
+
   // Get language for syntax highlighting
   const getLanguage = (filename: string): string => {
     const ext = filename.split('.').pop()?.toLowerCase();
@@ -556,6 +589,23 @@ export function FileViewer({
                   <span className="text-sm font-medium">Call Tree</span>
                 </button>
               )}
+
+              {/* Control-flow graph toggle - needs the function's instructions and object file */}
+              {selectedFunction && functionData?.pcData && fileData.objectFile && (
+                <button
+                  onClick={() => setShowControlFlowGraph(!showControlFlowGraph)}
+                  className={cn(
+                    "flex items-center gap-1.5 px-3 py-2 rounded-md transition-colors",
+                    showControlFlowGraph
+                      ? "bg-blue-600 hover:bg-blue-700 text-white"
+                      : "bg-blue-100 hover:bg-blue-200 text-blue-700"
+                  )}
+                  title="Show the control-flow graph of this function"
+                >
+                  <Workflow className="w-4 h-4" />
+                  <span className="text-sm font-medium">CFG</span>
+                </button>
+              )}
               
               {/* Theme Toggle */}
               <button
@@ -663,6 +713,31 @@ export function FileViewer({
             <p className="text-sm text-gray-500 mb-2">{filename}</p>
           )}
           
+          {selectedFunction && isDetailMissing && !isHeaderCollapsed && (
+            <div className="flex items-center justify-between gap-3 mb-3 px-3 py-2 bg-amber-50 border border-amber-200 rounded-md text-sm text-amber-800">
+              <span>
+                Loaded at {granularity === 'function' ? 'function' : 'line'} granularity;
+                {granularity === 'function' ? ' line and instruction' : ' instruction'} costs were not kept.
+              </span>
+              {onLoadDetail && (
+                <button
+                  onClick={async () => {
+                    setIsLoadingDetail(true);
+                    try {
+                      await onLoadDetail(selectedFunction);
+                    } finally {
+                      setIsLoadingDetail(false);
+                    }
+                  }}
+                  disabled={isLoadingDetail}
+                  className="px-3 py-1 bg-amber-100 hover:bg-amber-200 rounded-md font-medium disabled:opacity-50 flex-shrink-0"
+                >
+                  {isLoadingDetail ? 'Loading...' : 'Load Detail'}
+                </button>
+              )}
+            </div>
+          )}
+          
           {!isHeaderCollapsed && (
             <>
           <div className="flex items-center gap-6 text-sm">
@@ -768,6 +843,21 @@ export function FileViewer({
         </div>
       </div>
 
+      {/* Control-flow graph of the selected function */}
+      {showControlFlowGraph && selectedFunction && functionData?.pcData && fileData.objectFile && (
+        <div className={cn("h-80 flex-shrink-0 border-b", isDarkTheme ? "border-gray-700" : "border-gray-200")}>
+          <ControlFlowGraphView
+            objectFile={fileData.objectFile}
+            pcData={functionData.pcData}
+            jumps={functionData.jumps}
+            availableEvents={availableEvents}
+            selectedPc={highlightedAssemblyPc}
+            onBlockClick={handleBlockClick}
+            isDarkTheme={isDarkTheme}
+          />
+        </div>
+      )}
+
       {/* Main content area with resizable split */}
       <div ref={splitContainerRef} className="flex-1 flex flex-col relative overflow-hidden">
         {hasSourceCode ? (
@@ -847,6 +937,7 @@ export function FileViewer({
                       return (
                         <tr
                           key={lineNumber}
+                          id={`source-line-${lineNumber}`}
                           onClick={() => handleCodeLineClick(lineNumber)}
                           className={cn(
                             "group cursor-pointer transition-all",
@@ -0,0 +1,139 @@
+'use client';
+
+import { useMemo, useState } from 'react';
+import { Flame } from 'lucide-react';
+import { CachegrindData } from '@/types/profiler';
+import { availableHotLineMetrics, findHotLines, groupHotLinesByFunction, HotLineEntry } from '@/lib/hot-lines';
+import { cn } from '@/lib/utils';
+
+interface HotLinesViewProps {
+  data: CachegrindData;
+  onViewCode?: (fileName: string, functionName: string, line?: number) => void;
+}
+
+const RANK_SIZES = [25, 50, 100, 250];
+
+export function HotLinesView({ data, onViewCode }: HotLinesViewProps) {
+  const metrics = useMemo(() => availableHotLineMetrics(data.events), [data.events]);
+  const [metricId, setMetricId] = useState(
+    data.events.includes('Cy') ? 'Cy' : (data.events.includes('Ir') ? 'Ir' : data.events[0])
+  );
+  const [rankSize, setRankSize] = useState(50);
+  const [groupByFunction, setGroupByFunction] = useState(false);
+
+  const metric = metrics.find(m => m.id === metricId) || metrics[0];
+  const entries = useMemo(
+    () => metric ? findHotLines(data, metric, rankSize) : [],
+    [data, metric, rankSize]
+  );
+  const groups = useMemo(() => groupHotLinesByFunction(entries), [entries]);
+
+  const total = metric ? metric.value(data.summaryTotals) : 0;
+  const share = (value: number) => total > 0 ? `${((value / total) * 100).toFixed(2)}%` : '-';
+
+  const snippet = (entry: HotLineEntry) => {
+    const source = data.fileCoverage[entry.file]?.sourceCode || '';
+    return (source.split('\n')[entry.line - 1] || '').trim();
+  };
+
+  const renderRow = (entry: HotLineEntry, rank: number) => (
+    <tr key={`${entry.file}:${entry.line}`} className="border-b border-gray-100 hover:bg-gray-50">
+      <td className="py-2 px-3 text-sm text-right text-gray-500">{rank}</td>
+      <td className="py-2 px-3 text-sm text-gray-800">
+        <button
+          onClick={() => onViewCode?.(entry.file, entry.functions[0], entry.line)}
+          className={cn("font-mono text-xs", onViewCode ? "hover:underline text-blue-700" : "cursor-default")}
+          title={entry.file}
+        >
+          {entry.file.split('/').pop() || entry.file}:{entry.line}
+        </button>
+        {!groupByFunction && entry.functions.length > 0 && (
+          <span className="ml-2 font-mono text-xs text-gray-500" title={entry.functions.join(', ')}>
+            {entry.functions[0]}{entry.functions.length > 1 ? ` +${entry.functions.length - 1}` : ''}
+          </span>
+        )}
+      </td>
+      <td className="py-2 px-3 text-xs text-gray-700 font-mono truncate max-w-md" title={snippet(entry)}>
+        {snippet(entry) || <span className="text-gray-400">source not available</span>}
+      </td>
+      <td className="py-2 px-3 text-sm text-right text-gray-800">{entry.value.toLocaleString()}</td>
+      <td className="py-2 px-3 text-sm text-right text-gray-600">{share(entry.value)}</td>
+    </tr>
+  );
+
+  const rankOf = new Map(entries.map((entry, index) => [entry, index + 1]));
+
+  return (
+    <div className="bg-white rounded-xl shadow-sm p-6 border border-gray-100">
+      <div className="flex items-center justify-between mb-4">
+        <div className="flex items-center gap-2">
+          <Flame className="w-5 h-5 text-red-600" />
+          <h3 className="text-lg font-semibold text-gray-800">Hottest Source Lines</h3>
+        </div>
+        <div className="flex items-center gap-3">
+          <select
+            value={metric?.id}
+            onChange={(e) => setMetricId(e.target.value)}
+            className="px-2 py-1 text-sm border border-gray-300 rounded focus:outline-none focus:ring-2 focus:ring-blue-500"
+          >
+            {metrics.map(m => <option key={m.id} value={m.id}>{m.label}</option>)}
+          </select>
+          <select
+            value={rankSize}
+            onChange={(e) => setRankSize(parseInt(e.target.value, 10))}
+            className="px-2 py-1 text-sm border border-gray-300 rounded focus:outline-none focus:ring-2 focus:ring-blue-500"
+          >
+            {RANK_SIZES.map(size => <option key={size} value={size}>Top {size}</option>)}
+          </select>
+          <label className="flex items-center gap-2 text-sm text-gray-600">
+            <input
+              type="checkbox"
+              checked={groupByFunction}
+              onChange={(e) => setGroupByFunction(e.target.checked)}
+              className="rounded"
+            />
+            Group by function
+          </label>
+        </div>
+      </div>
+
+      {entries.length === 0 ? (
+        <p className="text-sm text-gray-500">
+          {data.granularity === 'function'
+            ? 'This profile was loaded without line detail. Reload it at line granularity to rank source lines.'
+            : 'No source lines have cost for this event.'}
+        </p>
+      ) : (
+        <div className="overflow-x-auto max-h-[32rem] overflow-y-auto">
+          <table className="w-full">
+            <thead className="sticky top-0 bg-white">
+              <tr className="border-b border-gray-200">
+                <th className="text-right py-2 px-3 text-sm font-medium text-gray-700">#</th>
+                <th className="text-left py-2 px-3 text-sm font-medium text-gray-700">Line</th>
+                <th className="text-left py-2 px-3 text-sm font-medium text-gray-700">Source</th>
+                <th className="text-right py-2 px-3 text-sm font-medium text-gray-700">{metric?.id}</th>
+                <th className="text-right py-2 px-3 text-sm font-medium text-gray-700">Share</th>
+              </tr>
+            </thead>
+            <tbody>
+              {groupByFunction
+                ? groups.map(group => [
+                    <tr key={`${group.file}:${group.functionName}`} className="bg-gray-50 border-b border-gray-200">
+                      <td />
+                      <td colSpan={2} className="py-2 px-3 text-sm font-medium text-gray-800">
+                        <span className="font-mono text-xs">{group.functionName}</span>
+                        <span className="ml-2 text-xs text-gray-400">({group.file.split('/').pop() || group.file})</span>
+                      </td>
+                      <td className="py-2 px-3 text-sm text-right font-medium text-gray-800">{group.value.toLocaleString()}</td>
+                      <td className="py-2 px-3 text-sm text-right text-gray-600">{share(group.value)}</td>
+                    </tr>,
+                    ...group.lines.map(entry => renderRow(entry, rankOf.get(entry) || 0))
+                  ])
+                : entries.map((entry, index) => renderRow(entry, index + 1))}
+            </tbody>
+          </table>
+        </div>
+      )}
+    </div>
+  );
+}
@@ -0,0 +1,140 @@
+'use client';
+
+import { useMemo, useState } from 'react';
+import { Minimize2 } from 'lucide-react';
+import { CachegrindData } from '@/types/profiler';
+import { getAssemblyForFunction } from '@/app/actions/assembly';
+import { buildCallGraph } from '@/lib/call-graph';
+import { analyzeFrame, FrameOverhead, rankInlineCandidates } from '@/lib/inline-candidates';
+import { cn } from '@/lib/utils';
+
+interface InlineCandidatesViewProps {
+  data: CachegrindData;
+  onViewCode?: (fileName: string, functionName: string, line?: number) => void;
+}
+
+const MAX_SHOWN = 50;
+const MAX_DISASSEMBLED = 25;
+
+export function InlineCandidatesView({ data, onViewCode }: InlineCandidatesViewProps) {
+  // Savings are in instructions, so Ir is used whenever the profile has it
+  const event = data.events.includes('Ir') ? 'Ir' : (data.events.includes('Cy') ? 'Cy' : data.events[0]);
+  const graph = useMemo(() => buildCallGraph(data), [data]);
+  const [frames, setFrames] = useState<Map<string, FrameOverhead>>(new Map());
+  const [isDisassembling, setIsDisassembling] = useState(false);
+  const [disassemblyError, setDisassemblyError] = useState<string | null>(null);
+
+  const candidates = useMemo(() => rankInlineCandidates(graph, event, frames), [graph, event, frames]);
+  const total = data.summaryTotals[event] || 0;
+
+  // Disassemble the callees of the top candidates to count their prologue and epilogue
+  const handleDisassemble = async () => {
+    setIsDisassembling(true);
+    setDisassemblyError(null);
+    const objdumpCommand = localStorage.getItem('profiler-objdump-command') || 'objdump';
+    const callees = Array.from(new Set(candidates.map(candidate => candidate.callee)))
+      .filter(callee => !frames.has(callee.key) && callee.objectFile && callee.data?.pcData)
+      .slice(0, MAX_DISASSEMBLED);
+    const next = new Map(frames);
+    let failed = 0;
+    for (const callee of callees) {
+      const pcData = callee.data!.pcData!;
+      const pcs = Object.keys(pcData).map(pc => parseInt(pc, 16));
+      const assembly = await getAssemblyForFunction(callee.objectFile!, pcData, objdumpCommand);
+      if (assembly && assembly.instructions.length > 0) {
+        next.set(callee.key, analyzeFrame(assembly.instructions, Math.min(...pcs), Math.max(...pcs)));
+      } else {
+        failed++;
+      }
+    }
+    if (failed > 0) setDisassemblyError(`Could not disassemble ${failed} of ${callees.length} functions`);
+    setFrames(next);
+    setIsDisassembling(false);
+  };
+
+  const hasPcData = data.granularity === undefined || data.granularity === 'instr';
+  const totalSavings = candidates.reduce((sum, candidate) => sum + candidate.savings, 0);
+
+  return (
+    <div className="bg-white rounded-xl shadow-sm p-6 border border-gray-100">
+      <div className="flex items-center justify-between mb-4">
+        <div className="flex items-center gap-2">
+          <Minimize2 className="w-5 h-5 text-indigo-600" />
+          <h3 className="text-lg font-semibold text-gray-800">Inlining Candidates</h3>
+        </div>
+        <button
+          onClick={handleDisassemble}
+          disabled={isDisassembling || !hasPcData || candidates.length === 0}
+          className="px-3 py-1.5 bg-blue-500 text-white rounded-lg hover:bg-blue-600 transition-colors text-sm disabled:opacity-50"
+          title={hasPcData
+            ? 'Count prologue and epilogue instructions of the top callees with objdump'
+            : 'Needs a profile loaded at instruction granularity'}
+        >
+          {isDisassembling ? 'Disassembling...' : 'Refine with disassembly'}
+        </button>
+      </div>
+      <p className="text-xs text-gray-500 mb-3">
+        Calls into small functions, ranked by the {event} spent on call, return, prologue and epilogue.
+        Without disassembly only the call and return are counted.
+      </p>
+      {disassemblyError && <p className="text-xs text-amber-700 mb-2">{disassemblyError}</p>}
+
+      {candidates.length === 0 ? (
+        <p className="text-sm text-gray-500">No small application function is called more than once.</p>
+      ) : (
+        <div className="overflow-x-auto max-h-[32rem] overflow-y-auto">
+          <div className="text-sm text-gray-600 mb-2">
+            Up to {totalSavings.toLocaleString()} {event} ({total > 0 ? ((totalSavings / total) * 100).toFixed(2) : '0'}%) across {candidates.length.toLocaleString()} call sites
+          </div>
+          <table className="w-full">
+            <thead className="sticky top-0 bg-white">
+              <tr className="border-b border-gray-200">
+                <th className="text-left py-2 px-3 text-sm font-medium text-gray-700">Call</th>
+                <th className="text-right py-2 px-3 text-sm font-medium text-gray-700">Calls</th>
+                <th className="text-right py-2 px-3 text-sm font-medium text-gray-700" title="Callee self cost per call">Body/call</th>
+                <th className="text-right py-2 px-3 text-sm font-medium text-gray-700" title="Call + return + prologue + epilogue">Overhead/call</th>
+                <th className="text-right py-2 px-3 text-sm font-medium text-gray-700">Savings</th>
+                <th className="text-left py-2 px-3 text-sm font-medium text-gray-700">Suggest</th>
+              </tr>
+            </thead>
+            <tbody>
+              {candidates.slice(0, MAX_SHOWN).map(candidate => (
+                <tr key={`${candidate.caller.key}->${candidate.callee.key}`} className="border-b border-gray-100 hover:bg-gray-50">
+                  <td className="py-2 px-3 text-xs font-mono text-gray-800">
+                    <span className="text-gray-500">{candidate.caller.functionName} → </span>
+                    <button
+                      onClick={() => onViewCode?.(candidate.callee.file, candidate.callee.functionName, candidate.callee.data?.startLine)}
+                      className={cn(onViewCode ? "hover:underline text-blue-700" : "cursor-default")}
+                      title={candidate.callee.file}
+                    >
+                      {candidate.callee.functionName}
+                    </button>
+                  </td>
+                  <td className="py-2 px-3 text-sm text-right text-gray-800">{candidate.calls.toLocaleString()}</td>
+                  <td className="py-2 px-3 text-sm text-right text-gray-600">{candidate.bodyPerCall.toFixed(1)}</td>
+                  <td
+                    className="py-2 px-3 text-sm text-right text-gray-600"
+                    title={candidate.frame
+                      ? `call+ret 2, prologue ${candidate.frame.prologue}, epilogue ${candidate.frame.epilogue}`
+                      : 'call+ret only; not disassembled'}
+                  >
+                    {candidate.overheadPerCall}{!candidate.frame && <span className="text-gray-400">+</span>}
+                  </td>
+                  <td className="py-2 px-3 text-sm text-right font-medium text-gray-800">{candidate.savings.toLocaleString()}</td>
+                  <td className="py-2 px-3 text-xs">
+                    <span className={cn(
+                      "px-2 py-0.5 rounded",
+                      candidate.suggestion === 'always_inline' ? "bg-indigo-100 text-indigo-700" : "bg-gray-100 text-gray-700"
+                    )}>
+                      {candidate.suggestion}
+                    </span>
+                  </td>
+                </tr>
+              ))}
+            </tbody>
+          </table>
+        </div>
+      )}
+    </div>
+  );
+}
@@ -0,0 +1,168 @@
+'use client';
+
+import { useState } from 'react';
+import { Ban, AlertCircle } from 'lucide-react';
+import { findNeverExecutedCode } from '@/app/actions/coverage';
+import { NeverExecutedGroup, NeverExecutedReport } from '@/lib/never-executed';
+import { cn } from '@/lib/utils';
+
+interface NeverExecutedPanelProps {
+  directory: string;
+}
+
+type ReportView = 'functions' | 'files' | 'directories' | 'objects';
+
+const VIEWS: { id: ReportView; label: string }[] = [
+  { id: 'functions', label: 'Functions' },
+  { id: 'files', label: 'Files' },
+  { id: 'directories', label: 'Directories' },
+  { id: 'objects', label: 'Objects' }
+];
+
+const formatBytes = (bytes: number) => bytes >= 1024 ? `${(bytes / 1024).toFixed(1)} KB` : `${bytes} B`;
+
+export function NeverExecutedPanel({ directory }: NeverExecutedPanelProps) {
+  const [report, setReport] = useState<{
+    runCount: number;
+    report: NeverExecutedReport;
+    missingObjects: string[];
+    elapsedMs: number;
+  } | null>(null);
+  const [view, setView] = useState<ReportView>('files');
+  const [isLoading, setIsLoading] = useState(false);
+  const [error, setError] = useState<string | null>(null);
+
+  const handleScan = async () => {
+    setIsLoading(true);
+    setError(null);
+    try {
+      const objdumpCommand = localStorage.getItem('profiler-objdump-command') || 'objdump';
+      const result = await findNeverExecutedCode(directory, objdumpCommand);
+      if (result.success && result.report) {
+        setReport({
+          runCount: result.runCount || 0,
+          report: result.report,
+          missingObjects: result.missingObjects || [],
+          elapsedMs: result.elapsedMs || 0
+        });
+      } else {
+        setError(result.error || 'Failed to scan runs');
+      }
+    } finally {
+      setIsLoading(false);
+    }
+  };
+
+  const renderGroups = (groups: NeverExecutedGroup[], label: string) => (
+    <table className="w-full">
+      <thead className="sticky top-0 bg-white">
+        <tr className="border-b border-gray-200">
+          <th className="text-left py-2 px-3 text-sm font-medium text-gray-700">{label}</th>
+          <th className="text-right py-2 px-3 text-sm font-medium text-gray-700">Never executed</th>
+          <th className="text-right py-2 px-3 text-sm font-medium text-gray-700">Functions</th>
+          <th className="text-right py-2 px-3 text-sm font-medium text-gray-700">Of code</th>
+        </tr>
+      </thead>
+      <tbody>
+        {groups.map(group => (
+          <tr key={group.key} className="border-b border-gray-100 hover:bg-gray-50">
+            <td className="py-2 px-3 text-sm text-gray-800 font-mono truncate max-w-md" title={group.key}>{group.key}</td>
+            <td className="py-2 px-3 text-sm text-right text-gray-800">{formatBytes(group.neverBytes)}</td>
+            <td className="py-2 px-3 text-sm text-right text-gray-600">
+              {group.neverFunctions.toLocaleString()} / {group.totalFunctions.toLocaleString()}
+            </td>
+            <td className="py-2 px-3 text-sm text-right text-gray-600">
+              {group.totalBytes > 0 ? `${((group.neverBytes / group.totalBytes) * 100).toFixed(1)}%` : '-'}
+            </td>
+          </tr>
+        ))}
+      </tbody>
+    </table>
+  );
+
+  const totals = report?.report.objects.reduce(
+    (sum, group) => ({ never: sum.never + group.neverBytes, total: sum.total + group.totalBytes }),
+    { never: 0, total: 0 }
+  );
+
+  return (
+    <div className="bg-white rounded-xl shadow-lg border border-gray-200">
+      <div className="flex items-center justify-between px-6 py-4 border-b border-gray-200">
+        <div className="flex items-center gap-3">
+          <Ban className="w-5 h-5 text-gray-600" />
+          <h3 className="text-lg font-semibold text-gray-800">Never-Executed Code</h3>
+        </div>
+        <button
+          onClick={handleScan}
+          disabled={isLoading}
+          className="px-4 py-1.5 bg-blue-500 text-white rounded-lg hover:bg-blue-600 transition-colors text-sm disabled:opacity-50"
+        >
+          {isLoading ? 'Scanning...' : 'Scan runs'}
+        </button>
+      </div>
+
+      {error && (
+        <div className="px-6 py-3 flex items-center gap-2 text-red-600 text-sm">
+          <AlertCircle className="w-4 h-4" />
+          {error}
+        </div>
+      )}
+
+      {report && totals && (
+        <div className="p-6">
+          <div className="text-sm text-gray-600 mb-3">
+            {formatBytes(totals.never)} of {formatBytes(totals.total)} function code never ran in {report.runCount.toLocaleString()} runs
+            <span className="text-gray-400"> ({report.elapsedMs.toLocaleString()} ms)</span>
+          </div>
+          {report.missingObjects.length > 0 && (
+            <p className="text-xs text-amber-700 mb-3" title={report.missingObjects.join('\n')}>
+              {report.missingObjects.length} object files could not be read and are not included
+            </p>
+          )}
+
+          <div className="flex gap-1 mb-3">
+            {VIEWS.map(v => (
+              <button
+                key={v.id}
+                onClick={() => setView(v.id)}
+                className={cn(
+                  "px-3 py-1 text-sm rounded",
+                  view === v.id ? "bg-blue-500 text-white" : "bg-gray-100 text-gray-700 hover:bg-gray-200"
+                )}
+              >
+                {v.label}
+              </button>
+            ))}
+          </div>
+
+          <div className="max-h-96 overflow-y-auto">
+            {view === 'functions' ? (
+              <table className="w-full">
+                <thead className="sticky top-0 bg-white">
+                  <tr className="border-b border-gray-200">
+                    <th className="text-left py-2 px-3 text-sm font-medium text-gray-700">Function</th>
+                    <th className="text-left py-2 px-3 text-sm font-medium text-gray-700">Location</th>
+                    <th className="text-right py-2 px-3 text-sm font-medium text-gray-700">Size</th>
+                  </tr>
+                </thead>
+                <tbody>
+                  {report.report.functions.map(fn => (
+                    <tr key={`${fn.objectFile}:${fn.address}`} className="border-b border-gray-100 hover:bg-gray-50">
+                      <td className="py-2 px-3 text-xs text-gray-800 font-mono truncate max-w-xs" title={fn.name}>{fn.name}</td>
+                      <td className="py-2 px-3 text-xs text-gray-500 font-mono truncate max-w-xs" title={fn.file || fn.objectFile}>
+                        {fn.file ? `${fn.file.split('/').pop()}:${fn.line}` : `${fn.objectFile.split('/').pop()} ${fn.address}`}
+                      </td>
+                      <td className="py-2 px-3 text-sm text-right text-gray-800">{formatBytes(fn.size)}</td>
+                    </tr>
+                  ))}
+                </tbody>
+              </table>
+            ) : view === 'files' ? renderGroups(report.report.files, 'File')
+              : view === 'directories' ? renderGroups(report.report.directories, 'Directory')
+              : renderGroups(report.report.objects, 'Object')}
+          </div>
+        </div>
+      )}
+    </div>
+  );
+}
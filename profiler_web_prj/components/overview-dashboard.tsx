@@ -1,24 +1,64 @@
 'use client';
 
-import { Activity, FileText, Code, TrendingUp, Cpu, Zap, HardDrive } from 'lucide-react';
+import { useState } from 'react';
+import { Activity, Download, FileText, Code, TrendingUp, Cpu, Zap, HardDrive } from 'lucide-react';
 import { CachegrindData } from '@/types/profiler';
 import { formatPercentage, getCoverageColor, cn } from '@/lib/utils';
+import { hasSyscallEvents } from '@/lib/syscall-analysis';
+import { SyscallView } from './syscall-view';
+import { HotLinesView } from './hot-lines-view';
+import { CostTreemap } from './cost-treemap';
+import { SourceSearch } from './source-search';
+import { InlineCandidatesView } from './inline-candidates-view';
+import { CallSitesView } from './call-sites-view';
+import { ColdRegionsView } from './cold-regions-view';
+import { WhatIfView } from './what-if-view';
+import { RuntimeFamiliesView } from './runtime-families-view';
 
 interface OverviewDashboardProps {
   data: CachegrindData;
+  sourceScope?: string | null; // source search scope of this profile, once indexing is queued
+  onViewCode?: (fileName: string, functionName: string, line?: number) => void;
+  onExportReport?: () => Promise<void>;
 }
 
-export function OverviewDashboard({ data }: OverviewDashboardProps) {
+export function OverviewDashboard({ data, sourceScope, onViewCode, onExportReport }: OverviewDashboardProps) {
+  const [isExporting, setIsExporting] = useState(false);
   // Calculate cache efficiency metrics
   const cacheMetrics = calculateCacheMetrics(data.summaryTotals);
+
+  const handleExportReport = async () => {
+    if (!onExportReport) return;
+    setIsExporting(true);
+    try {
+      await onExportReport();
+    } catch (error) {
+      console.error('Failed to export report:', error);
+    } finally {
+      setIsExporting(false);
+    }
+  };
   
   return (
     <div className="p-8 overflow-y-auto h-full bg-gray-50">
       <div className="max-w-7xl mx-auto">
         {/* Header */}
-        <div className="mb-8">
-          <h2 className="text-3xl font-bold text-gray-800 mb-2">Performance Analysis Dashboard</h2>
-          <p className="text-gray-600">{data.projectName}</p>
+        <div className="mb-8 flex items-start justify-between">
+          <div>
+            <h2 className="text-3xl font-bold text-gray-800 mb-2">Performance Analysis Dashboard</h2>
+            <p className="text-gray-600">{data.projectName}</p>
+          </div>
+          {onExportReport && (
+            <button
+              onClick={handleExportReport}
+              disabled={isExporting}
+              className="flex items-center gap-2 px-4 py-2 bg-white text-gray-700 border border-gray-300 rounded-lg hover:bg-gray-50 transition-colors text-sm disabled:opacity-50"
+              title="Download a standalone HTML report that opens without the viewer"
+            >
+              <Download className="w-4 h-4" />
+              {isExporting ? 'Exporting...' : 'Export Report'}
+            </button>
+          )}
         </div>
 
         {/* Performance Events Summary */}
@@ -95,6 +135,53 @@ export function OverviewDashboard({ data }: OverviewDashboardProps) {
           </div>
         </div>
 
+        {/* Cost by object, directory, file and function */}
+        <div className="mb-8">
+          <CostTreemap data={data} onViewCode={onViewCode} />
+        </div>
+
+        {/* Hottest lines across all files */}
+        <div className="mb-8">
+          <HotLinesView data={data} onViewCode={onViewCode} />
+        </div>
+
+        {/* Source text search ranked by line cost */}
+        <div className="mb-8">
+          <SourceSearch data={data} scope={sourceScope} onViewCode={onViewCode} />
+        </div>
+
+        {/* Call edges whose call overhead inlining would remove */}
+        <div className="mb-8">
+          <InlineCandidatesView data={data} onViewCode={onViewCode} />
+        </div>
+
+        {/* Projected effect of speeding up chosen functions */}
+        <div className="mb-8">
+          <WhatIfView data={data} onViewCode={onViewCode} />
+        </div>
+
+        {/* Call sites that reach several functions */}
+        <div className="mb-8">
+          <CallSitesView data={data} onViewCode={onViewCode} />
+        </div>
+
+        {/* Allocator, locking and string cost charged to application callers */}
+        <div className="mb-8">
+          <RuntimeFamiliesView data={data} onViewCode={onViewCode} />
+        </div>
+
+        {/* Never-executed code inside hot functions */}
+        <div className="mb-8">
+          <ColdRegionsView data={data} onViewCode={onViewCode} />
+        </div>
+
+        {/* System Calls (--collect-systime) */}
+        {hasSyscallEvents(data) && (
+          <div className="mb-8">
+            <SyscallView data={data} onViewCode={onViewCode} />
+          </div>
+        )}
+
         {/* Code Coverage */}
         <div className="bg-white rounded-xl shadow-sm p-6 border border-gray-100">
           <div className="flex items-center gap-2 mb-4">
@@ -213,7 +300,9 @@ function getEventDescription(event: string): string {
     'Bc': 'Conditional Branches',
     'Bcm': 'Conditional Branch Misses',
     'Bi': 'Indirect Branches',
-    'Bim': 'Indirect Branch Misses'
+    'Bim': 'Indirect Branch Misses',
+    'sysCount': 'System Calls',
+    'sysTime': 'System Call Time'
   };
   return descriptions[event] || event;
 }
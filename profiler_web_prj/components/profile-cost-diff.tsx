@@ -0,0 +1,200 @@
+'use client';
+
+import { useEffect, useState } from 'react';
+import { TrendingUp, AlertCircle } from 'lucide-react';
+import { compareProfileLines } from '@/app/actions/profile-diff';
+import { listSrcSubdirectories } from '@/app/actions/source-files';
+import { FileCostDelta } from '@/lib/profile-diff';
+import { availableSrcSubdirectories } from '@/lib/src-directories';
+import { cn } from '@/lib/utils';
+import { AssemblyDiffView } from './assembly-diff-view';
+
+interface ProfileCostDiffProps {
+  runs: string[];
+}
+
+const MAX_LINES_PER_FILE = 50;
+
+const formatDelta = (delta: number) => `${delta > 0 ? '+' : ''}${delta.toLocaleString()}`;
+
+export function ProfileCostDiff({ runs }: ProfileCostDiffProps) {
+  const [baseRun, setBaseRun] = useState('');
+  const [headRun, setHeadRun] = useState('');
+  const [baseSrc, setBaseSrc] = useState('');
+  const [headSrc, setHeadSrc] = useState('');
+  const [event, setEvent] = useState('');
+  const [events, setEvents] = useState<string[]>([]);
+  const [files, setFiles] = useState<FileCostDelta[] | null>(null);
+  const [isLoading, setIsLoading] = useState(false);
+  const [error, setError] = useState<string | null>(null);
+  const [srcSubdirs, setSrcSubdirs] = useState<string[]>(availableSrcSubdirectories);
+
+  useEffect(() => {
+    setBaseRun(runs[0] || '');
+    setHeadRun(runs[1] || runs[0] || '');
+  }, [runs]);
+
+  // Offer every directory under src/, e.g. src/v1 and src/v2 for two checkouts
+  useEffect(() => {
+    listSrcSubdirectories().then(found => {
+      setSrcSubdirs(Array.from(new Set([...availableSrcSubdirectories, ...found])).sort());
+    });
+  }, []);
+
+  const handleCompare = async (costEvent: string = event) => {
+    if (!baseRun || !headRun) return;
+    setIsLoading(true);
+    setError(null);
+    try {
+      const trimSlashes = (subdir: string) => subdir.trim().replace(/^\/+|\/+$/g, '');
+      const result = await compareProfileLines(baseRun, headRun, trimSlashes(baseSrc), trimSlashes(headSrc), costEvent || undefined);
+      if (result.success && result.files) {
+        setFiles(result.files);
+        setEvents(result.events || []);
+        setEvent(result.event || '');
+      } else {
+        setError(result.error || 'Failed to compare profiles');
+      }
+    } finally {
+      setIsLoading(false);
+    }
+  };
+
+  // Free text with the discovered directories as suggestions, relative to src/
+  const srcSelect = (value: string, onChange: (value: string) => void) => (
+    <div className="flex items-center border border-gray-300 rounded font-mono text-sm">
+      <span className="pl-2 text-gray-500">src/</span>
+      <input
+        type="text"
+        list="profile-diff-src-subdirs"
+        value={value}
+        onChange={(e) => onChange(e.target.value)}
+        placeholder="(root)"
+        className="flex-1 min-w-0 px-1 py-1.5 rounded focus:outline-none"
+        title="Source directory for this run"
+      />
+    </div>
+  );
+
+  return (
+    <div className="bg-white rounded-xl shadow-lg border border-gray-200">
+      <div className="flex items-center justify-between px-6 py-4 border-b border-gray-200">
+        <div className="flex items-center gap-3">
+          <TrendingUp className="w-5 h-5 text-gray-600" />
+          <h3 className="text-lg font-semibold text-gray-800">Line Cost Regressions</h3>
+        </div>
+        {events.length > 0 && (
+          <select
+            value={event}
+            onChange={(e) => handleCompare(e.target.value)}
+            disabled={isLoading}
+            className="px-2 py-1 text-sm border border-gray-300 rounded focus:outline-none focus:ring-2 focus:ring-blue-500"
+          >
+            {events.map(e => <option key={e} value={e}>{e}</option>)}
+          </select>
+        )}
+      </div>
+      <div className="p-6">
+        <div className="grid grid-cols-[1fr_auto_1fr] items-center gap-2 mb-2">
+          <select
+            value={baseRun}
+            onChange={(e) => setBaseRun(e.target.value)}
+            className="px-2 py-1.5 text-sm border border-gray-300 rounded font-mono"
+          >
+            {runs.map(run => <option key={run} value={run}>{run}</option>)}
+          </select>
+          <span className="text-sm text-gray-500">→</span>
+          <select
+            value={headRun}
+            onChange={(e) => setHeadRun(e.target.value)}
+            className="px-2 py-1.5 text-sm border border-gray-300 rounded font-mono"
+          >
+            {runs.map(run => <option key={run} value={run}>{run}</option>)}
+          </select>
+          {srcSelect(baseSrc, setBaseSrc)}
+          <span />
+          {srcSelect(headSrc, setHeadSrc)}
+          <datalist id="profile-diff-src-subdirs">
+            {srcSubdirs.map(subdir => <option key={subdir} value={subdir} />)}
+          </datalist>
+        </div>
+        <div className="flex items-center justify-between mb-4">
+          <p className="text-xs text-gray-500">
+            Lines are matched across source versions before costs are compared.
+          </p>
+          <button
+            onClick={() => handleCompare()}
+            disabled={isLoading || !baseRun || !headRun}
+            className="px-4 py-1.5 bg-blue-500 text-white rounded-lg hover:bg-blue-600 transition-colors text-sm disabled:opacity-50"
+          >
+            {isLoading ? 'Comparing...' : 'Compare'}
+          </button>
+        </div>
+
+        {error && (
+          <div className="flex items-center gap-2 text-red-600 text-sm mb-4">
+            <AlertCircle className="w-4 h-4" />
+            {error}
+          </div>
+        )}
+
+        {files && (files.length === 0 ? (
+          <p className="text-sm text-gray-500">No line changed {event} cost between the two runs.</p>
+        ) : (
+          <div className="max-h-[32rem] overflow-y-auto space-y-3">
+            {files.map(file => (
+              <div key={file.file} className="border border-gray-100 rounded-lg p-3">
+                <div className="flex items-center justify-between gap-2 mb-2">
+                  <span className="font-mono text-sm text-gray-800 truncate" title={file.file}>{file.file}</span>
+                  <div className="flex items-center gap-2 flex-shrink-0">
+                    {!file.aligned && (
+                      <span
+                        className="px-2 py-0.5 text-xs rounded bg-amber-100 text-amber-700"
+                        title="Source missing for one of the runs; line numbers were compared as-is"
+                      >
+                        unaligned
+                      </span>
+                    )}
+                    <span className={cn("text-sm font-medium", file.delta > 0 ? "text-red-600" : "text-green-600")}>
+                      {formatDelta(file.delta)}
+                    </span>
+                  </div>
+                </div>
+                <table className="w-full">
+                  <tbody>
+                    {file.lines.slice(0, MAX_LINES_PER_FILE).map(line => (
+                      <tr key={`${line.baseLine}:${line.headLine}`} className="border-t border-gray-50">
+                        <td className="py-1 pr-3 text-xs text-gray-500 font-mono whitespace-nowrap">
+                          {line.baseLine ?? '-'} → {line.headLine ?? '-'}
+                        </td>
+                        <td className="py-1 pr-3 text-xs text-gray-700 font-mono truncate max-w-md" title={line.text}>
+                          {line.text}
+                        </td>
+                        <td className="py-1 pr-3 text-xs text-right text-gray-500 whitespace-nowrap">
+                          {line.base.toLocaleString()} → {line.head.toLocaleString()}
+                        </td>
+                        <td className={cn(
+                          "py-1 text-xs text-right font-medium whitespace-nowrap",
+                          line.delta > 0 ? "text-red-600" : "text-green-600"
+                        )}>
+                          {formatDelta(line.delta)}
+                        </td>
+                      </tr>
+                    ))}
+                  </tbody>
+                </table>
+                {file.lines.length > MAX_LINES_PER_FILE && (
+                  <div className="text-xs text-gray-500 mt-1">
+                    {(file.lines.length - MAX_LINES_PER_FILE).toLocaleString()} more changed lines
+                  </div>
+                )}
+              </div>
+            ))}
+          </div>
+        ))}
+
+        <AssemblyDiffView baseRun={baseRun} headRun={headRun} />
+      </div>
+    </div>
+  );
+}
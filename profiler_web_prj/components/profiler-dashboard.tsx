@@ -1,7 +1,16 @@
 'use client';
 
-import { useState, useRef, useEffect, useCallback } from 'react';
-import { CachegrindData } from '@/types/profiler';
+import { useState, useRef, useEffect, useCallback, useMemo } from 'react';
+import { CachegrindData, FileCoverage, FunctionData } from '@/types/profiler';
+import { loadFunctionDetail } from '@/app/actions/profiler';
+import { exportCallGraph } from '@/app/actions/call-graph-export';
+import { indexProfileSources } from '@/app/actions/source-search';
+import { buildCallGraph } from '@/lib/call-graph';
+import { DotClusterBy, generateDot } from '@/lib/dot-export';
+import { collapseFrames, loadCollapseRules, DEFAULT_COLLAPSE_RULES, FrameCollapseRules } from '@/lib/frame-collapse';
+import { foldRecursion } from '@/lib/recursion-fold';
+import { GraphPruner, loadPruneThresholds, DEFAULT_PRUNE_THRESHOLDS, PruneThresholds } from '@/lib/graph-prune';
+import { buildStaticReport } from '@/lib/static-report';
 import { Sidebar } from './sidebar';
 import { MemoizedFileViewer as FileViewer } from './file-viewer';
 import { OverviewDashboard } from './overview-dashboard';
@@ -18,6 +27,7 @@ export function ProfilerDashboard({ data, onReset }: ProfilerDashboardProps) {
   const [showCallTree, setShowCallTree] = useState(false);
   const [callTreeEntryPoint, setCallTreeEntryPoint] = useState<string | null>(null);
   const [callTreeSelectedFunction, setCallTreeSelectedFunction] = useState<string | null>(null);
+  const [focusLine, setFocusLine] = useState<number | null>(null);
   const [sidebarWidth, setSidebarWidth] = useState(320); // Default width
   const sidebarRef = useRef<HTMLDivElement>(null);
   const isResizing = useRef(false);
@@ -25,9 +35,117 @@ export function ProfilerDashboard({ data, onReset }: ProfilerDashboardProps) {
   // File viewer state to persist
   const [selectedEvents, setSelectedEvents] = useState<string[]>([]);
   const [eventAlignLeft, setEventAlignLeft] = useState(false);
+  
+  // Call graph transforms are applied once here so the sidebar, call tree and
+  // flow chart all work on the same simplified call graph
+  const [collapseRules, setCollapseRules] = useState<FrameCollapseRules>(DEFAULT_COLLAPSE_RULES);
+  const [recursionFolded, setRecursionFolded] = useState(false);
+  const [pruneThresholds, setPruneThresholds] = useState<PruneThresholds>(DEFAULT_PRUNE_THRESHOLDS);
+  useEffect(() => {
+    setCollapseRules(loadCollapseRules());
+    setRecursionFolded(localStorage.getItem('profiler-fold-recursion') === 'true');
+    setPruneThresholds(loadPruneThresholds());
+  }, []);
+  // Index the profile's source files on the server for source search; this returns once queued
+  const [sourceScope, setSourceScope] = useState<string | null>(null);
+  useEffect(() => {
+    let srcSubdirs = [''];
+    try {
+      const saved = JSON.parse(localStorage.getItem('profiler-src-subdirs') || '[""]');
+      if (Array.isArray(saved)) srcSubdirs = saved;
+    } catch {
+      // Use the src/ root
+    }
+    setSourceScope(null);
+    indexProfileSources(srcSubdirs, Object.keys(data.fileCoverage)).then(result => {
+      if (result.success && result.scope) setSourceScope(result.scope);
+      else console.error('Failed to index source files:', result.error);
+    });
+  }, [data]);
+
+  const collapsedData = useMemo(() => collapseFrames(data, collapseRules), [data, collapseRules]);
+  const foldedData = useMemo(
+    () => recursionFolded ? foldRecursion(collapsedData) : collapsedData,
+    [collapsedData, recursionFolded]
+  );
+  // The pruner keeps its state between threshold changes, so it lives as long as its input
+  const pruner = useMemo(() => new GraphPruner(foldedData), [foldedData]);
+  const graphData = useMemo(() => pruner.prune(pruneThresholds), [pruner, pruneThresholds]);
+
+  // Line/instruction detail loaded on demand when the profile was parsed at a coarser granularity
+  const [functionDetails, setFunctionDetails] = useState<Record<string, FunctionData>>({});
+  const handleLoadDetail = useCallback(async (fileName: string, functionName: string) => {
+    if (!data.sourceDump) return;
+    const result = await loadFunctionDetail(data.sourceDump, fileName, functionName);
+    if (result.success && result.functionData) {
+      setFunctionDetails(prev => ({ ...prev, [`${fileName}:${functionName}`]: result.functionData! }));
+    } else {
+      console.error('Failed to load function detail:', result.error);
+    }
+  }, [data.sourceDump]);
+  const viewerFileData = useMemo((): FileCoverage | null => {
+    const fileData = selectedFile ? data.fileCoverage[selectedFile] : null;
+    if (!fileData) return null;
+    const overrides = Object.entries(functionDetails).filter(([key]) => key.startsWith(`${selectedFile}:`));
+    if (overrides.length === 0) return fileData;
+    const functions = { ...fileData.functions };
+    overrides.forEach(([key, detail]) => {
+      functions[key.substring(selectedFile!.length + 1)] = detail;
+    });
+    return { ...fileData, functions };
+  }, [data, selectedFile, functionDetails]);
+
+  // Dumps from output/ are exported on the server, which also writes the files and can run graphviz.
+  // Uploaded profiles are exported from the graph already in memory.
+  const handleExportGraph = useCallback(async (format: 'dot' | 'svg', clusterBy: DotClusterBy) => {
+    const baseName = (data.sourceDump || 'callgraph').split('/').pop();
+    let content: string;
+    if (data.sourceDump) {
+      const result = await exportCallGraph(data.sourceDump, {
+        format,
+        clusterBy,
+        collapseRules,
+        foldRecursion: recursionFolded,
+        pruneThresholds
+      });
+      if (!result.success || result.content === undefined) {
+        console.error('Failed to export call graph:', result.error);
+        return;
+      }
+      content = result.content;
+    } else {
+      content = Array.from(generateDot(buildCallGraph(graphData), graphData.events, { clusterBy, title: baseName })).join('');
+    }
+
+    const blob = new Blob([content], { type: format === 'svg' ? 'image/svg+xml' : 'text/vnd.graphviz' });
+    const url = URL.createObjectURL(blob);
+    const link = document.createElement('a');
+    link.href = url;
+    link.download = `${baseName}.${format}`;
+    link.click();
+    URL.revokeObjectURL(url);
+  }, [data.sourceDump, collapseRules, recursionFolded, pruneThresholds, graphData]);
+
+  // The report is built from what is in memory, with the current transforms applied to its call tree
+  const handleExportReport = useCallback(async () => {
+    const baseName = (data.sourceDump || 'profile').split('/').pop();
+    const html = await buildStaticReport(data, graphData);
+    const url = URL.createObjectURL(new Blob([html], { type: 'text/html' }));
+    const link = document.createElement('a');
+    link.href = url;
+    link.download = `${baseName}-report.html`;
+    link.click();
+    URL.revokeObjectURL(url);
+  }, [data, graphData]);
+
+  const handleRecursionFoldedChange = useCallback((folded: boolean) => {
+    setRecursionFolded(folded);
+    localStorage.setItem('profiler-fold-recursion', folded.toString());
+  }, []);
 
   const handleFunctionSelect = useCallback((funcName: string | null, fileName: string | null) => {
     setSelectedFunction(funcName);
+    setFocusLine(null);
     if (fileName) {
       setSelectedFile(fileName);
     }
@@ -80,17 +198,22 @@ export function ProfilerDashboard({ data, onReset }: ProfilerDashboardProps) {
     <div className="h-screen flex bg-gray-100">
       <div ref={sidebarRef} style={{ width: `${sidebarWidth}px` }} className="relative flex-shrink-0">
         <Sidebar 
-          data={data}
+          data={graphData}
           selectedFile={selectedFile}
           selectedFunction={selectedFunction}
           onFileSelect={(file) => {
             setSelectedFile(file);
+            setFocusLine(null);
             setShowCallTree(false);
           }}
           onFunctionSelect={handleFunctionSelect}
           onReset={onReset}
           onCallTreeView={handleCallTreeView}
           isCallTreeActive={showCallTree}
+          onSettingsSaved={() => {
+            setCollapseRules(loadCollapseRules());
+            setPruneThresholds(loadPruneThresholds());
+          }}
         />
         {/* Resize handle */}
         <div 
@@ -102,7 +225,11 @@ export function ProfilerDashboard({ data, onReset }: ProfilerDashboardProps) {
       <div className="flex-1 overflow-hidden">
         {showCallTree ? (
           <CallTreeViewer 
-            data={data} 
+            data={graphData} 
+            recursionFolded={recursionFolded}
+            onRecursionFoldedChange={handleRecursionFoldedChange}
+            onExportGraph={handleExportGraph}
+            canExportSvg={!!data.sourceDump}
             entryPoint={callTreeEntryPoint || callTreeSelectedFunction}
             onViewCode={(fileName, functionName) => {
               setSelectedFile(fileName);
@@ -110,10 +237,13 @@ export function ProfilerDashboard({ data, onReset }: ProfilerDashboardProps) {
               setShowCallTree(false);
             }}
           />
-        ) : selectedFile && data.fileCoverage[selectedFile] ? (
+        ) : selectedFile && viewerFileData ? (
           <FileViewer 
             filename={selectedFile}
-            fileData={data.fileCoverage[selectedFile]}
+            fileData={viewerFileData}
+            granularity={data.granularity}
+            onLoadDetail={data.sourceDump ? (functionName) => handleLoadDetail(selectedFile, functionName) : undefined}
+            focusLine={focusLine}
             selectedFunction={selectedFunction}
             onCallTreeView={handleCallTreeWithEntry}
             selectedEvents={selectedEvents}
@@ -126,7 +256,16 @@ export function ProfilerDashboard({ data, onReset }: ProfilerDashboardProps) {
             <p className="text-gray-500">File data not available</p>
           </div>
         ) : (
-          <OverviewDashboard data={data} />
+          <OverviewDashboard
+            data={data}
+            sourceScope={sourceScope}
+            onExportReport={handleExportReport}
+            onViewCode={(fileName, functionName, line) => {
+              setSelectedFile(fileName);
+              setSelectedFunction(functionName);
+              setFocusLine(line ?? null);
+            }}
+          />
         )}
       </div>
     </div>
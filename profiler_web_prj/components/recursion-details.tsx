@@ -0,0 +1,70 @@
+'use client';
+
+import { Repeat } from 'lucide-react';
+import { RecursionInfo } from '@/types/profiler';
+
+interface RecursionDetailsProps {
+  recursion: RecursionInfo;
+  metricName: string;
+}
+
+export function RecursionDetails({ recursion, metricName }: RecursionDetailsProps) {
+  const costOf = (totals: Record<string, number>) => totals.Cy || totals.Ir || 0;
+  const levels = recursion.depthTotals.map(costOf);
+  const totalCost = levels.reduce((sum, value) => sum + value, 0);
+  const maxCost = Math.max(...levels, 1);
+
+  return (
+    <div className="border rounded-lg p-4 bg-purple-50">
+      <h4 className="font-semibold text-purple-900 mb-3 flex items-center gap-2">
+        <Repeat size={16} />
+        Recursion
+      </h4>
+      <div className="space-y-2 text-sm">
+        <div><span className="font-medium">Entries:</span> {recursion.entries.toLocaleString()}</div>
+        <div><span className="font-medium">Recursive Calls Folded:</span> {recursion.reentries.toLocaleString()}</div>
+        {recursion.entries > 0 && (
+          <div>
+            <span className="font-medium">Avg. Depth:</span>{' '}
+            {((recursion.entries + recursion.reentries) / recursion.entries).toFixed(1)}
+          </div>
+        )}
+        {recursion.cycle && recursion.cycle.length > 0 && (
+          <div>
+            <span className="font-medium">Cycle With:</span>{' '}
+            <span className="font-mono text-xs">{recursion.cycle.join(', ')}</span>
+          </div>
+        )}
+      </div>
+
+      {levels.length > 1 ? (
+        <div className="mt-3">
+          <div className="text-xs font-medium text-gray-700 mb-2">Self {metricName} by depth</div>
+          <div className="space-y-1">
+            {levels.map((value, depth) => (
+              <div key={depth} className="flex items-center gap-2 text-xs">
+                <span className="w-8 text-right text-gray-600">
+                  {depth === levels.length - 1 ? '≥' : ''}{depth + 1}
+                </span>
+                <div className="flex-1 bg-white rounded h-3 overflow-hidden">
+                  <div
+                    className="bg-purple-400 h-3"
+                    style={{ width: `${(value / maxCost) * 100}%` }}
+                  />
+                </div>
+                <span className="w-24 text-right text-gray-700">
+                  {value.toLocaleString()}
+                  {totalCost > 0 && <span className="text-gray-400"> ({((value / totalCost) * 100).toFixed(0)}%)</span>}
+                </span>
+              </div>
+            ))}
+          </div>
+        </div>
+      ) : (
+        <p className="mt-3 text-xs text-gray-500">
+          Profile with --separate-recs=N to get a per-depth breakdown.
+        </p>
+      )}
+    </div>
+  );
+}
@@ -0,0 +1,190 @@
+'use client';
+
+import { useEffect, useMemo, useState } from 'react';
+import { Layers, Settings } from 'lucide-react';
+import { CachegrindData } from '@/types/profiler';
+import { buildCallGraph } from '@/lib/call-graph';
+import {
+  analyzeRuntimeFamilies,
+  DEFAULT_RUNTIME_FAMILIES,
+  loadRuntimeFamilies,
+  RuntimeFamily,
+  saveRuntimeFamilies
+} from '@/lib/runtime-families';
+import { cn } from '@/lib/utils';
+
+interface RuntimeFamiliesViewProps {
+  data: CachegrindData;
+  onViewCode?: (fileName: string, functionName: string, line?: number) => void;
+}
+
+const MAX_SHOWN = 50;
+
+// One family per line: "Name: pattern, pattern", with "(allocator)" after the name for allocators
+const formatFamilies = (families: RuntimeFamily[]) =>
+  families.map(f => `${f.name}${f.allocator ? ' (allocator)' : ''}: ${f.patterns.join(', ')}`).join('\n');
+
+const parseFamilies = (text: string): RuntimeFamily[] => text.split('\n').flatMap(line => {
+  const match = line.match(/^\s*(.+?)(\s*\(allocator\))?\s*:\s*(.*)$/);
+  if (!match) return [];
+  const patterns = match[3].split(',').map(p => p.trim()).filter(Boolean);
+  return patterns.length > 0 ? [{ name: match[1], patterns, ...(match[2] ? { allocator: true } : {}) }] : [];
+});
+
+export function RuntimeFamiliesView({ data, onViewCode }: RuntimeFamiliesViewProps) {
+  const event = data.events.includes('Cy') ? 'Cy' : (data.events.includes('Ir') ? 'Ir' : data.events[0]);
+  const graph = useMemo(() => buildCallGraph(data), [data]);
+  const [families, setFamilies] = useState<RuntimeFamily[]>(DEFAULT_RUNTIME_FAMILIES);
+  const [familyFilter, setFamilyFilter] = useState('');
+  const [isEditing, setIsEditing] = useState(false);
+  const [draft, setDraft] = useState('');
+
+  useEffect(() => setFamilies(loadRuntimeFamilies()), []);
+
+  const total = data.summaryTotals[event] || 0;
+  const analysis = useMemo(() => analyzeRuntimeFamilies(graph, families, event, total), [graph, families, event, total]);
+  const callers = useMemo(
+    () => analysis.callers.filter(c => !familyFilter || c.family.name === familyFilter).slice(0, MAX_SHOWN),
+    [analysis, familyFilter]
+  );
+  const share = (value: number) => total > 0 ? `${((value / total) * 100).toFixed(2)}%` : '-';
+
+  const handleSave = () => {
+    const parsed = parseFamilies(draft);
+    saveRuntimeFamilies(parsed);
+    setFamilies(parsed);
+    setIsEditing(false);
+  };
+
+  return (
+    <div className="bg-white rounded-xl shadow-sm p-6 border border-gray-100">
+      <div className="flex items-center justify-between mb-4">
+        <div className="flex items-center gap-2">
+          <Layers className="w-5 h-5 text-indigo-600" />
+          <h3 className="text-lg font-semibold text-gray-800">Runtime Cost by Caller</h3>
+        </div>
+        <button
+          onClick={() => {
+            setDraft(formatFamilies(families));
+            setIsEditing(!isEditing);
+          }}
+          className="p-1.5 rounded hover:bg-gray-100 text-gray-600"
+          title="Edit function families"
+        >
+          <Settings className="w-4 h-4" />
+        </button>
+      </div>
+      <p className="text-xs text-gray-500 mb-3">
+        {event} spent in allocator, locking and memory/string routines, charged to the nearest application function
+        that reaches them. Calls made from library code are passed up to its callers by their share of its cost.
+      </p>
+
+      {isEditing && (
+        <div className="mb-4">
+          <textarea
+            value={draft}
+            onChange={(e) => setDraft(e.target.value)}
+            rows={Math.max(4, draft.split('\n').length + 1)}
+            className="w-full px-2 py-1.5 text-xs font-mono border border-gray-300 rounded focus:outline-none focus:ring-2 focus:ring-blue-500"
+          />
+          <div className="flex items-center gap-2 mt-2 text-xs">
+            <span className="text-gray-500 flex-1">One family per line: <code>Name (allocator): glob, glob</code></span>
+            <button
+              onClick={() => setDraft(formatFamilies(DEFAULT_RUNTIME_FAMILIES))}
+              className="px-3 py-1 border border-gray-300 rounded hover:bg-gray-50 text-gray-700"
+            >
+              Defaults
+            </button>
+            <button onClick={handleSave} className="px-3 py-1 bg-blue-500 text-white rounded hover:bg-blue-600">
+              Save
+            </button>
+          </div>
+        </div>
+      )}
+
+      {/* Family totals; clicking one filters the caller table */}
+      <div className="grid grid-cols-2 md:grid-cols-4 gap-4 mb-4">
+        {analysis.families.map(family => (
+          <button
+            key={family.family.name}
+            onClick={() => setFamilyFilter(familyFilter === family.family.name ? '' : family.family.name)}
+            className={cn(
+              "text-left rounded-lg p-3 border transition-colors",
+              familyFilter === family.family.name ? "border-indigo-400 bg-indigo-50" : "border-gray-100 bg-gray-50 hover:bg-gray-100"
+            )}
+          >
+            <div className="text-sm text-gray-600">{family.family.name}</div>
+            <div className="text-lg font-semibold text-gray-800">{share(family.cost)}</div>
+            <div className="text-xs text-gray-500">
+              {Math.round(family.cost).toLocaleString()} {event} · {family.calls.toLocaleString()} calls
+              {family.cost - family.attributed >= 1 && ` · ${share(family.cost - family.attributed)} outside application`}
+            </div>
+          </button>
+        ))}
+      </div>
+
+      {callers.length === 0 ? (
+        <p className="text-sm text-gray-500">No application function reaches these families.</p>
+      ) : (
+        <div className="overflow-x-auto max-h-[28rem] overflow-y-auto mb-4">
+          <table className="w-full">
+            <thead className="sticky top-0 bg-white">
+              <tr className="border-b border-gray-200">
+                <th className="text-left py-2 px-3 text-sm font-medium text-gray-700">Caller</th>
+                <th className="text-left py-2 px-3 text-sm font-medium text-gray-700">Family</th>
+                <th className="text-right py-2 px-3 text-sm font-medium text-gray-700">Calls</th>
+                <th className="text-right py-2 px-3 text-sm font-medium text-gray-700">{event}</th>
+                <th className="text-right py-2 px-3 text-sm font-medium text-gray-700" title="Reached through the caller's own calls rather than through library code">Direct</th>
+                <th className="text-right py-2 px-3 text-sm font-medium text-gray-700">Share</th>
+              </tr>
+            </thead>
+            <tbody>
+              {callers.map(entry => (
+                <tr key={`${entry.caller.key}:${entry.family.name}`} className="border-b border-gray-100 hover:bg-gray-50">
+                  <td className="py-2 px-3 text-xs font-mono text-gray-800">
+                    <button
+                      onClick={() => onViewCode?.(entry.caller.file, entry.caller.functionName, entry.lines[0] ?? entry.caller.data?.startLine)}
+                      className={cn(onViewCode ? "hover:underline text-blue-700" : "cursor-default")}
+                      title={entry.caller.file}
+                    >
+                      {entry.caller.functionName}
+                    </button>
+                    {entry.lines.length > 0 && (
+                      <span className="ml-1 text-gray-400">:{entry.lines.slice(0, 4).join(', ')}{entry.lines.length > 4 ? '…' : ''}</span>
+                    )}
+                  </td>
+                  <td className="py-2 px-3 text-xs text-gray-600">{entry.family.name}</td>
+                  <td className="py-2 px-3 text-sm text-right text-gray-800">{Math.round(entry.calls).toLocaleString()}</td>
+                  <td className="py-2 px-3 text-sm text-right font-medium text-gray-800">{Math.round(entry.cost).toLocaleString()}</td>
+                  <td className="py-2 px-3 text-sm text-right text-gray-600">{Math.round(entry.direct).toLocaleString()}</td>
+                  <td className="py-2 px-3 text-sm text-right text-gray-600">{share(entry.cost)}</td>
+                </tr>
+              ))}
+            </tbody>
+          </table>
+        </div>
+      )}
+
+      {/* Allocation-heavy callers */}
+      {analysis.poolCandidates.length > 0 && (
+        <div className="border-t border-gray-100 pt-3">
+          <div className="text-sm font-medium text-gray-800 mb-2">Pool or arena allocator candidates</div>
+          <ul className="space-y-1">
+            {analysis.poolCandidates.slice(0, 10).map(candidate => (
+              <li key={`${candidate.site.caller.key}:${candidate.site.family.name}`} className="text-xs text-gray-700">
+                <button
+                  onClick={() => onViewCode?.(candidate.site.caller.file, candidate.site.caller.functionName, candidate.site.lines[0])}
+                  className={cn("font-mono", onViewCode ? "hover:underline text-blue-700" : "cursor-default")}
+                >
+                  {candidate.site.caller.functionName}
+                </button>
+                {' '}makes {Math.round(candidate.site.calls).toLocaleString()} {candidate.site.family.name.toLowerCase()} calls
+                at {candidate.costPerCall.toFixed(1)} {event}/call, {(candidate.share * 100).toFixed(1)}% of its inclusive {event}
+              </li>
+            ))}
+          </ul>
+        </div>
+      )}
+    </div>
+  );
+}
@@ -4,7 +4,11 @@ import { useState, useEffect, useMemo } from 'react';
 import { Activity, BarChart3, ChevronDown, FolderOpen, ArrowUpDown, ArrowUp, ArrowDown, ArrowLeft, GitBranch, Settings, X, Search, Code2 } from 'lucide-react';
 import { availableSrcSubdirectories } from '@/lib/src-directories';
 import { cn, formatPercentage, getCoverageColor, getCoverageBgColor } from '@/lib/utils';
-import { CachegrindData } from '@/types/profiler';
+import { CachegrindData, FileCoverage, FunctionData } from '@/types/profiler';
+import { loadCollapseRules, saveCollapseRules, DEFAULT_COLLAPSE_RULES, FrameCollapseRules } from '@/lib/frame-collapse';
+import { loadPruneThresholds, savePruneThresholds, DEFAULT_PRUNE_THRESHOLDS, PruneThresholds } from '@/lib/graph-prune';
+import { ColumnTable } from '@/lib/column-table';
+import { VirtualList } from './virtual-list';
 
 interface SidebarProps {
   data: CachegrindData;
@@ -15,11 +19,14 @@ interface SidebarProps {
   onReset?: () => void;
   onCallTreeView?: () => void;
   isCallTreeActive?: boolean;
+  onSettingsSaved?: () => void;
 }
 
 type ViewMode = 'files' | 'functions';
 
-export function Sidebar({ data, selectedFile, selectedFunction, onFileSelect, onFunctionSelect, onReset, onCallTreeView, isCallTreeActive = false }: SidebarProps) {
+const ROW_HEIGHT = 40; // px, fixed so the lists can be virtualized
+
+export function Sidebar({ data, selectedFile, selectedFunction, onFileSelect, onFunctionSelect, onReset, onCallTreeView, isCallTreeActive = false, onSettingsSaved }: SidebarProps) {
   const [sortBy, setSortBy] = useState<string>('coverage');
   const [sortAscending, setSortAscending] = useState<boolean>(false);
   const [sortByInclusive, setSortByInclusive] = useState<boolean>(false); // For functions view
@@ -30,14 +37,9 @@ export function Sidebar({ data, selectedFile, selectedFunction, onFileSelect, on
   const [searchQuery, setSearchQuery] = useState<string>('');
   const [objdumpCommand, setObjdumpCommand] = useState<string>('objdump');
   const [functionPadding, setFunctionPadding] = useState<number>(5);
-  
-  // Pagination state for functions list
-  const [functionPageSize, setFunctionPageSize] = useState<number>(50); // Default to 50 items per page
-  const [functionCurrentPage, setFunctionCurrentPage] = useState<number>(1);
-  
-  // Pagination state for files list
-  const [filePageSize, setFilePageSize] = useState<number>(50); // Default to 50 items per page
-  const [fileCurrentPage, setFileCurrentPage] = useState<number>(1);
+  const [collapseRules, setCollapseRules] = useState<FrameCollapseRules>(DEFAULT_COLLAPSE_RULES);
+  const [pruneThresholds, setPruneThresholds] = useState<PruneThresholds>(DEFAULT_PRUNE_THRESHOLDS);
+
   
   // Load saved settings from localStorage and get available subdirectories
   useEffect(() => {
@@ -67,24 +69,13 @@ export function Sidebar({ data, selectedFile, selectedFunction, onFileSelect, on
       setFunctionPadding(parseInt(savedPadding, 10));
     }
     
+    setCollapseRules(loadCollapseRules());
+    setPruneThresholds(loadPruneThresholds());
+    
     // Set available subdirectories from static list
     setAvailableSubdirs(availableSrcSubdirectories);
   }, []);
   
-  // Calculate total metrics for each file
-  const getFileMetric = (fileData: any, metric: string): number => {
-    if (metric === 'coverage') {
-      return fileData.coveragePercentage;
-    }
-    
-    // Sum up the metric from all functions in the file
-    let total = 0;
-    Object.values(fileData.functions || {}).forEach((func: any) => {
-      total += func.totals[metric] || 0;
-    });
-    return total;
-  };
-  
   // Get metric description
   const getMetricDescription = (metric: string): string => {
     const descriptions: Record<string, string> = {
@@ -99,142 +90,84 @@ export function Sidebar({ data, selectedFile, selectedFunction, onFileSelect, on
     return descriptions[metric] || metric;
   };
   
-  // Cache calculated inclusive totals and call counts
-  const functionsWithInclusiveTotals = useMemo(() => {
-    const functions: Array<{ name: string; file: string; data: any; inclusiveTotals: Record<string, number>; callCount: number }> = [];
-    
-    // First pass: collect all functions and calculate inclusive totals
+  // Functions as columns: self, inclusive, call count and coverage are
+  // filled per sort key on first use and each key's order is cached
+  const functionTable = useMemo(() => {
+    const names: string[] = [];
+    const files: string[] = [];
+    const functions: FunctionData[] = [];
+    const byKey = new Map<string, number>();
+    const byName = new Map<string, number>();
     Object.entries(data.fileCoverage).forEach(([filename, fileData]) => {
       Object.entries(fileData.functions || {}).forEach(([funcName, funcData]) => {
-        // Calculate inclusive totals
-        const inclusiveTotals: Record<string, number> = { ...funcData.totals };
-        
-        // Add inclusive counts from calls
-        if (funcData.calls && Array.isArray(funcData.calls)) {
-          funcData.calls.forEach((call: any) => {
-            if (call.inclusiveEvents) {
-              Object.entries(call.inclusiveEvents).forEach(([event, count]) => {
-                inclusiveTotals[event] = (inclusiveTotals[event] || 0) + (count as number);
-              });
-            }
-          });
-        }
-        
-        functions.push({
-          name: funcName,
-          file: filename,
-          data: funcData,
-          inclusiveTotals,
-          callCount: 0 // Will be calculated in second pass
-        });
+        const row = names.length;
+        names.push(funcName);
+        files.push(filename);
+        functions.push(funcData);
+        byKey.set(`${filename}:${funcName}`, row);
+        if (!byName.has(funcName)) byName.set(funcName, row);
       });
     });
-    
-    // Second pass: calculate how many times each function is called
-    Object.entries(data.fileCoverage).forEach(([_, fileData]) => {
-      Object.entries(fileData.functions || {}).forEach(([__, funcData]) => {
-        if (funcData.calls && Array.isArray(funcData.calls)) {
-          funcData.calls.forEach((call: any) => {
-            if (call.targetFunction) {
-              // Find the target function and increment its call count
-              const targetFunc = functions.find(f => 
-                f.name === call.targetFunction && 
-                (call.targetFile ? f.file === call.targetFile : true)
-              );
-              if (targetFunc) {
-                targetFunc.callCount += call.count || 1;
-              }
-            }
+
+    const searchText = names.map((name, i) =>
+      `${name}\n${files[i].split('/').pop() || files[i]}`.toLowerCase());
+
+    const table = new ColumnTable(names.length, searchText, (key, out) => {
+      if (key === 'coverage') {
+        functions.forEach((func, i) => { out[i] = func.coveragePercentage; });
+      } else if (key === 'calls') {
+        // How many times each function is called, matched by file when the call names one
+        functions.forEach(func => {
+          func.calls?.forEach(call => {
+            if (!call.targetFunction) return;
+            const target = call.targetFile
+              ? byKey.get(`${call.targetFile}:${call.targetFunction}`)
+              : byName.get(call.targetFunction);
+            if (target !== undefined) out[target] += call.count || 1;
           });
-        }
-      });
+        });
+      } else if (key.startsWith('self:')) {
+        const event = key.substring(5);
+        functions.forEach((func, i) => { out[i] = func.totals[event] || 0; });
+      } else if (key.startsWith('incl:')) {
+        const event = key.substring(5);
+        functions.forEach((func, i) => {
+          let total = func.totals[event] || 0;
+          func.calls?.forEach(call => { total += call.inclusiveEvents?.[event] || 0; });
+          out[i] = total;
+        });
+      }
     });
-    
-    return functions;
+    return { table, names, files, functions };
   }, [data]);
 
-  // Memoize sorted functions to avoid re-sorting on every render
-  const sortedFunctions = useMemo(() => {
-    return [...functionsWithInclusiveTotals].sort((a, b) => {
-      const aValue = sortBy === 'coverage' 
-        ? a.data.coveragePercentage 
-        : sortByInclusive && sortBy !== 'coverage'
-          ? (a.inclusiveTotals[sortBy] || 0)
-          : (a.data.totals[sortBy] || 0);
-      const bValue = sortBy === 'coverage' 
-        ? b.data.coveragePercentage 
-        : sortByInclusive && sortBy !== 'coverage'
-          ? (b.inclusiveTotals[sortBy] || 0)
-          : (b.data.totals[sortBy] || 0);
-      return sortAscending ? aValue - bValue : bValue - aValue;
-    });
-  }, [functionsWithInclusiveTotals, sortBy, sortAscending, sortByInclusive]);
-  
-  // Memoize sorted files
-  const sortedFiles = useMemo(() => {
-    return Object.entries(data.fileCoverage).sort((a, b) => {
-      const aValue = getFileMetric(a[1], sortBy);
-      const bValue = getFileMetric(b[1], sortBy);
-      return sortAscending ? aValue - bValue : bValue - aValue;
+  const fileTable = useMemo(() => {
+    const entries: Array<[string, FileCoverage]> = Object.entries(data.fileCoverage);
+    const searchText = entries.map(([filename]) => filename.toLowerCase());
+    const table = new ColumnTable(entries.length, searchText, (key, out) => {
+      entries.forEach(([, fileData], i) => {
+        if (key === 'coverage') {
+          out[i] = fileData.coveragePercentage;
+          return;
+        }
+        // Sum up the metric from all functions in the file
+        let total = 0;
+        Object.values(fileData.functions || {}).forEach(func => { total += func.totals[key] || 0; });
+        out[i] = total;
+      });
     });
-  }, [data.fileCoverage, sortBy, sortAscending]);
-
-  // Memoize filtered files and functions
-  const filteredFiles = useMemo(() => {
-    return sortedFiles.filter(([filename]) => 
-      filename.toLowerCase().includes(searchQuery.toLowerCase()) ||
-      (filename.split('/').pop() || filename).toLowerCase().includes(searchQuery.toLowerCase())
-    );
-  }, [sortedFiles, searchQuery]);
-  
-  const filteredFunctions = useMemo(() => {
-    return sortedFunctions.filter((func) =>
-      func.name.toLowerCase().includes(searchQuery.toLowerCase()) ||
-      (func.file.split('/').pop() || func.file).toLowerCase().includes(searchQuery.toLowerCase())
-    );
-  }, [sortedFunctions, searchQuery]);
-  
-  // Calculate paginated files
-  const paginatedFiles = useMemo(() => {
-    if (filePageSize === -1) {
-      // Show all files
-      return filteredFiles;
-    }
-    
-    const startIndex = (fileCurrentPage - 1) * filePageSize;
-    const endIndex = startIndex + filePageSize;
-    return filteredFiles.slice(startIndex, endIndex);
-  }, [filteredFiles, fileCurrentPage, filePageSize]);
-  
-  // Calculate total file pages
-  const totalFilePages = useMemo(() => {
-    if (filePageSize === -1) return 1;
-    return Math.ceil(filteredFiles.length / filePageSize);
-  }, [filteredFiles, filePageSize]);
+    return { table, entries };
+  }, [data]);
 
-  // Calculate paginated functions
-  const paginatedFunctions = useMemo(() => {
-    if (functionPageSize === -1) {
-      // Show all functions
-      return filteredFunctions;
-    }
-    
-    const startIndex = (functionCurrentPage - 1) * functionPageSize;
-    const endIndex = startIndex + functionPageSize;
-    return filteredFunctions.slice(startIndex, endIndex);
-  }, [filteredFunctions, functionCurrentPage, functionPageSize]);
-  
-  // Calculate total function pages
-  const totalFunctionPages = useMemo(() => {
-    if (functionPageSize === -1) return 1;
-    return Math.ceil(filteredFunctions.length / functionPageSize);
-  }, [filteredFunctions, functionPageSize]);
-  
-  // Reset page when search or sort changes
-  useEffect(() => {
-    setFileCurrentPage(1);
-    setFunctionCurrentPage(1);
-  }, [searchQuery, sortBy, sortAscending, sortByInclusive]);
+  const functionSortKey = sortBy === 'coverage' ? 'coverage' : `${sortByInclusive ? 'incl' : 'self'}:${sortBy}`;
+  const visibleFunctions = useMemo(
+    () => functionTable.table.view(functionSortKey, sortAscending, searchQuery),
+    [functionTable, functionSortKey, sortAscending, searchQuery]
+  );
+  const visibleFiles = useMemo(
+    () => fileTable.table.view(sortBy, sortAscending, searchQuery),
+    [fileTable, sortBy, sortAscending, searchQuery]
+  );
 
   return (
     <div className="w-full bg-white border-r border-gray-200 flex flex-col h-full">
@@ -427,19 +360,25 @@ export function Sidebar({ data, selectedFile, selectedFunction, onFileSelect, on
       </div>
 
       {/* List */}
-      <div className="flex-1 overflow-y-auto">
-        <div className="px-2 pb-4">
-          {viewMode === 'files' ? (
-            // Files list
-            paginatedFiles.map(([filename, fileData]) => (
+      <VirtualList
+        className="flex-1 px-2"
+        count={viewMode === 'files' ? visibleFiles.length : visibleFunctions.length}
+        rowHeight={ROW_HEIGHT}
+        resetKey={`${viewMode}|${searchQuery}|${sortBy}|${sortAscending}|${sortByInclusive}`}
+        renderRow={(index) => {
+          if (viewMode === 'files') {
+            const row = visibleFiles[index];
+            const [filename, fileData] = fileTable.entries[row];
+            return (
               <button
                 key={filename}
+                style={{ height: ROW_HEIGHT - 4 }}
                 onClick={() => {
                   onFileSelect(filename);
                   onFunctionSelect(null, null);
                 }}
                 className={cn(
-                  "w-full px-3 py-2 rounded-lg mb-1 text-left transition-all duration-200",
+                  "w-full px-3 py-2 rounded-lg mb-1 text-left transition-all duration-200 block",
                   selectedFile === filename && !selectedFunction
                     ? "bg-blue-50 border border-blue-200"
                     : "hover:bg-gray-50"
@@ -461,7 +400,7 @@ export function Sidebar({ data, selectedFile, selectedFunction, onFileSelect, on
                     </>
                   ) : (
                     <span className="text-xs font-medium text-gray-700 w-20 text-right">
-                      {getFileMetric(fileData, sortBy).toLocaleString()}
+                      {fileTable.table.column(sortBy)[row].toLocaleString()}
                     </span>
                   )}
                   <span className="text-sm font-medium text-gray-700 truncate flex-1" title={filename}>
@@ -469,155 +408,82 @@ export function Sidebar({ data, selectedFile, selectedFunction, onFileSelect, on
                   </span>
                 </div>
               </button>
-            ))
-          ) : (
-            // Functions list
-            paginatedFunctions.map((func) => (
-              <button
-                key={`${func.file}:${func.name}`}
-                onClick={() => {
-                  onFileSelect(func.file);
-                  onFunctionSelect(func.name, func.file);
-                }}
-                className={cn(
-                  "w-full px-3 py-2 rounded-lg mb-1 text-left transition-all duration-200",
-                  selectedFunction === func.name && selectedFile === func.file
-                    ? "bg-blue-50 border border-blue-200"
-                    : "hover:bg-gray-50"
+            );
+          }
+          const row = visibleFunctions[index];
+          const func = {
+            name: functionTable.names[row],
+            file: functionTable.files[row],
+            data: functionTable.functions[row],
+            callCount: functionTable.table.column('calls')[row]
+          };
+          return (
+            <button
+              key={`${func.file}:${func.name}`}
+              style={{ height: ROW_HEIGHT - 4 }}
+              onClick={() => {
+                onFileSelect(func.file);
+                onFunctionSelect(func.name, func.file);
+              }}
+              className={cn(
+                "w-full px-3 py-2 rounded-lg mb-1 text-left transition-all duration-200 block",
+                selectedFunction === func.name && selectedFile === func.file
+                  ? "bg-blue-50 border border-blue-200"
+                  : "hover:bg-gray-50"
+              )}
+            >
+              <div className="flex items-center gap-2">
+                {sortBy === 'coverage' ? (
+                  <>
+                    <span className={cn(
+                      "text-xs font-medium px-1.5 py-0.5 rounded w-12 text-center",
+                      getCoverageColor(func.data.coveragePercentage),
+                      getCoverageBgColor(func.data.coveragePercentage)
+                    )}>
+                      {formatPercentage(func.data.coveragePercentage)}
+                    </span>
+                    <span className="text-xs text-gray-500 w-16 text-center">
+                      {func.data.coveredLines?.length || 0}/{(func.data.coveredLines?.length || 0) + (func.data.uncoveredLines?.length || 0)}
+                    </span>
+                  </>
+                ) : (
+                  <>
+                    <span 
+                      className="text-xs font-medium text-gray-500 w-10 text-right"
+                      title={`Called ${func.callCount} time${func.callCount !== 1 ? 's' : ''}`}
+                    >
+                      {func.callCount > 0 ? func.callCount.toLocaleString() : '-'}
+                    </span>
+                    <span 
+                      className="text-xs font-medium text-gray-700 text-right"
+                      style={{ minWidth: '60px' }}
+                      title={`Inclusive ${getMetricDescription(sortBy)}`}
+                    >
+                      {functionTable.table.column(`incl:${sortBy}`)[row].toLocaleString()}
+                    </span>
+                    <span 
+                      className="text-xs font-medium text-gray-600 text-right"
+                      style={{ minWidth: '60px' }}
+                      title={`Self ${getMetricDescription(sortBy)}`}
+                    >
+                      {(func.data.totals[sortBy] || 0).toLocaleString()}
+                    </span>
+                  </>
                 )}
-              >
-                <div className="flex items-center gap-2">
-                  {sortBy === 'coverage' ? (
-                    <>
-                      <span className={cn(
-                        "text-xs font-medium px-1.5 py-0.5 rounded w-12 text-center",
-                        getCoverageColor(func.data.coveragePercentage),
-                        getCoverageBgColor(func.data.coveragePercentage)
-                      )}>
-                        {formatPercentage(func.data.coveragePercentage)}
-                      </span>
-                      <span className="text-xs text-gray-500 w-16 text-center">
-                        {func.data.coveredLines?.length || 0}/{(func.data.coveredLines?.length || 0) + (func.data.uncoveredLines?.length || 0)}
-                      </span>
-                    </>
-                  ) : (
-                    <>
-                      <span 
-                        className="text-xs font-medium text-gray-500 w-10 text-right"
-                        title={`Called ${func.callCount} time${func.callCount !== 1 ? 's' : ''}`}
-                      >
-                        {func.callCount > 0 ? func.callCount.toLocaleString() : '-'}
-                      </span>
-                      <span 
-                        className="text-xs font-medium text-gray-700 text-right"
-                        style={{ minWidth: '60px' }}
-                        title={`Inclusive ${getMetricDescription(sortBy)}`}
-                      >
-                        {(func.inclusiveTotals[sortBy] || 0).toLocaleString()}
-                      </span>
-                      <span 
-                        className="text-xs font-medium text-gray-600 text-right"
-                        style={{ minWidth: '60px' }}
-                        title={`Self ${getMetricDescription(sortBy)}`}
-                      >
-                        {(func.data.totals[sortBy] || 0).toLocaleString()}
-                      </span>
-                    </>
-                  )}
-                  <span className="text-sm font-medium text-gray-700 truncate flex-1" title={`${func.name} (${func.file})`}>
-                    {func.name}
-                  </span>
-                </div>
-              </button>
-            ))
-          )}
-        </div>
-        
-        {/* Pagination Controls */}
-        {((viewMode === 'files' && filteredFiles.length > 10) || (viewMode === 'functions' && filteredFunctions.length > 10)) && (
-          <div className="px-4 py-3 border-t border-gray-200 space-y-2">
-            {/* Page size selector */}
-            <div className="flex items-center justify-between">
-              <label className="text-sm text-gray-600">Items per page:</label>
-              <select
-                value={viewMode === 'files' ? filePageSize : functionPageSize}
-                onChange={(e) => {
-                  const newSize = Number(e.target.value);
-                  if (viewMode === 'files') {
-                    setFilePageSize(newSize);
-                    setFileCurrentPage(1);
-                  } else {
-                    setFunctionPageSize(newSize);
-                    setFunctionCurrentPage(1);
-                  }
-                }}
-                className="text-sm px-2 py-1 border border-gray-300 rounded focus:ring-blue-500 focus:border-blue-500"
-              >
-                <option value={10}>10</option>
-                <option value={50}>50</option>
-                <option value={100}>100</option>
-                <option value={-1}>All ({viewMode === 'files' ? filteredFiles.length : filteredFunctions.length})</option>
-              </select>
-            </div>
-            
-            {/* Page navigation */}
-            {((viewMode === 'files' && filePageSize !== -1 && totalFilePages > 1) || 
-              (viewMode === 'functions' && functionPageSize !== -1 && totalFunctionPages > 1)) && (
-              <div className="flex items-center justify-between">
-                <button
-                  onClick={() => {
-                    if (viewMode === 'files') {
-                      setFileCurrentPage(prev => Math.max(1, prev - 1));
-                    } else {
-                      setFunctionCurrentPage(prev => Math.max(1, prev - 1));
-                    }
-                  }}
-                  disabled={viewMode === 'files' ? fileCurrentPage === 1 : functionCurrentPage === 1}
-                  className={cn(
-                    "px-2 py-1 text-sm rounded",
-                    (viewMode === 'files' ? fileCurrentPage === 1 : functionCurrentPage === 1)
-                      ? "bg-gray-100 text-gray-400 cursor-not-allowed"
-                      : "bg-gray-200 text-gray-700 hover:bg-gray-300"
-                  )}
-                >
-                  Previous
-                </button>
-                
-                <span className="text-sm text-gray-600">
-                  Page {viewMode === 'files' ? fileCurrentPage : functionCurrentPage} of {viewMode === 'files' ? totalFilePages : totalFunctionPages}
+                <span className="text-sm font-medium text-gray-700 truncate flex-1" title={`${func.name} (${func.file})`}>
+                  {func.name}
                 </span>
-                
-                <button
-                  onClick={() => {
-                    if (viewMode === 'files') {
-                      setFileCurrentPage(prev => Math.min(totalFilePages, prev + 1));
-                    } else {
-                      setFunctionCurrentPage(prev => Math.min(totalFunctionPages, prev + 1));
-                    }
-                  }}
-                  disabled={viewMode === 'files' ? fileCurrentPage === totalFilePages : functionCurrentPage === totalFunctionPages}
-                  className={cn(
-                    "px-2 py-1 text-sm rounded",
-                    (viewMode === 'files' ? fileCurrentPage === totalFilePages : functionCurrentPage === totalFunctionPages)
-                      ? "bg-gray-100 text-gray-400 cursor-not-allowed"
-                      : "bg-gray-200 text-gray-700 hover:bg-gray-300"
-                  )}
-                >
-                  Next
-                </button>
               </div>
-            )}
-            
-            {/* Results info */}
-            <div className="text-center text-xs text-gray-500">
-              {viewMode === 'files' ? (
-                `Showing ${filePageSize === -1 ? filteredFiles.length : Math.min(filePageSize, filteredFiles.length - (fileCurrentPage - 1) * filePageSize)} of ${filteredFiles.length} files`
-              ) : (
-                `Showing ${functionPageSize === -1 ? filteredFunctions.length : Math.min(functionPageSize, filteredFunctions.length - (functionCurrentPage - 1) * functionPageSize)} of ${filteredFunctions.length} functions`
-              )}
-            </div>
-          </div>
-        )}
+            </button>
+          );
+        }}
+      />
+      
+      {/* Results info */}
+      <div className="px-4 py-2 border-t border-gray-200 text-center text-xs text-gray-500">
+        {viewMode === 'files'
+          ? `${visibleFiles.length.toLocaleString()} of ${fileTable.entries.length.toLocaleString()} files`
+          : `${visibleFunctions.length.toLocaleString()} of ${functionTable.names.length.toLocaleString()} functions`}
       </div>
       
       {/* Settings Modal */}
@@ -713,6 +579,101 @@ export function Sidebar({ data, selectedFile, selectedFunction, onFileSelect, on
                   Number of extra lines to show before and after functions (0-50)
                 </p>
               </div>
+              
+              <div>
+                <label className="flex items-center gap-2 text-sm font-medium text-gray-700 mb-2">
+                  <input
+                    type="checkbox"
+                    checked={collapseRules.enabled}
+                    onChange={(e) => setCollapseRules({ ...collapseRules, enabled: e.target.checked })}
+                    className="rounded"
+                  />
+                  Collapse Helper Frames
+                </label>
+                <textarea
+                  value={collapseRules.namePatterns.join('\n')}
+                  onChange={(e) => setCollapseRules({ ...collapseRules, namePatterns: e.target.value.split('\n') })}
+                  disabled={!collapseRules.enabled}
+                  rows={3}
+                  className="w-full px-3 py-2 border border-gray-300 rounded-lg focus:outline-none focus:ring-2 focus:ring-blue-500 font-mono text-xs disabled:bg-gray-100"
+                  placeholder="*@plt"
+                />
+                <p className="mt-1 text-xs text-gray-500">
+                  Function name patterns, one per line (* and ? wildcards)
+                </p>
+                <textarea
+                  value={collapseRules.objectPatterns.join('\n')}
+                  onChange={(e) => setCollapseRules({ ...collapseRules, objectPatterns: e.target.value.split('\n') })}
+                  disabled={!collapseRules.enabled}
+                  rows={2}
+                  className="mt-2 w-full px-3 py-2 border border-gray-300 rounded-lg focus:outline-none focus:ring-2 focus:ring-blue-500 font-mono text-xs disabled:bg-gray-100"
+                  placeholder="libthunks.so*"
+                />
+                <p className="mt-1 text-xs text-gray-500">
+                  Object file patterns, one per line
+                </p>
+                <div className="mt-2 flex items-center gap-2">
+                  <label className="text-sm text-gray-700">Auto-collapse below self/inclusive</label>
+                  <input
+                    type="number"
+                    value={collapseRules.autoSelfRatio * 100}
+                    onChange={(e) => setCollapseRules({
+                      ...collapseRules,
+                      autoSelfRatio: Math.min(100, Math.max(0, parseFloat(e.target.value) || 0)) / 100
+                    })}
+                    disabled={!collapseRules.enabled}
+                    className="w-20 px-2 py-1 border border-gray-300 rounded focus:outline-none focus:ring-2 focus:ring-blue-500 text-sm disabled:bg-gray-100"
+                    min="0"
+                    max="100"
+                    step="0.1"
+                  />
+                  <span className="text-sm text-gray-500">%</span>
+                </div>
+                <p className="mt-1 text-xs text-gray-500">
+                  Frames that forward to a single callee and whose self cost is below this share of their inclusive cost are spliced out (0 disables)
+                </p>
+              </div>
+              
+              <div>
+                <label className="block text-sm font-medium text-gray-700 mb-2">
+                  Call Graph Pruning
+                </label>
+                <div className="grid grid-cols-2 gap-3">
+                  <div>
+                    <span className="text-xs text-gray-600">Node threshold (% of total)</span>
+                    <input
+                      type="number"
+                      value={pruneThresholds.nodeThreshold * 100}
+                      onChange={(e) => setPruneThresholds({
+                        ...pruneThresholds,
+                        nodeThreshold: Math.min(100, Math.max(0, parseFloat(e.target.value) || 0)) / 100
+                      })}
+                      className="w-full px-3 py-2 border border-gray-300 rounded-lg focus:outline-none focus:ring-2 focus:ring-blue-500 text-sm"
+                      min="0"
+                      max="100"
+                      step="0.01"
+                    />
+                  </div>
+                  <div>
+                    <span className="text-xs text-gray-600">Edge threshold (% of total)</span>
+                    <input
+                      type="number"
+                      value={pruneThresholds.edgeThreshold * 100}
+                      onChange={(e) => setPruneThresholds({
+                        ...pruneThresholds,
+                        edgeThreshold: Math.min(100, Math.max(0, parseFloat(e.target.value) || 0)) / 100
+                      })}
+                      className="w-full px-3 py-2 border border-gray-300 rounded-lg focus:outline-none focus:ring-2 focus:ring-blue-500 text-sm"
+                      min="0"
+                      max="100"
+                      step="0.01"
+                    />
+                  </div>
+                </div>
+                <p className="mt-1 text-xs text-gray-500">
+                  Functions and calls below these shares of total cost are merged into per-caller [other] entries in the function list, call tree and flow chart (0 disables)
+                </p>
+              </div>
             </div>
             
             <div className="mt-6 flex justify-end gap-3">
@@ -728,7 +689,14 @@ export function Sidebar({ data, selectedFile, selectedFunction, onFileSelect, on
                   localStorage.setItem('profiler-src-subdirs', JSON.stringify(srcSubdirs));
                   localStorage.setItem('profiler-objdump-command', objdumpCommand);
                   localStorage.setItem('profiler-function-padding', functionPadding.toString());
+                  saveCollapseRules({
+                    ...collapseRules,
+                    namePatterns: collapseRules.namePatterns.map(p => p.trim()).filter(Boolean),
+                    objectPatterns: collapseRules.objectPatterns.map(p => p.trim()).filter(Boolean)
+                  });
+                  savePruneThresholds(pruneThresholds);
                   setShowSettings(false);
+                  onSettingsSaved?.();
                 }}
                 className="px-4 py-2 bg-blue-600 text-white hover:bg-blue-700 rounded-lg transition-colors"
               >
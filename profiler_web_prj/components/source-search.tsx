@@ -0,0 +1,229 @@
+'use client';
+
+import { useMemo, useRef, useState } from 'react';
+import { FileSearch, AlertCircle } from 'lucide-react';
+import { CachegrindData } from '@/types/profiler';
+import { SourceSearchResult } from '@/lib/source-index';
+import { cn } from '@/lib/utils';
+
+interface SourceSearchProps {
+  data: CachegrindData;
+  scope?: string | null; // from indexProfileSources; search is unavailable until it is set
+  onViewCode?: (fileName: string, functionName: string, line?: number) => void;
+}
+
+interface FoundLine {
+  file: string;
+  line: number;
+  text: string;
+}
+
+interface RankedHit extends FoundLine {
+  cost: number;
+  functionName?: string;
+}
+
+const MAX_SHOWN = 500;
+
+export function SourceSearch({ data, scope, onViewCode }: SourceSearchProps) {
+  const [query, setQuery] = useState('');
+  const [event, setEvent] = useState(
+    data.events.includes('Cy') ? 'Cy' : (data.events.includes('Ir') ? 'Ir' : data.events[0])
+  );
+  const [found, setFound] = useState<FoundLine[]>([]);
+  const [isSearching, setIsSearching] = useState(false);
+  const [status, setStatus] = useState<string | null>(null);
+  const [error, setError] = useState<string | null>(null);
+  const [searchedQuery, setSearchedQuery] = useState('');
+  const searchId = useRef(0);
+
+  // Per-file line -> (cost, function with most of it), built the first time a file has a hit
+  const lineCosts = useMemo(() => {
+    const cache = new Map<string, Map<number, { cost: number; functionName: string; functionCost: number }>>();
+    return (file: string) => {
+      let lines = cache.get(file);
+      if (!lines) {
+        const fileLines = new Map<number, { cost: number; functionName: string; functionCost: number }>();
+        Object.entries(data.fileCoverage[file]?.functions || {}).forEach(([functionName, functionData]) => {
+          Object.entries(functionData.lines || {}).forEach(([lineKey, lineData]) => {
+            const line = Number(lineKey);
+            const cost = typeof lineData[event] === 'number' ? lineData[event] as number : 0;
+            const existing = fileLines.get(line);
+            if (!existing) {
+              fileLines.set(line, { cost, functionName, functionCost: cost });
+            } else {
+              existing.cost += cost;
+              if (cost > existing.functionCost) {
+                existing.functionName = functionName;
+                existing.functionCost = cost;
+              }
+            }
+          });
+        });
+        lines = fileLines;
+        cache.set(file, lines);
+      }
+      return lines;
+    };
+  }, [data, event]);
+
+  const handleSearch = async () => {
+    const trimmed = query.trim();
+    if (!trimmed || !scope) return;
+    const id = ++searchId.current;
+    setIsSearching(true);
+    setError(null);
+    setStatus(null);
+    setFound([]);
+    setSearchedQuery(trimmed);
+
+    try {
+      const response = await fetch(`/api/source-search?q=${encodeURIComponent(trimmed)}&scope=${scope}`);
+      if (!response.ok || !response.body) {
+        setError('Search failed');
+        return;
+      }
+
+      const reader = response.body.getReader();
+      const decoder = new TextDecoder();
+      let buffer = '';
+      let all: FoundLine[] = [];
+      for (;;) {
+        const { done, value } = await reader.read();
+        if (done || id !== searchId.current) break;
+        buffer += decoder.decode(value, { stream: true });
+        const lines = buffer.split('\n');
+        buffer = lines.pop() || '';
+
+        const batch: FoundLine[] = [];
+        lines.filter(Boolean).forEach(line => {
+          const message = JSON.parse(line);
+          if (message.done) {
+            setStatus(message.indexed < message.total
+              ? `Indexing ${message.indexed.toLocaleString()} of ${message.total.toLocaleString()} files; results may be incomplete`
+              : null);
+            return;
+          }
+          const result = message as SourceSearchResult;
+          result.hits.forEach(hit => batch.push({ file: result.file, ...hit }));
+        });
+        if (batch.length > 0) {
+          all = [...all, ...batch];
+          setFound(all);
+        }
+      }
+    } catch (err) {
+      setError(err instanceof Error ? err.message : 'Search failed');
+    } finally {
+      if (id === searchId.current) setIsSearching(false);
+    }
+  };
+
+  // Join each hit with its line cost and rank by heat; re-ranked as more results stream in
+  const hits = useMemo((): RankedHit[] => found
+    .map(hit => {
+      const lineCost = lineCosts(hit.file).get(hit.line);
+      return { ...hit, cost: lineCost?.cost || 0, functionName: lineCost?.functionName };
+    })
+    .sort((a, b) => b.cost - a.cost), [found, lineCosts]);
+
+  const maxCost = hits[0]?.cost || 1;
+
+  return (
+    <div className="bg-white rounded-xl shadow-sm p-6 border border-gray-100">
+      <div className="flex items-center justify-between mb-4">
+        <div className="flex items-center gap-2">
+          <FileSearch className="w-5 h-5 text-teal-600" />
+          <h3 className="text-lg font-semibold text-gray-800">Source Search</h3>
+        </div>
+        <select
+          value={event}
+          onChange={(e) => setEvent(e.target.value)}
+          className="px-2 py-1 text-sm border border-gray-300 rounded focus:outline-none focus:ring-2 focus:ring-blue-500"
+        >
+          {data.events.map(e => <option key={e} value={e}>{e}</option>)}
+        </select>
+      </div>
+
+      <div className="flex gap-2 mb-4">
+        <input
+          type="text"
+          value={query}
+          onChange={(e) => setQuery(e.target.value)}
+          onKeyDown={(e) => { if (e.key === 'Enter') handleSearch(); }}
+          placeholder="Search source text, e.g. memcpy"
+          className="flex-1 px-3 py-1.5 border border-gray-300 rounded-lg focus:outline-none focus:ring-2 focus:ring-blue-500 font-mono text-sm"
+        />
+        <button
+          onClick={handleSearch}
+          disabled={isSearching || !query.trim() || !scope}
+          className="px-4 py-1.5 bg-blue-500 text-white rounded-lg hover:bg-blue-600 transition-colors text-sm disabled:opacity-50"
+        >
+          {isSearching ? 'Searching...' : 'Search'}
+        </button>
+      </div>
+
+      {error && (
+        <div className="flex items-center gap-2 text-red-600 text-sm mb-4">
+          <AlertCircle className="w-4 h-4" />
+          {error}
+        </div>
+      )}
+      {status && <p className="text-xs text-amber-700 mb-2">{status}</p>}
+
+      {hits.length > 0 && (
+        <div className="overflow-x-auto max-h-96 overflow-y-auto">
+          <div className="text-sm text-gray-600 mb-2">
+            {hits.length.toLocaleString()} matching lines, hottest first
+            {hits.length > MAX_SHOWN && ` (showing ${MAX_SHOWN})`}
+          </div>
+          <table className="w-full">
+            <thead className="sticky top-0 bg-white">
+              <tr className="border-b border-gray-200">
+                <th className="text-left py-2 px-3 text-sm font-medium text-gray-700">Line</th>
+                <th className="text-left py-2 px-3 text-sm font-medium text-gray-700">Source</th>
+                <th className="text-right py-2 px-3 text-sm font-medium text-gray-700">{event}</th>
+              </tr>
+            </thead>
+            <tbody>
+              {hits.slice(0, MAX_SHOWN).map(hit => (
+                <tr key={`${hit.file}:${hit.line}`} className="border-b border-gray-100 hover:bg-gray-50">
+                  <td className="py-2 px-3 text-sm whitespace-nowrap">
+                    <button
+                      onClick={() => hit.functionName && onViewCode?.(hit.file, hit.functionName, hit.line)}
+                      className={cn(
+                        "font-mono text-xs",
+                        hit.functionName && onViewCode ? "hover:underline text-blue-700" : "cursor-default text-gray-600"
+                      )}
+                      title={hit.functionName ? `${hit.file} (${hit.functionName})` : hit.file}
+                    >
+                      {hit.file.split('/').pop() || hit.file}:{hit.line}
+                    </button>
+                  </td>
+                  <td className="py-2 px-3 text-xs text-gray-700 font-mono truncate max-w-lg" title={hit.text}>
+                    {hit.text}
+                  </td>
+                  <td className="py-2 px-3 text-sm text-right text-gray-800">
+                    {hit.cost > 0 ? (
+                      <div className="flex items-center justify-end gap-2">
+                        <div className="w-16 bg-gray-100 rounded h-2 overflow-hidden">
+                          <div className="bg-red-400 h-2" style={{ width: `${(hit.cost / maxCost) * 100}%` }} />
+                        </div>
+                        {hit.cost.toLocaleString()}
+                      </div>
+                    ) : (
+                      <span className="text-gray-400">-</span>
+                    )}
+                  </td>
+                </tr>
+              ))}
+            </tbody>
+          </table>
+        </div>
+      )}
+      {!isSearching && hits.length === 0 && searchedQuery && !error && (
+        <p className="text-sm text-gray-500">No matches for &quot;{searchedQuery}&quot; in the indexed sources.</p>
+      )}
+    </div>
+  );
+}
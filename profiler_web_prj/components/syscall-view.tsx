@@ -0,0 +1,189 @@
+'use client';
+
+import { useMemo, useState } from 'react';
+import { HardDrive, ChevronRight } from 'lucide-react';
+import { CachegrindData } from '@/types/profiler';
+import { analyzeSyscalls } from '@/lib/syscall-analysis';
+import { cn } from '@/lib/utils';
+
+interface SyscallViewProps {
+  data: CachegrindData;
+  onViewCode?: (fileName: string, functionName: string) => void;
+}
+
+export function SyscallView({ data, onViewCode }: SyscallViewProps) {
+  const [rankBy, setRankBy] = useState<'sysTime' | 'sysCount'>(
+    data.events.includes('sysTime') ? 'sysTime' : 'sysCount'
+  );
+  const [showLibraries, setShowLibraries] = useState(false);
+
+  const analysis = useMemo(() => analyzeSyscalls(data), [data]);
+
+  const sites = useMemo(() => {
+    return [...analysis.sites]
+      .sort((a, b) => (b[rankBy] - a[rankBy]) || (b.sysCount - a.sysCount))
+      .slice(0, 50);
+  }, [analysis, rankBy]);
+
+  const functions = useMemo(() => {
+    return analysis.functions
+      .filter(f => showLibraries || f.isApplication)
+      .sort((a, b) => (b[rankBy] - a[rankBy]) || (b.sysCount - a.sysCount))
+      .slice(0, 50);
+  }, [analysis, rankBy, showLibraries]);
+
+  const unit = analysis.timeUnit ? ` ${analysis.timeUnit}` : '';
+  const formatTime = (value: number) => `${value.toLocaleString(undefined, { maximumFractionDigits: 2 })}${unit}`;
+  const share = (value: number, total: number) => total > 0 ? `${((value / total) * 100).toFixed(1)}%` : '-';
+
+  return (
+    <div className="bg-white rounded-xl shadow-sm p-6 border border-gray-100">
+      <div className="flex items-center justify-between mb-4">
+        <div className="flex items-center gap-2">
+          <HardDrive className="w-5 h-5 text-orange-600" />
+          <h3 className="text-lg font-semibold text-gray-800">System Call Analysis</h3>
+        </div>
+        <div className="flex items-center gap-2">
+          <span className="text-sm text-gray-600">Rank by:</span>
+          <select
+            value={rankBy}
+            onChange={(e) => setRankBy(e.target.value as 'sysTime' | 'sysCount')}
+            className="px-2 py-1 text-sm border border-gray-300 rounded focus:outline-none focus:ring-2 focus:ring-blue-500"
+          >
+            {data.events.includes('sysTime') && <option value="sysTime">System Time</option>}
+            <option value="sysCount">System Calls</option>
+          </select>
+        </div>
+      </div>
+
+      {/* Totals */}
+      <div className="grid grid-cols-2 md:grid-cols-4 gap-4 mb-6">
+        <div className="bg-orange-50 rounded-lg p-4">
+          <div className="text-sm text-gray-600 mb-1">System Calls</div>
+          <div className="text-2xl font-bold text-gray-800">{analysis.totalSysCount.toLocaleString()}</div>
+        </div>
+        <div className="bg-orange-50 rounded-lg p-4">
+          <div className="text-sm text-gray-600 mb-1">System Time</div>
+          <div className="text-2xl font-bold text-gray-800">{formatTime(analysis.totalSysTime)}</div>
+        </div>
+        <div className="bg-gray-50 rounded-lg p-4">
+          <div className="text-sm text-gray-600 mb-1">Time per Syscall</div>
+          <div className="text-2xl font-bold text-gray-800">
+            {analysis.totalSysCount > 0 ? formatTime(analysis.totalSysTime / analysis.totalSysCount) : '-'}
+          </div>
+        </div>
+        <div className="bg-gray-50 rounded-lg p-4">
+          <div className="text-sm text-gray-600 mb-1">Outside Application</div>
+          <div className="text-2xl font-bold text-gray-800">
+            {share(rankBy === 'sysTime' ? analysis.unattributedSysTime : analysis.unattributedSysCount,
+                   rankBy === 'sysTime' ? analysis.totalSysTime : analysis.totalSysCount)}
+          </div>
+          <div className="text-xs text-gray-500 mt-1">e.g. dynamic loader startup</div>
+        </div>
+      </div>
+
+      {/* Application call sites */}
+      <h4 className="text-sm font-semibold text-gray-600 mb-3">Application Call Paths</h4>
+      {sites.length === 0 ? (
+        <p className="text-sm text-gray-500 mb-6">No system calls were reached from application code.</p>
+      ) : (
+        <div className="overflow-x-auto max-h-96 overflow-y-auto mb-6">
+          <table className="w-full">
+            <thead className="sticky top-0 bg-white">
+              <tr className="border-b border-gray-200">
+                <th className="text-left py-2 px-3 text-sm font-medium text-gray-700">Call Path</th>
+                <th className="text-right py-2 px-3 text-sm font-medium text-gray-700">Calls</th>
+                <th className="text-right py-2 px-3 text-sm font-medium text-gray-700">Syscalls</th>
+                <th className="text-right py-2 px-3 text-sm font-medium text-gray-700">Time</th>
+                <th className="text-right py-2 px-3 text-sm font-medium text-gray-700">Time/Syscall</th>
+              </tr>
+            </thead>
+            <tbody>
+              {sites.map((site, index) => (
+                <tr key={`${site.caller.key}-${site.entry?.key || 'self'}-${index}`} className="border-b border-gray-100 hover:bg-gray-50">
+                  <td className="py-2 px-3 text-sm text-gray-800">
+                    <div className="flex items-center flex-wrap gap-1">
+                      {site.path.map((node, i) => (
+                        <span key={node.key} className="flex items-center gap-1">
+                          {i > 0 && <ChevronRight className="w-3 h-3 text-gray-400" />}
+                          <button
+                            onClick={() => onViewCode?.(node.file, node.functionName)}
+                            className={cn(
+                              "font-mono text-xs",
+                              onViewCode ? "hover:underline text-blue-700" : "cursor-default",
+                              node === site.caller && "font-semibold"
+                            )}
+                            title={node.file}
+                          >
+                            {node.functionName}
+                          </button>
+                        </span>
+                      ))}
+                      <ChevronRight className="w-3 h-3 text-gray-400" />
+                      <span className="font-mono text-xs text-gray-500" title={site.entry?.objectFile}>
+                        {site.entry ? site.entry.functionName : '(direct syscall)'}
+                      </span>
+                    </div>
+                  </td>
+                  <td className="py-2 px-3 text-sm text-right text-gray-600">{site.calls > 0 ? site.calls.toLocaleString() : '-'}</td>
+                  <td className="py-2 px-3 text-sm text-right text-gray-800">{Math.round(site.sysCount).toLocaleString()}</td>
+                  <td className="py-2 px-3 text-sm text-right text-gray-800">{formatTime(site.sysTime)}</td>
+                  <td className="py-2 px-3 text-sm text-right text-gray-600">
+                    {site.sysCount > 0 ? formatTime(site.timePerSyscall) : '-'}
+                  </td>
+                </tr>
+              ))}
+            </tbody>
+          </table>
+        </div>
+      )}
+
+      {/* Inclusive ranking */}
+      <div className="flex items-center justify-between mb-3">
+        <h4 className="text-sm font-semibold text-gray-600">Functions by Inclusive System Cost</h4>
+        <label className="flex items-center gap-2 text-sm text-gray-600">
+          <input
+            type="checkbox"
+            checked={showLibraries}
+            onChange={(e) => setShowLibraries(e.target.checked)}
+            className="rounded"
+          />
+          Include library functions
+        </label>
+      </div>
+      <div className="overflow-x-auto max-h-96 overflow-y-auto">
+        <table className="w-full">
+          <thead className="sticky top-0 bg-white">
+            <tr className="border-b border-gray-200">
+              <th className="text-left py-2 px-3 text-sm font-medium text-gray-700">Function</th>
+              <th className="text-right py-2 px-3 text-sm font-medium text-gray-700">Syscalls</th>
+              <th className="text-right py-2 px-3 text-sm font-medium text-gray-700">Time</th>
+              <th className="text-right py-2 px-3 text-sm font-medium text-gray-700">Share</th>
+              <th className="text-right py-2 px-3 text-sm font-medium text-gray-700">Time/Syscall</th>
+            </tr>
+          </thead>
+          <tbody>
+            {functions.map(func => (
+              <tr key={func.node.key} className="border-b border-gray-100 hover:bg-gray-50">
+                <td className="py-2 px-3 text-sm text-gray-800">
+                  <span className="font-mono text-xs">{func.node.functionName}</span>
+                  <span className="ml-2 text-xs text-gray-400">
+                    ({func.node.file.split('/').pop() || func.node.file})
+                  </span>
+                </td>
+                <td className="py-2 px-3 text-sm text-right text-gray-800">{func.sysCount.toLocaleString()}</td>
+                <td className="py-2 px-3 text-sm text-right text-gray-800">{formatTime(func.sysTime)}</td>
+                <td className="py-2 px-3 text-sm text-right text-gray-600">
+                  {rankBy === 'sysTime' ? share(func.sysTime, analysis.totalSysTime) : share(func.sysCount, analysis.totalSysCount)}
+                </td>
+                <td className="py-2 px-3 text-sm text-right text-gray-600">
+                  {func.sysCount > 0 ? formatTime(func.timePerSyscall) : '-'}
+                </td>
+              </tr>
+            ))}
+          </tbody>
+        </table>
+      </div>
+    </div>
+  );
+}
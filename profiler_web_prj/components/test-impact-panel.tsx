@@ -0,0 +1,150 @@
+'use client';
+
+import { useState } from 'react';
+import { Target, AlertCircle } from 'lucide-react';
+import { queryTestImpact, selectImpactedRuns } from '@/app/actions/test-impact';
+import { ImpactSelection, ImpactTarget, RunCost } from '@/lib/test-impact';
+
+interface TestImpactPanelProps {
+  directory: string;
+}
+
+const formatTarget = (target: ImpactTarget) =>
+  [target.file, target.functionName ?? target.line].filter(part => part !== undefined).join(':');
+
+export function TestImpactPanel({ directory }: TestImpactPanelProps) {
+  const [targetInput, setTargetInput] = useState('');
+  const [isLoading, setIsLoading] = useState(false);
+  const [error, setError] = useState<string | null>(null);
+  const [result, setResult] = useState<{ runs: RunCost[]; costEvent: string; runCount: number; elapsedMs: number } | null>(null);
+  const [selection, setSelection] = useState<ImpactSelection | null>(null);
+
+  const targets = targetInput.split('\n').map(t => t.trim()).filter(Boolean);
+
+  const handleQuery = async () => {
+    if (targets.length === 0) return;
+    setIsLoading(true);
+    setError(null);
+    try {
+      if (targets.length === 1) {
+        const response = await queryTestImpact(directory, targets[0]);
+        if (response.success && response.runs) {
+          setResult({
+            runs: response.runs,
+            costEvent: response.costEvent || '',
+            runCount: response.runCount || 0,
+            elapsedMs: response.elapsedMs || 0
+          });
+          setSelection(null);
+        } else {
+          setError(response.error || 'Query failed');
+        }
+      } else {
+        const response = await selectImpactedRuns(directory, targets);
+        if (response.success && response.selection) {
+          setSelection(response.selection);
+          setResult(null);
+        } else {
+          setError(response.error || 'Selection failed');
+        }
+      }
+    } finally {
+      setIsLoading(false);
+    }
+  };
+
+  const maxCost = result?.runs[0]?.cost || 1;
+
+  return (
+    <div className="bg-white rounded-xl shadow-lg border border-gray-200">
+      <div className="flex items-center gap-3 px-6 py-4 border-b border-gray-200">
+        <Target className="w-5 h-5 text-gray-600" />
+        <h3 className="text-lg font-semibold text-gray-800">Test Impact</h3>
+      </div>
+      <div className="p-6">
+        <div className="flex gap-2 mb-2">
+          <textarea
+            value={targetInput}
+            onChange={(e) => setTargetInput(e.target.value)}
+            rows={Math.min(6, Math.max(1, targets.length))}
+            placeholder="function, file.c:function or file.c:line (one per line)"
+            className="flex-1 px-3 py-2 border border-gray-300 rounded-lg focus:outline-none focus:ring-2 focus:ring-blue-500 font-mono text-sm"
+          />
+          <button
+            onClick={handleQuery}
+            disabled={isLoading || targets.length === 0}
+            className="px-4 py-1.5 h-fit bg-blue-500 text-white rounded-lg hover:bg-blue-600 transition-colors text-sm disabled:opacity-50"
+          >
+            {targets.length > 1 ? 'Select Runs' : 'Find Runs'}
+          </button>
+        </div>
+        <p className="text-xs text-gray-500 mb-4">
+          CI scripts can use the same index via GET /api/test-impact?target=... or POST /api/test-impact with {'{"targets": [...]}'}.
+        </p>
+
+        {error && (
+          <div className="flex items-center gap-2 text-red-600 text-sm mb-4">
+            <AlertCircle className="w-4 h-4" />
+            {error}
+          </div>
+        )}
+
+        {result && (
+          <div>
+            <div className="text-sm text-gray-600 mb-2">
+              {result.runs.length.toLocaleString()} of {result.runCount.toLocaleString()} runs execute this
+              <span className="text-gray-400"> ({result.elapsedMs.toFixed(2)} ms)</span>
+            </div>
+            <div className="max-h-96 overflow-y-auto">
+              <table className="w-full">
+                <thead className="sticky top-0 bg-white">
+                  <tr className="border-b border-gray-200">
+                    <th className="text-left py-2 px-3 text-sm font-medium text-gray-700">Run</th>
+                    <th className="text-right py-2 px-3 text-sm font-medium text-gray-700">Calls</th>
+                    <th className="text-right py-2 px-3 text-sm font-medium text-gray-700">{result.costEvent}</th>
+                  </tr>
+                </thead>
+                <tbody>
+                  {result.runs.map(run => (
+                    <tr key={run.run} className="border-b border-gray-100 hover:bg-gray-50">
+                      <td className="py-2 px-3 text-sm text-gray-800 font-mono">{run.run}</td>
+                      <td className="py-2 px-3 text-sm text-right text-gray-600">
+                        {run.calls !== undefined ? run.calls.toLocaleString() : '-'}
+                      </td>
+                      <td className="py-2 px-3 text-sm text-right text-gray-800">
+                        <div className="flex items-center justify-end gap-2">
+                          <div className="w-16 bg-gray-100 rounded h-2 overflow-hidden">
+                            <div className="bg-blue-400 h-2" style={{ width: `${(run.cost / maxCost) * 100}%` }} />
+                          </div>
+                          {run.cost.toLocaleString()}
+                        </div>
+                      </td>
+                    </tr>
+                  ))}
+                </tbody>
+              </table>
+            </div>
+          </div>
+        )}
+
+        {selection && (
+          <div className="space-y-3 text-sm">
+            <div>
+              <div className="font-medium text-gray-700 mb-1">
+                Rerun {selection.runs.length} {selection.runs.length === 1 ? 'run' : 'runs'} to cover {selection.covered.length} of {selection.covered.length + selection.uncovered.length} targets
+              </div>
+              <ul className="font-mono text-gray-800 space-y-0.5">
+                {selection.runs.map(run => <li key={run}>{run}</li>)}
+              </ul>
+            </div>
+            {selection.uncovered.length > 0 && (
+              <div className="text-red-700">
+                Not executed by any run: <span className="font-mono">{selection.uncovered.map(formatTarget).join(', ')}</span>
+              </div>
+            )}
+          </div>
+        )}
+      </div>
+    </div>
+  );
+}
@@ -0,0 +1,67 @@
+'use client';
+
+import { ReactNode, useEffect, useRef, useState } from 'react';
+import { cn } from '@/lib/utils';
+
+interface VirtualListProps {
+  count: number;
+  rowHeight: number; // every row must render at exactly this height
+  renderRow: (index: number) => ReactNode;
+  overscan?: number; // rows rendered above and below the visible window
+  resetKey?: string; // scroll back to the top when this changes
+  className?: string;
+}
+
+// Browsers cap element height (about 17.9M px in Firefox, 33.5M px in Chrome)
+const MAX_SCROLL_HEIGHT = 8_000_000;
+
+/**
+ * Scroll container that only mounts the rows in view, so lists with
+ * hundreds of thousands of rows scroll without paging. Past
+ * MAX_SCROLL_HEIGHT the scroll range is scaled down and the scroll
+ * position maps proportionally onto the rows, so the end of a list with
+ * millions of rows stays reachable.
+ */
+export function VirtualList({ count, rowHeight, renderRow, overscan = 10, resetKey, className }: VirtualListProps) {
+  const containerRef = useRef<HTMLDivElement>(null);
+  const [scrollTop, setScrollTop] = useState(0);
+  const [viewportHeight, setViewportHeight] = useState(0);
+
+  useEffect(() => {
+    const container = containerRef.current;
+    if (!container) return;
+    const observer = new ResizeObserver(entries => setViewportHeight(entries[0].contentRect.height));
+    observer.observe(container);
+    return () => observer.disconnect();
+  }, []);
+
+  useEffect(() => {
+    if (containerRef.current) containerRef.current.scrollTop = 0;
+    setScrollTop(0);
+  }, [resetKey]);
+
+  const contentHeight = count * rowHeight;
+  const height = Math.min(contentHeight, MAX_SCROLL_HEIGHT);
+  // Offset into the full list that the top of the viewport shows
+  const offset = height < contentHeight && height > viewportHeight
+    ? scrollTop * (contentHeight - viewportHeight) / (height - viewportHeight)
+    : scrollTop;
+  const first = Math.max(0, Math.floor(offset / rowHeight) - overscan);
+  const last = Math.min(count, Math.ceil((offset + viewportHeight) / rowHeight) + overscan);
+  const rows: ReactNode[] = [];
+  for (let i = first; i < last; i++) rows.push(renderRow(i));
+
+  return (
+    <div
+      ref={containerRef}
+      className={cn("overflow-y-auto", className)}
+      onScroll={(e) => setScrollTop(e.currentTarget.scrollTop)}
+    >
+      <div style={{ height, position: 'relative', overflow: 'hidden' }}>
+        <div style={{ position: 'absolute', top: scrollTop + first * rowHeight - offset, left: 0, right: 0 }}>
+          {rows}
+        </div>
+      </div>
+    </div>
+  );
+}
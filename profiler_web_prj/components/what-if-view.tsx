@@ -0,0 +1,234 @@
+'use client';
+
+import { useMemo, useState } from 'react';
+import { Gauge, X } from 'lucide-react';
+import { CachegrindData } from '@/types/profiler';
+import { buildCallGraph } from '@/lib/call-graph';
+import { WhatIfAdjustment, WhatIfModel } from '@/lib/what-if';
+import { cn } from '@/lib/utils';
+
+interface WhatIfViewProps {
+  data: CachegrindData;
+  onViewCode?: (fileName: string, functionName: string, line?: number) => void;
+}
+
+const MAX_HOTSPOTS = 15;
+const MAX_SUGGESTIONS = 500;
+const MAX_FACTOR = 20;
+
+let nextAdjustmentId = 0;
+
+export function WhatIfView({ data, onViewCode }: WhatIfViewProps) {
+  const graph = useMemo(() => buildCallGraph(data), [data]);
+  const [event, setEvent] = useState(() => data.events.includes('Cy') ? 'Cy' : (data.events.includes('Ir') ? 'Ir' : data.events[0]));
+  const model = useMemo(() => new WhatIfModel(graph, event), [graph, event]);
+  const [adjustments, setAdjustments] = useState<WhatIfAdjustment[]>([]);
+  const [query, setQuery] = useState('');
+
+  // Heaviest functions by self cost, offered as "name — file" completions
+  const suggestions = useMemo(() => model.nodes
+    .map((node, i) => ({ node, self: model.baseSelf(i) }))
+    .filter(({ node, self }) => node.data && self > 0)
+    .sort((a, b) => b.self - a.self)
+    .slice(0, MAX_SUGGESTIONS)
+    .map(({ node }) => node), [model]);
+  const objects = useMemo(() => Array.from(new Set(model.nodes.map(node => node.objectFile).filter((o): o is string => !!o))).sort(), [model]);
+
+  // Incremental: only functions whose saving changed are propagated to their ancestors
+  const result = useMemo(() => {
+    model.apply(adjustments);
+    return {
+      total: model.newTotal,
+      bestCase: model.bestCaseTotal(adjustments),
+      hotspots: model.topHotspots(MAX_HOTSPOTS)
+    };
+  }, [model, adjustments]);
+
+  const targetSelf = (adjustment: WhatIfAdjustment) => {
+    const { target } = adjustment;
+    if (target.kind === 'function') {
+      const i = model.indexOf(target.key);
+      return i !== undefined ? model.baseSelf(i) : 0;
+    }
+    return model.nodes.reduce((sum, node, i) => node.objectFile === target.objectFile ? sum + model.baseSelf(i) : sum, 0);
+  };
+
+  const addFunction = () => {
+    const text = query.trim();
+    const node = suggestions.find(n => `${n.functionName} — ${n.file}` === text)
+      || model.nodes.find(n => n.functionName === text && n.data);
+    if (!node) return;
+    setAdjustments(current => [...current, { id: nextAdjustmentId++, target: { kind: 'function', key: node.key }, mode: 'factor', value: 2 }]);
+    setQuery('');
+  };
+
+  const addObject = (objectFile: string) => {
+    if (!objectFile) return;
+    setAdjustments(current => [...current, { id: nextAdjustmentId++, target: { kind: 'object', objectFile }, mode: 'factor', value: 2 }]);
+  };
+
+  const update = (id: number, change: Partial<WhatIfAdjustment>) =>
+    setAdjustments(current => current.map(a => a.id === id ? { ...a, ...change } : a));
+
+  const base = model.baseTotal;
+  const speedup = (total: number) => total > 0 ? `${(base / total).toFixed(2)}×` : '∞';
+  const percent = (value: number) => base > 0 ? `${((value / base) * 100).toFixed(2)}%` : '-';
+
+  return (
+    <div className="bg-white rounded-xl shadow-sm p-6 border border-gray-100">
+      <div className="flex items-center justify-between mb-4">
+        <div className="flex items-center gap-2">
+          <Gauge className="w-5 h-5 text-indigo-600" />
+          <h3 className="text-lg font-semibold text-gray-800">What-if Speedup</h3>
+        </div>
+        <select
+          value={event}
+          onChange={(e) => setEvent(e.target.value)}
+          className="px-2 py-1 text-sm border border-gray-300 rounded focus:outline-none focus:ring-2 focus:ring-blue-500"
+        >
+          {data.events.map(e => <option key={e} value={e}>{e}</option>)}
+        </select>
+      </div>
+      <p className="text-xs text-gray-500 mb-3">
+        Speed up functions or whole objects and see the effect on the total, on callers&apos; inclusive cost and on
+        the hotspot list. Savings reach each caller in proportion to the cost its calls account for.
+      </p>
+
+      <div className="flex items-center gap-2 mb-3">
+        <input
+          type="text"
+          list="what-if-functions"
+          value={query}
+          onChange={(e) => setQuery(e.target.value)}
+          onKeyDown={(e) => e.key === 'Enter' && addFunction()}
+          placeholder="Function name"
+          className="flex-1 px-2 py-1.5 text-sm border border-gray-300 rounded font-mono focus:outline-none focus:ring-2 focus:ring-blue-500"
+        />
+        <datalist id="what-if-functions">
+          {suggestions.map(node => <option key={node.key} value={`${node.functionName} — ${node.file}`} />)}
+        </datalist>
+        <button
+          onClick={addFunction}
+          disabled={!query.trim()}
+          className="px-4 py-1.5 bg-blue-500 text-white rounded-lg hover:bg-blue-600 transition-colors text-sm disabled:opacity-50"
+        >
+          Add function
+        </button>
+        <select
+          value=""
+          onChange={(e) => addObject(e.target.value)}
+          className="px-2 py-1.5 text-sm border border-gray-300 rounded focus:outline-none focus:ring-2 focus:ring-blue-500 max-w-xs"
+        >
+          <option value="">Add object...</option>
+          {objects.map(o => <option key={o} value={o}>{o.split('/').pop()}</option>)}
+        </select>
+      </div>
+
+      {adjustments.length > 0 && (
+        <div className="space-y-2 mb-4">
+          {adjustments.map(adjustment => {
+            const self = targetSelf(adjustment);
+            const name = adjustment.target.kind === 'function'
+              ? graph.nodes.get(adjustment.target.key)?.functionName
+              : adjustment.target.objectFile.split('/').pop();
+            return (
+              <div key={adjustment.id} className="flex items-center gap-3 text-sm">
+                <span className="w-56 truncate font-mono text-xs text-gray-800" title={name}>
+                  {adjustment.target.kind === 'object' && <span className="text-gray-400">object </span>}{name}
+                </span>
+                <select
+                  value={adjustment.mode}
+                  onChange={(e) => {
+                    const mode = e.target.value as WhatIfAdjustment['mode'];
+                    update(adjustment.id, { mode, value: mode === 'factor' ? 2 : Math.round(self / 2) });
+                  }}
+                  className="px-1 py-0.5 text-xs border border-gray-300 rounded"
+                >
+                  <option value="factor">speedup</option>
+                  <option value="reduction">reduce by</option>
+                </select>
+                <input
+                  type="range"
+                  min={adjustment.mode === 'factor' ? 1 : 0}
+                  max={adjustment.mode === 'factor' ? MAX_FACTOR : Math.max(self, 1)}
+                  step={adjustment.mode === 'factor' ? 0.1 : Math.max(1, Math.round(self / 200))}
+                  value={adjustment.value}
+                  onChange={(e) => update(adjustment.id, { value: parseFloat(e.target.value) })}
+                  className="flex-1"
+                />
+                <span className="w-32 text-right text-gray-700">
+                  {adjustment.mode === 'factor' ? `${adjustment.value.toFixed(1)}×` : `${adjustment.value.toLocaleString()} ${event}`}
+                </span>
+                <span className="w-24 text-right text-xs text-gray-500" title={`Self ${event}`}>{percent(self)}</span>
+                <button
+                  onClick={() => setAdjustments(current => current.filter(a => a.id !== adjustment.id))}
+                  className="p-1 text-gray-400 hover:text-gray-700"
+                  title="Remove"
+                >
+                  <X className="w-4 h-4" />
+                </button>
+              </div>
+            );
+          })}
+        </div>
+      )}
+
+      <div className="grid grid-cols-3 gap-4 mb-4">
+        <div className="rounded-lg border border-gray-100 p-3">
+          <div className="text-xs text-gray-500">Total {event}</div>
+          <div className="text-lg font-semibold text-gray-800">{Math.round(result.total).toLocaleString()}</div>
+          <div className="text-xs text-gray-500">from {base.toLocaleString()}</div>
+        </div>
+        <div className="rounded-lg border border-gray-100 p-3">
+          <div className="text-xs text-gray-500">Speedup</div>
+          <div className={cn("text-lg font-semibold", result.total < base ? "text-green-600" : "text-gray-800")}>
+            {speedup(result.total)}
+          </div>
+          <div className="text-xs text-gray-500">saves {percent(base - result.total)}</div>
+        </div>
+        <div className="rounded-lg border border-gray-100 p-3" title="If the chosen functions and objects cost nothing">
+          <div className="text-xs text-gray-500">Best case (Amdahl)</div>
+          <div className="text-lg font-semibold text-gray-800">{speedup(result.bestCase)}</div>
+          <div className="text-xs text-gray-500">{Math.round(result.bestCase).toLocaleString()} {event}</div>
+        </div>
+      </div>
+
+      <div className="overflow-x-auto max-h-[24rem] overflow-y-auto">
+        <table className="w-full">
+          <thead className="sticky top-0 bg-white">
+            <tr className="border-b border-gray-200">
+              <th className="text-left py-2 px-3 text-sm font-medium text-gray-700">Hotspot</th>
+              <th className="text-right py-2 px-3 text-sm font-medium text-gray-700">Self</th>
+              <th className="text-right py-2 px-3 text-sm font-medium text-gray-700">New self</th>
+              <th className="text-right py-2 px-3 text-sm font-medium text-gray-700">Share</th>
+              <th className="text-right py-2 px-3 text-sm font-medium text-gray-700">New inclusive</th>
+            </tr>
+          </thead>
+          <tbody>
+            {result.hotspots.map(hotspot => (
+              <tr key={hotspot.node.key} className="border-b border-gray-100 hover:bg-gray-50">
+                <td className="py-2 px-3 text-xs font-mono text-gray-800">
+                  <button
+                    onClick={() => onViewCode?.(hotspot.node.file, hotspot.node.functionName, hotspot.node.data?.startLine)}
+                    className={cn(onViewCode ? "hover:underline text-blue-700" : "cursor-default")}
+                    title={hotspot.node.file}
+                  >
+                    {hotspot.node.functionName}
+                  </button>
+                </td>
+                <td className="py-2 px-3 text-sm text-right text-gray-600">{hotspot.self.toLocaleString()}</td>
+                <td className={cn("py-2 px-3 text-sm text-right", hotspot.newSelf < hotspot.self ? "text-green-600 font-medium" : "text-gray-800")}>
+                  {Math.round(hotspot.newSelf).toLocaleString()}
+                </td>
+                <td className="py-2 px-3 text-sm text-right text-gray-600">
+                  {result.total > 0 ? `${((hotspot.newSelf / result.total) * 100).toFixed(2)}%` : '-'}
+                </td>
+                <td className="py-2 px-3 text-sm text-right text-gray-600">{Math.round(hotspot.newInclusive).toLocaleString()}</td>
+              </tr>
+            ))}
+          </tbody>
+        </table>
+      </div>
+    </div>
+  );
+}
@@ -0,0 +1,116 @@
+import { AssemblyInstruction } from '@/types/profiler';
+import { alignSequences, fnv1a } from './line-alignment';
+
+/**
+ * Instruction-level diff of one function between two builds. Instructions
+ * are compared on their normalized text, optionally ignoring addresses
+ * (branch targets, symbol offsets) and register allocation, then aligned
+ * with the same Myers diff used for source lines.
+ */
+
+export interface AssemblyDiffOptions {
+  ignoreAddresses: boolean;
+  ignoreRegisters: boolean;
+}
+
+export type AssemblyDiffKind = 'same' | 'changed' | 'removed' | 'added';
+
+export interface AssemblyDiffRow {
+  kind: AssemblyDiffKind;
+  base?: AssemblyInstruction;
+  head?: AssemblyInstruction;
+}
+
+const CACHE_LIMIT = 200;
+
+// x86 (%rax), AArch64 (x0, w1, sp, d2) and RISC-V ABI (a0, s1, ft0) register names
+const REGISTER_PATTERN = /%[a-z][a-z0-9]*|\b(?:[xwbhsdqv]\d+|[xw]zr|w?sp|zero|ra|gp|tp|[ast]\d+|f[ast]\d+)\b/g;
+
+/**
+ * Text an instruction is compared by: mnemonic and operands without the
+ * encoding bytes or trailing comments.
+ */
+export function normalizeInstruction(instruction: string, options: AssemblyDiffOptions): string {
+  const parts = instruction.split('\t');
+  let text = (parts.length > 1 ? parts.slice(1).join(' ') : parts[0]).trim();
+  text = text.replace(/\s+(#|\/\/|;).*$/, '').replace(/\s+/g, ' ');
+  if (options.ignoreAddresses) {
+    // Branch targets ("401140 <main+0x1a>"), PC-relative displacements and
+    // absolute addresses move with every layout change
+    text = text.replace(/<([^>+]*)(\+0x[0-9a-f]+)?>/g, '<$1>')
+      .replace(/-?0x[0-9a-f]+\(%rip\)/g, 'ADDR(%rip)')
+      .replace(/(^|[\s,])(?:0x)?[0-9a-f]{4,}(?=\s|,|$|<)/g, '$1ADDR');
+  }
+  if (options.ignoreRegisters) {
+    text = text.replace(REGISTER_PATTERN, 'R');
+  }
+  return text.toLowerCase();
+}
+
+const cache = new Map<string, AssemblyDiffRow[]>();
+
+/**
+ * Align the two instruction streams. Unmatched instructions between two
+ * matches are paired up as changed, and the rest are removed or added.
+ * Streams too far apart for the diff are compared by position instead.
+ * Results are cached by the pair of instruction streams and options.
+ */
+export function diffAssembly(
+  base: AssemblyInstruction[],
+  head: AssemblyInstruction[],
+  options: AssemblyDiffOptions
+): AssemblyDiffRow[] {
+  const streamKey = (instructions: AssemblyInstruction[]) => {
+    const text = instructions.map(inst => `${inst.pc} ${inst.instruction}`).join('\n');
+    return `${fnv1a(text)}:${text.length}`;
+  };
+  const key = `${streamKey(base)}|${streamKey(head)}|${options.ignoreAddresses}|${options.ignoreRegisters}`;
+  const cached = cache.get(key);
+  if (cached) return cached;
+
+  const ids = new Map<string, number>();
+  const toIds = (instructions: AssemblyInstruction[]) => Int32Array.from(instructions, inst => {
+    const text = normalizeInstruction(inst.instruction, options);
+    let id = ids.get(text);
+    if (id === undefined) {
+      id = ids.size;
+      ids.set(text, id);
+    }
+    return id;
+  });
+  const baseIds = toIds(base);
+  const headIds = toIds(head);
+  // Streams too different to align are compared position by position
+  const mapping = alignSequences(baseIds, headIds)
+    || Int32Array.from(baseIds, (id, i) => i < headIds.length && id === headIds[i] ? i : -1);
+
+  const rows: AssemblyDiffRow[] = [];
+  let removed: AssemblyInstruction[] = [];
+  let nextHead = 0;
+  const flush = (headEnd: number) => {
+    const added = head.slice(nextHead, headEnd);
+    for (let k = 0; k < Math.max(removed.length, added.length); k++) {
+      if (k < removed.length && k < added.length) rows.push({ kind: 'changed', base: removed[k], head: added[k] });
+      else if (k < removed.length) rows.push({ kind: 'removed', base: removed[k] });
+      else rows.push({ kind: 'added', head: added[k] });
+    }
+    removed = [];
+    nextHead = headEnd;
+  };
+
+  base.forEach((inst, i) => {
+    const j = mapping[i];
+    if (j < 0) {
+      removed.push(inst);
+      return;
+    }
+    flush(j);
+    rows.push({ kind: 'same', base: inst, head: head[j] });
+    nextHead = j + 1;
+  });
+  flush(head.length);
+
+  if (cache.size >= CACHE_LIMIT) cache.delete(cache.keys().next().value as string);
+  cache.set(key, rows);
+  return rows;
+}
@@ -1,6 +1,13 @@
-import { CachegrindData, FileCoverage, FunctionData, LineData, PcLineData, CallInfo } from '@/types/profiler';
+import { CachegrindData, FileCoverage, FunctionData, LineData, PcLineData, CallInfo, ParseGranularity } from '@/types/profiler';
 import { resolveSourcePath } from './path-utils';
 
+export interface CachegrindParseOptions {
+  // Detail kept per function: totals and calls only, plus per-line costs, plus per-instruction costs
+  granularity?: ParseGranularity;
+  // Keep full instruction detail for this one function regardless of granularity
+  detailFunction?: { file: string; functionName: string };
+}
+
 export class CachegrindParser {
   private events: string[] = [];
   private cmd: string = '';
@@ -20,15 +27,44 @@ export class CachegrindParser {
   private positions: string = 'line';
   private pendingCallFile?: string;
   private pendingCallFunction?: string;
+  private pendingCallObject?: string;
   private eventsOrder: string[] = [];
+  private eventDescriptions: Record<string, string> = {};
+  private granularity: ParseGranularity = 'instr';
+  private detailFunction?: { file: string; functionName: string };
+  // Executed flag per line for functions parsed without line data, so coverage stays available
+  private lineExecution = new Map<FunctionData, Map<number, boolean>>();
 
   constructor(
     private content: string,
-    sourceFiles?: Record<string, string>
+    sourceFiles?: Record<string, string>,
+    options?: CachegrindParseOptions
   ) {
     if (sourceFiles) {
       this.sourceFiles = sourceFiles;
     }
+    if (options?.granularity) {
+      this.granularity = options.granularity;
+    }
+    this.detailFunction = options?.detailFunction;
+  }
+
+  private granularityFor(file: string, functionName: string): ParseGranularity {
+    if (this.detailFunction
+      && this.detailFunction.file === file
+      && this.detailFunction.functionName === functionName) {
+      return 'instr';
+    }
+    return this.granularity;
+  }
+
+  private recordLineExecution(funcData: FunctionData, lineNum: number, executed: boolean) {
+    let lines = this.lineExecution.get(funcData);
+    if (!lines) {
+      lines = new Map();
+      this.lineExecution.set(funcData, lines);
+    }
+    lines.set(lineNum, (lines.get(lineNum) || false) || executed);
   }
 
   private getSourceCode(filePath: string): string | null {
@@ -60,6 +96,15 @@ export class CachegrindParser {
         continue;
       }
 
+      // Parse event descriptions (e.g. "event: sysTime : sysTime (elapsed ms)")
+      if (trimmedLine.startsWith('event:')) {
+        const match = trimmedLine.substring(6).match(/^\s*([^\s:=]+)\s*(?:=[^:]*)?:\s*(.+)$/);
+        if (match) {
+          this.eventDescriptions[match[1]] = match[2].trim();
+        }
+        continue;
+      }
+
       if (trimmedLine.startsWith('cmd:')) {
         this.cmd = trimmedLine.split(':', 2)[1].trim();
         continue;
@@ -87,7 +132,7 @@ export class CachegrindParser {
 
       // Also handle cob= (called object)
       if (trimmedLine.startsWith('cob=')) {
-        // For now, we can store it but not use it directly
+        this.pendingCallObject = trimmedLine.substring(4);
         continue;
       }
 
@@ -127,7 +172,7 @@ export class CachegrindParser {
               coveredLines: [],
               uncoveredLines: [],
               coveragePercentage: 0.0,
-              pcData: this.isCallgrind ? {} : undefined
+              pcData: this.isCallgrind && this.granularityFor(currentFile, currentFunction) === 'instr' ? {} : undefined
             };
           }
           // If function already exists, we'll accumulate the data
@@ -166,6 +211,7 @@ export class CachegrindParser {
           const pcMatch = pcParts[0].match(/^(0x[0-9a-fA-F]+)/);
           if (pcMatch && currentFunction && currentFile) {
             const sourcePc = pcMatch[1];
+            const sourceLine = parseInt(pcParts[1]);
             
             // Parse event counts from the rest of the line
             // Format: <caller_pc> <caller_line> <event_0> <event_1> ...
@@ -188,23 +234,42 @@ export class CachegrindParser {
             currentFuncData.calls.push({
               targetFile: this.pendingCallFile,
               targetFunction: this.pendingCallFunction,
+              targetObject: this.pendingCallObject,
               count: callCount,
               sourcePc: sourcePc,
+              ...(sourceLine > 0 ? { sourceLine } : {}),
               inclusiveEvents: Object.keys(inclusiveEvents).length > 0 ? inclusiveEvents : undefined
             });
             // Reset pending call info
             this.pendingCallFile = undefined;
             this.pendingCallFunction = undefined;
+            this.pendingCallObject = undefined;
           }
         }
         continue;
       }
       
-      // Handle jcnd=, jump=
+      // Handle jcnd=taken/executed target and jump=count target (--collect-jumps=yes).
+      // The next line is the position of the jump instruction and carries no cost.
       if (trimmedLine.startsWith('jcnd=') || trimmedLine.startsWith('jump=')) {
-        // Skip these for now, just consume the next line if it exists
-        if (i + 1 < lines.length && lines[i + 1].trim().match(/^0x[0-9a-fA-F]/)) {
-          i++; // Skip the next line
+        const sourceMatch = i + 1 < lines.length ? lines[i + 1].trim().match(/^0x[0-9a-fA-F]+/) : null;
+        if (sourceMatch) {
+          i++;
+          const funcData = currentFile && currentFunction ? this.filesData[currentFile].functions[currentFunction] : undefined;
+          const [counts, targetPc] = trimmedLine.substring(5).split(/\s+/);
+          if (funcData?.pcData && targetPc?.startsWith('0x')) {
+            const conditional = trimmedLine.startsWith('jcnd=');
+            const [first, second] = counts.split('/').map(x => parseInt(x) || 0);
+            if (!funcData.jumps) {
+              funcData.jumps = [];
+            }
+            funcData.jumps.push({
+              sourcePc: sourceMatch[0],
+              targetPc,
+              count: first,
+              ...(conditional ? { executed: second } : {})
+            });
+          }
         }
         continue;
       }
@@ -241,6 +306,16 @@ export class CachegrindParser {
                 idx < providedEventCounts.length ? providedEventCounts[idx] : 0
               );
               
+              // Function granularity: aggregate into totals and keep only the executed flag
+              if (this.granularityFor(currentFile, currentFunction) === 'function') {
+                const funcData = this.filesData[currentFile].functions[currentFunction];
+                eventCounts.forEach((count, idx) => {
+                  funcData.totals[this.events[idx]] += count;
+                });
+                this.recordLineExecution(funcData, lineNum, eventCounts.some(count => count > 0));
+                continue;
+              }
+              
               // Store in both line-based and PC-based structures
               const lineData: LineData = {};
               const pcLineData: PcLineData = {
@@ -293,6 +368,15 @@ export class CachegrindParser {
               const lineNum = parseInt(parts[0]);
               const eventCounts = parts.slice(1, this.events.length + 1).map(x => parseInt(x));
               
+              if (this.granularityFor(currentFile, currentFunction) === 'function') {
+                const funcData = this.filesData[currentFile].functions[currentFunction];
+                eventCounts.forEach((count, idx) => {
+                  funcData.totals[this.events[idx]] += count;
+                });
+                this.recordLineExecution(funcData, lineNum, eventCounts.some(count => count > 0));
+                continue;
+              }
+              
               const lineData: LineData = {};
               eventCounts.forEach((count, idx) => {
                 lineData[this.events[idx]] = count;
@@ -342,11 +426,14 @@ export class CachegrindParser {
         const funcCoveredLines = new Set<number>();
         const funcUncoveredLines = new Set<number>();
         
-        for (const [lineNumStr, lineData] of Object.entries(funcData.lines)) {
-          const lineNum = parseInt(lineNumStr);
+        const lineEntries: Array<[number, boolean]> = this.lineExecution.has(funcData)
+          ? Array.from(this.lineExecution.get(funcData)!.entries())
+          : Object.entries(funcData.lines).map(([lineNumStr, lineData]) => [parseInt(lineNumStr), lineData.executed]);
+        
+        for (const [lineNum, executed] of lineEntries) {
           maxLine = Math.max(maxLine, lineNum);
           
-          if (lineData.executed) {
+          if (executed) {
             coveredLineNumbers.add(lineNum);
             funcCoveredLines.add(lineNum);
           } else {
@@ -413,8 +500,10 @@ export class CachegrindParser {
       filesAnalyzed: Object.keys(fileCoverage).length,
       fileCoverage,
       summaryTotals: this.summary,
+      eventDescriptions: Object.keys(this.eventDescriptions).length > 0 ? this.eventDescriptions : undefined,
       cachegrindFile: '',
-      isCallgrind: this.isCallgrind
+      isCallgrind: this.isCallgrind,
+      granularity: this.granularity
     };
   }
 }
\ No newline at end of file
@@ -0,0 +1,345 @@
+import { CachegrindData, CallInfo, FunctionData } from '@/types/profiler';
+
+export interface CallGraphNode {
+  key: string; // `${file}:${functionName}`
+  file: string;
+  functionName: string;
+  objectFile?: string;
+  data?: FunctionData; // undefined for call targets that have no cost lines of their own
+  self: Record<string, number>;
+  inclusive: Record<string, number>;
+  callees: CallGraphEdge[];
+  callers: CallGraphEdge[];
+}
+
+export interface CallGraphEdge {
+  caller: CallGraphNode;
+  callee: CallGraphNode;
+  count: number;
+  sourcePc: string;
+  inclusive: Record<string, number>;
+  call: CallInfo;
+}
+
+export interface CallGraph {
+  nodes: Map<string, CallGraphNode>;
+  edges: CallGraphEdge[];
+  roots: CallGraphNode[]; // nodes that are never called
+}
+
+export function functionKey(file: string, functionName: string): string {
+  return `${file}:${functionName}`;
+}
+
+/**
+ * Build a function-level call graph from parsed profile data.
+ * Call targets that have no cost lines of their own get stub nodes so that
+ * every edge has both endpoints. Inclusive cost is self cost plus the
+ * inclusive cost of all non-self-recursive call edges, as callgrind reports it.
+ */
+export function buildCallGraph(data: CachegrindData): CallGraph {
+  const nodes = new Map<string, CallGraphNode>();
+  const edges: CallGraphEdge[] = [];
+
+  const getNode = (file: string, functionName: string, objectFile?: string): CallGraphNode => {
+    const key = functionKey(file, functionName);
+    let node = nodes.get(key);
+    if (!node) {
+      node = {
+        key,
+        file,
+        functionName,
+        objectFile,
+        self: {},
+        inclusive: {},
+        callees: [],
+        callers: []
+      };
+      nodes.set(key, node);
+    } else if (!node.objectFile && objectFile) {
+      node.objectFile = objectFile;
+    }
+    return node;
+  };
+
+  // First pass: one node per function with cost data
+  Object.entries(data.fileCoverage).forEach(([filename, fileData]) => {
+    Object.entries(fileData.functions || {}).forEach(([funcName, funcData]) => {
+      const node = getNode(filename, funcName, fileData.objectFile);
+      node.data = funcData;
+      node.self = { ...funcData.totals };
+    });
+  });
+
+  // Second pass: call edges
+  nodes.forEach(caller => {
+    caller.data?.calls?.forEach(call => {
+      if (!call.targetFunction) return;
+      const targetFile = call.targetFile || caller.file;
+      const targetObject = data.fileCoverage[targetFile]?.objectFile || call.targetObject || caller.objectFile;
+      const callee = getNode(targetFile, call.targetFunction, targetObject);
+      const edge: CallGraphEdge = {
+        caller,
+        callee,
+        count: call.count || 1,
+        sourcePc: call.sourcePc,
+        inclusive: call.inclusiveEvents || {},
+        call
+      };
+      edges.push(edge);
+      caller.callees.push(edge);
+      callee.callers.push(edge);
+    });
+  });
+
+  // Inclusive totals
+  nodes.forEach(node => {
+    const inclusive: Record<string, number> = { ...node.self };
+    node.callees.forEach(edge => {
+      if (edge.callee === node) return;
+      Object.entries(edge.inclusive).forEach(([event, value]) => {
+        inclusive[event] = (inclusive[event] || 0) + value;
+      });
+    });
+    node.inclusive = inclusive;
+  });
+
+  const roots = Array.from(nodes.values()).filter(node => node.callers.length === 0);
+
+  return { nodes, edges, roots };
+}
+
+/**
+ * Whether an object file is a shared library (libc, libstdc++, the dynamic
+ * loader, vdso, ...) rather than application code.
+ */
+export function isSharedLibraryObject(objectFile?: string): boolean {
+  if (!objectFile || objectFile === '???') return true;
+  const base = objectFile.split('/').pop() || objectFile;
+  return /\.so(\.[0-9.]+)?$/.test(base) || /^(ld-linux|ld\.so|linux-vdso|vdso)/.test(base);
+}
+
+/**
+ * Determine which object files contain application code. The object that
+ * holds `main` is preferred; otherwise every non-shared-library object counts.
+ */
+export function findApplicationObjects(graph: CallGraph): Set<string> {
+  const objects = new Set<string>();
+
+  graph.nodes.forEach(node => {
+    if (node.functionName === 'main' && node.objectFile && node.data) {
+      objects.add(node.objectFile);
+    }
+  });
+
+  if (objects.size === 0) {
+    graph.nodes.forEach(node => {
+      if (node.objectFile && !isSharedLibraryObject(node.objectFile)) {
+        objects.add(node.objectFile);
+      }
+    });
+  }
+
+  return objects;
+}
+
+export function isApplicationNode(node: CallGraphNode, applicationObjects: Set<string>): boolean {
+  return !!node.objectFile && applicationObjects.has(node.objectFile) && node.file !== '???';
+}
+
+/**
+ * Walk up from a node along its heaviest caller edges (by the given event)
+ * and return the path from the outermost caller down to the node.
+ */
+export function heaviestCallerPath(
+  node: CallGraphNode,
+  event: string,
+  maxDepth: number = 16,
+  accept: (caller: CallGraphNode) => boolean = () => true
+): CallGraphNode[] {
+  const path: CallGraphNode[] = [node];
+  const visited = new Set<string>([node.key]);
+  let current = node;
+
+  while (path.length < maxDepth) {
+    let best: CallGraphEdge | null = null;
+    for (const edge of current.callers) {
+      if (visited.has(edge.caller.key) || !accept(edge.caller)) continue;
+      if (!best
+        || (edge.inclusive[event] || 0) > (best.inclusive[event] || 0)
+        || ((edge.inclusive[event] || 0) === (best.inclusive[event] || 0) && edge.count > best.count)) {
+        best = edge;
+      }
+    }
+    if (!best) break;
+    visited.add(best.caller.key);
+    path.unshift(best.caller);
+    current = best.caller;
+  }
+
+  return path;
+}
+
+/**
+ * Strongly connected components of the call graph restricted to `nodes`
+ * and the edges accepted by `follow` (iterative Tarjan). Components are
+ * numbered callees first: every component reached from another one has a
+ * lower number.
+ */
+export function stronglyConnectedComponents(
+  nodes: CallGraphNode[],
+  follow: (edge: CallGraphEdge) => boolean = () => true
+): Int32Array {
+  const n = nodes.length;
+  const index = new Map<CallGraphNode, number>();
+  nodes.forEach((node, i) => index.set(node, i));
+  const callees = nodes.map(node => node.callees
+    .filter(edge => index.has(edge.callee) && follow(edge))
+    .map(edge => index.get(edge.callee)!));
+  const component = new Int32Array(n).fill(-1);
+  const order = new Int32Array(n).fill(-1);
+  const low = new Int32Array(n);
+  const onStack = new Uint8Array(n);
+  const stack: number[] = [];
+  let counter = 0;
+  let components = 0;
+
+  for (let root = 0; root < n; root++) {
+    if (order[root] >= 0) continue;
+    const frames: { node: number; next: number }[] = [{ node: root, next: 0 }];
+    order[root] = low[root] = counter++;
+    stack.push(root);
+    onStack[root] = 1;
+    while (frames.length > 0) {
+      const frame = frames[frames.length - 1];
+      const v = frame.node;
+      if (frame.next < callees[v].length) {
+        const w = callees[v][frame.next++];
+        if (order[w] < 0) {
+          order[w] = low[w] = counter++;
+          stack.push(w);
+          onStack[w] = 1;
+          frames.push({ node: w, next: 0 });
+        } else if (onStack[w]) {
+          low[v] = Math.min(low[v], order[w]);
+        }
+        continue;
+      }
+      frames.pop();
+      if (frames.length > 0) {
+        const parent = frames[frames.length - 1].node;
+        low[parent] = Math.min(low[parent], low[v]);
+      }
+      if (low[v] === order[v]) {
+        let w: number;
+        do {
+          w = stack.pop()!;
+          onStack[w] = 0;
+          component[w] = components;
+        } while (w !== v);
+        components++;
+      }
+    }
+  }
+  return component;
+}
+
+/**
+ * Build a function that passes amounts held by library frames up to the
+ * application frames calling into the library. An amount is split over a
+ * frame's callers in proportion to the inclusive cost of each caller edge
+ * (per amount, by the matching entry of `weights`) and climbs until it
+ * crosses an application -> library edge, where `charge` receives it. It
+ * never climbs past an application frame, so cost under a callback
+ * (qsort comparator, thread start routine) is charged to the callback
+ * only. Library cycles are condensed first: a cycle's amount leaves it
+ * only through edges coming from outside it, so recursion in library code
+ * ends. The returned function gives back what reached no application
+ * frame (library roots such as loader startup).
+ */
+export function createApplicationCharger(graph: CallGraph, isApp: (node: CallGraphNode) => boolean) {
+  const library = Array.from(graph.nodes.values()).filter(node => !isApp(node));
+  const component = stronglyConnectedComponents(library);
+  const componentOf = new Map<CallGraphNode, number>();
+  library.forEach((node, i) => componentOf.set(node, component[i]));
+  const componentCount = component.reduce((max, c) => Math.max(max, c + 1), 0);
+
+  // Edges entering each component from outside it
+  const entering: CallGraphEdge[][] = Array.from({ length: componentCount }, () => []);
+  library.forEach((node, i) => node.callers.forEach(edge => {
+    if (componentOf.get(edge.caller) !== component[i]) entering[component[i]].push(edge);
+  }));
+
+  return (
+    held: Map<CallGraphNode, number[]>,
+    weights: string[],
+    charge: (edge: CallGraphEdge, amounts: number[]) => void
+  ): number[] => {
+    const unattributed = weights.map(() => 0);
+    const pending = new Map<number, number[]>();
+    const add = (c: number, amounts: number[]) => {
+      const entry = pending.get(c);
+      if (entry) amounts.forEach((amount, k) => { entry[k] += amount; });
+      else pending.set(c, amounts.slice());
+    };
+    held.forEach((amounts, node) => {
+      const c = componentOf.get(node);
+      if (c !== undefined) add(c, amounts);
+    });
+
+    // Callees first, so a component's amount is complete when it is taken
+    const order = Array.from(pending.keys()).sort((a, b) => a - b);
+    const queued = new Set(order);
+    const heap = order;
+    const push = (c: number) => {
+      heap.push(c);
+      for (let k = heap.length - 1; k > 0;) {
+        const parent = (k - 1) >> 1;
+        if (heap[parent] <= heap[k]) break;
+        [heap[parent], heap[k]] = [heap[k], heap[parent]];
+        k = parent;
+      }
+    };
+    const pop = () => {
+      const top = heap[0];
+      const last = heap.pop()!;
+      if (heap.length > 0) {
+        heap[0] = last;
+        for (let k = 0; ;) {
+          const left = 2 * k + 1;
+          const right = left + 1;
+          let smallest = k;
+          if (left < heap.length && heap[left] < heap[smallest]) smallest = left;
+          if (right < heap.length && heap[right] < heap[smallest]) smallest = right;
+          if (smallest === k) break;
+          [heap[smallest], heap[k]] = [heap[k], heap[smallest]];
+          k = smallest;
+        }
+      }
+      return top;
+    };
+
+    while (heap.length > 0) {
+      const c = pop();
+      const amounts = pending.get(c)!;
+      pending.delete(c);
+      const incoming = weights.map(event => entering[c].reduce((sum, edge) => sum + (edge.inclusive[event] || 0), 0));
+      amounts.forEach((amount, k) => { if (incoming[k] <= 0) unattributed[k] += amount; });
+      entering[c].forEach(edge => {
+        const shares = amounts.map((amount, k) => incoming[k] > 0 ? amount * (edge.inclusive[weights[k]] || 0) / incoming[k] : 0);
+        if (shares.every(share => share === 0)) return;
+        if (isApp(edge.caller)) {
+          charge(edge, shares);
+          return;
+        }
+        const caller = componentOf.get(edge.caller)!;
+        add(caller, shares);
+        if (!queued.has(caller)) {
+          queued.add(caller);
+          push(caller);
+        }
+      });
+    }
+    return unattributed;
+  };
+}
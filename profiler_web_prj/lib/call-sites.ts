@@ -0,0 +1,92 @@
+import { CallGraph, CallGraphNode } from './call-graph';
+
+/**
+ * Indirect and virtual call sites: one call instruction (caller and source
+ * PC) that reached more than one callee. Targets are summarized by their
+ * distribution and its entropy, and sites where one target dominates are
+ * flagged for (speculative) devirtualization.
+ */
+
+export type CallSiteKind = 'devirtualize' | 'speculative' | 'polymorphic' | 'megamorphic';
+
+export interface CallSiteTarget {
+  callee: CallGraphNode;
+  calls: number;
+  inclusive: number;
+  share: number; // of the site's calls
+}
+
+export interface PolymorphicCallSite {
+  caller: CallGraphNode;
+  sourcePc: string;
+  calls: number;
+  inclusive: number;
+  targets: CallSiteTarget[]; // most called first
+  entropy: number; // bits; 0 for a single target, log2(n) for n equally likely ones
+  kind: CallSiteKind;
+}
+
+// Dominant target shares above which a site is worth devirtualizing outright or behind a guard
+const DEVIRTUALIZE_SHARE = 0.99;
+const SPECULATIVE_SHARE = 0.8;
+const MAX_POLYMORPHIC_TARGETS = 4;
+
+const classify = (dominantShare: number, targetCount: number): CallSiteKind => {
+  if (dominantShare >= DEVIRTUALIZE_SHARE) return 'devirtualize';
+  if (dominantShare >= SPECULATIVE_SHARE) return 'speculative';
+  return targetCount <= MAX_POLYMORPHIC_TARGETS ? 'polymorphic' : 'megamorphic';
+};
+
+/**
+ * Group call edges by call site in one pass over the graph's edge list and
+ * return the sites with several targets, most expensive first.
+ */
+export function findPolymorphicCallSites(graph: CallGraph, event: string): PolymorphicCallSite[] {
+  const sites = new Map<string, { caller: CallGraphNode; sourcePc: string; targets: Map<string, CallSiteTarget> }>();
+
+  graph.edges.forEach(edge => {
+    if (!edge.sourcePc) return; // pruned buckets and dumps without PCs
+    const siteKey = `${edge.caller.key}\u0000${edge.sourcePc}`;
+    let site = sites.get(siteKey);
+    if (!site) {
+      site = { caller: edge.caller, sourcePc: edge.sourcePc, targets: new Map() };
+      sites.set(siteKey, site);
+    }
+    // A target can appear in several edges, e.g. from separate contexts
+    const target = site.targets.get(edge.callee.key);
+    if (target) {
+      target.calls += edge.count;
+      target.inclusive += edge.inclusive[event] || 0;
+    } else {
+      site.targets.set(edge.callee.key, {
+        callee: edge.callee,
+        calls: edge.count,
+        inclusive: edge.inclusive[event] || 0,
+        share: 0
+      });
+    }
+  });
+
+  const result: PolymorphicCallSite[] = [];
+  sites.forEach(site => {
+    if (site.targets.size < 2) return;
+    const targets = Array.from(site.targets.values()).sort((a, b) => b.calls - a.calls);
+    const calls = targets.reduce((sum, target) => sum + target.calls, 0);
+    let entropy = 0;
+    targets.forEach(target => {
+      target.share = calls > 0 ? target.calls / calls : 0;
+      if (target.share > 0) entropy -= target.share * Math.log2(target.share);
+    });
+    result.push({
+      caller: site.caller,
+      sourcePc: site.sourcePc,
+      calls,
+      inclusive: targets.reduce((sum, target) => sum + target.inclusive, 0),
+      targets,
+      entropy,
+      kind: classify(targets[0].share, targets.length)
+    });
+  });
+
+  return result.sort((a, b) => b.inclusive - a.inclusive || b.calls - a.calls);
+}
@@ -0,0 +1,140 @@
+import { AssemblyInstruction, CachegrindData, FunctionData } from '@/types/profiler';
+
+/**
+ * Code that never ran inside hot functions. Such code still occupies
+ * I-cache lines next to the hot path, so functions with a large cold
+ * fraction are candidates for __builtin_expect, [[unlikely]] or outlining
+ * the cold blocks. A first estimate uses compiled source lines; exact byte
+ * and instruction counts come from disassembling the function symbol and
+ * comparing it with the executed PCs.
+ */
+
+export interface ColdRegion {
+  start: number; // first address
+  end: number; // one past the last byte
+  bytes: number;
+  instructions: number;
+  lines: number[]; // source lines, when the disassembly has them
+}
+
+export interface ColdCodeMeasure {
+  totalBytes: number;
+  totalInstructions: number;
+  coldBytes: number;
+  coldInstructions: number;
+  regions: ColdRegion[]; // largest first
+}
+
+export interface HotFunctionColdness {
+  file: string;
+  functionName: string;
+  data: FunctionData;
+  cost: number;
+  share: number; // of the profile total
+  coldLines: number;
+  compiledLines: number;
+  measure?: ColdCodeMeasure; // set once disassembled
+  coldFraction: number; // by bytes when measured, else by compiled lines
+}
+
+// Encoding bytes and mnemonic of an objdump line. Long x86 instructions
+// continue on a second line that holds only bytes.
+const parseInstruction = (instruction: string): { bytes: number; mnemonic: string } => {
+  const [encoding, ...rest] = instruction.split('\t');
+  const bytes = encoding.trim().split(/\s+/)
+    .filter(token => /^[0-9a-f]+$/i.test(token))
+    .reduce((sum, token) => sum + token.length / 2, 0);
+  return { bytes, mnemonic: rest.join(' ').trim().split(/\s+/)[0] || '' };
+};
+
+const isPadding = (mnemonic: string) => /nop|^xchg$|^int3$|^(cs|ds|data16)$/.test(mnemonic);
+
+/**
+ * Split a function's disassembly into executed and cold instructions.
+ * Alignment padding counts as neither.
+ */
+export function measureColdCode(instructions: AssemblyInstruction[], executedPcs: Set<number>): ColdCodeMeasure {
+  const merged: { pc: number; bytes: number; mnemonic: string; line?: number }[] = [];
+  instructions.forEach(inst => {
+    const { bytes, mnemonic } = parseInstruction(inst.instruction);
+    const previous = merged[merged.length - 1];
+    if (!mnemonic && previous) {
+      previous.bytes += bytes;
+    } else {
+      merged.push({ pc: parseInt(inst.pc, 16), bytes, mnemonic, line: inst.line });
+    }
+  });
+
+  const result: ColdCodeMeasure = { totalBytes: 0, totalInstructions: 0, coldBytes: 0, coldInstructions: 0, regions: [] };
+  let region: ColdRegion | null = null;
+  merged.forEach(inst => {
+    if (isPadding(inst.mnemonic)) return;
+    result.totalBytes += inst.bytes;
+    result.totalInstructions++;
+    if (executedPcs.has(inst.pc)) {
+      region = null;
+      return;
+    }
+    result.coldBytes += inst.bytes;
+    result.coldInstructions++;
+    if (!region) {
+      region = { start: inst.pc, end: inst.pc, bytes: 0, instructions: 0, lines: [] };
+      result.regions.push(region);
+    }
+    region.end = inst.pc + inst.bytes;
+    region.bytes += inst.bytes;
+    region.instructions++;
+    if (inst.line !== undefined && !region.lines.includes(inst.line)) region.lines.push(inst.line);
+  });
+  result.regions.sort((a, b) => b.bytes - a.bytes);
+  result.regions.forEach(r => r.lines.sort((a, b) => a - b));
+  return result;
+}
+
+export function executedPcsOf(functionData: FunctionData): Set<number> {
+  const pcs = new Set<number>();
+  Object.values(functionData.pcData || {}).forEach(pcLine => {
+    if (pcLine.executed) pcs.add(parseInt(pcLine.pc, 16));
+  });
+  return pcs;
+}
+
+/**
+ * Functions costing at least `minShare` of the total for `event`, with
+ * their cold fraction, most cold first. `measures` holds disassembly
+ * results keyed by `${file}:${functionName}`.
+ */
+export function rankColdFunctions(
+  data: CachegrindData,
+  event: string,
+  minShare: number,
+  measures: Map<string, ColdCodeMeasure>
+): HotFunctionColdness[] {
+  const total = data.summaryTotals[event] || 0;
+  const result: HotFunctionColdness[] = [];
+
+  Object.entries(data.fileCoverage).forEach(([file, fileData]) => {
+    Object.entries(fileData.functions).forEach(([functionName, functionData]) => {
+      const cost = functionData.totals[event] || 0;
+      if (total <= 0 || cost / total < minShare) return;
+      const compiledLines = functionData.coveredLines.length + functionData.uncoveredLines.length;
+      const measure = measures.get(`${file}:${functionName}`);
+      const coldFraction = measure
+        ? (measure.totalBytes > 0 ? measure.coldBytes / measure.totalBytes : 0)
+        : (compiledLines > 0 ? functionData.uncoveredLines.length / compiledLines : 0);
+      result.push({
+        file,
+        functionName,
+        data: functionData,
+        cost,
+        share: cost / total,
+        coldLines: functionData.uncoveredLines.length,
+        compiledLines,
+        measure,
+        coldFraction
+      });
+    });
+  });
+
+  return result.sort((a, b) => b.coldFraction - a.coldFraction || b.cost - a.cost);
+}
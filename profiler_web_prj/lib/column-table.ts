@@ -0,0 +1,144 @@
+/**
+ * Columnar storage for large sortable lists (the sidebar's files and
+ * functions). Each numeric column is a Float64Array built on first use.
+ * Its ascending order is an argsort permutation computed on first use and
+ * cached, so changing the sort key or direction does not re-sort rows that
+ * were already ordered by that key.
+ */
+
+const LITTLE_ENDIAN = new Uint8Array(new Uint16Array([1]).buffer)[0] === 1;
+
+/**
+ * Stable ascending argsort of a Float64Array. This is an LSD radix sort on
+ * 16-bit digits of the IEEE bit pattern, which is flipped so unsigned order
+ * matches numeric order. Keys travel with their row index, so every pass
+ * reads sequentially. Digit positions where every key agrees are skipped,
+ * which for cost counters is usually half of them.
+ */
+export function argsort(values: Float64Array): Uint32Array {
+  const n = values.length;
+  const words = new Uint32Array(values.buffer, values.byteOffset, n * 2);
+  const hiOffset = LITTLE_ENDIAN ? 1 : 0;
+  let hi = new Uint32Array(n);
+  let lo = new Uint32Array(n);
+  let order = new Uint32Array(n);
+  for (let i = 0; i < n; i++) {
+    let h = words[2 * i + hiOffset];
+    let l = words[2 * i + 1 - hiOffset];
+    if (values[i] !== values[i]) {
+      h = 0x80000000; // NaN sorts as 0
+      l = 0;
+    } else if (h & 0x80000000) {
+      h = ~h >>> 0;
+      l = ~l >>> 0;
+    } else {
+      h = (h | 0x80000000) >>> 0;
+    }
+    hi[i] = h;
+    lo[i] = l;
+    order[i] = i;
+  }
+
+  let hiScratch = new Uint32Array(n);
+  let loScratch = new Uint32Array(n);
+  let orderScratch = new Uint32Array(n);
+  const counts = new Uint32Array(65536);
+
+  for (let pass = 0; pass < 4; pass++) {
+    const keys = pass < 2 ? lo : hi;
+    const shift = (pass & 1) * 16;
+    counts.fill(0);
+    for (let i = 0; i < n; i++) counts[(keys[i] >>> shift) & 0xffff]++;
+    if (n === 0 || counts[(keys[0] >>> shift) & 0xffff] === n) continue;
+
+    let sum = 0;
+    for (let d = 0; d < 65536; d++) {
+      const c = counts[d];
+      counts[d] = sum;
+      sum += c;
+    }
+    for (let i = 0; i < n; i++) {
+      const target = counts[(keys[i] >>> shift) & 0xffff]++;
+      hiScratch[target] = hi[i];
+      loScratch[target] = lo[i];
+      orderScratch[target] = order[i];
+    }
+    [hi, hiScratch] = [hiScratch, hi];
+    [lo, loScratch] = [loScratch, lo];
+    [order, orderScratch] = [orderScratch, order];
+  }
+  return order;
+}
+
+export class ColumnTable {
+  private columns = new Map<string, Float64Array>();
+  private orders = new Map<string, Uint32Array>();
+
+  /**
+   * @param size number of rows
+   * @param searchText lower-cased text each row is matched against
+   * @param fillColumn writes the values of a column into `out`
+   */
+  constructor(
+    readonly size: number,
+    private searchText: string[],
+    private fillColumn: (key: string, out: Float64Array) => void
+  ) {}
+
+  column(key: string): Float64Array {
+    let column = this.columns.get(key);
+    if (!column) {
+      column = new Float64Array(this.size);
+      this.fillColumn(key, column);
+      this.columns.set(key, column);
+    }
+    return column;
+  }
+
+  order(key: string): Uint32Array {
+    let order = this.orders.get(key);
+    if (!order) {
+      order = argsort(this.column(key));
+      this.orders.set(key, order);
+    }
+    return order;
+  }
+
+  /**
+   * Row indices sorted by `key`, keeping only rows whose search text
+   * contains `query`.
+   */
+  view(key: string, ascending: boolean, query: string): Uint32Array {
+    const order = this.order(key);
+    const mask = this.match(query);
+    const rows = new Uint32Array(this.size);
+    let count = 0;
+    if (ascending) {
+      for (let i = 0; i < order.length; i++) {
+        if (!mask || mask[order[i]]) rows[count++] = order[i];
+      }
+    } else {
+      for (let i = order.length - 1; i >= 0; i--) {
+        if (!mask || mask[order[i]]) rows[count++] = order[i];
+      }
+    }
+    return rows.subarray(0, count);
+  }
+
+  // Scan the search text in row order (not sort order) and remember the last query
+  private lastQuery = '';
+  private lastMask: Uint8Array | null = null;
+
+  private match(query: string): Uint8Array | null {
+    const needle = query.toLowerCase();
+    if (!needle) return null;
+    if (needle === this.lastQuery) return this.lastMask;
+    const mask = new Uint8Array(this.size);
+    for (let i = 0; i < this.size; i++) {
+      if (this.searchText[i].includes(needle)) mask[i] = 1;
+    }
+    this.lastQuery = needle;
+    this.lastMask = mask;
+    return mask;
+  }
+}
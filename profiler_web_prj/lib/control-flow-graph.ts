@@ -0,0 +1,242 @@
+import { AssemblyInstruction, JumpInfo } from '@/types/profiler';
+
+/**
+ * Basic blocks and edges of one function, recovered from its disassembly.
+ * Branch instructions are recognized for x86, AArch64 and RISC-V; edge
+ * counts come from the profile's jump records (--collect-jumps=yes) and,
+ * for fall-through edges, from the Ir count of the block's last
+ * instruction. Loops are the natural loops of the back edges found by a
+ * depth-first search from the entry block.
+ */
+
+export interface CfgBlock {
+  id: number;
+  startPc: string;
+  endPc: string; // last instruction
+  instructions: AssemblyInstruction[];
+  costs: Record<string, number>;
+  executed: boolean;
+  line?: number; // source line of the first instruction that has one
+  loopDepth: number;
+  loopHeader: boolean;
+}
+
+export interface CfgEdge {
+  from: number;
+  to: number;
+  kind: 'taken' | 'fallthrough' | 'indirect';
+  count?: number; // undefined when the profile has no jump or Ir data for it
+  backEdge: boolean;
+}
+
+export interface ControlFlowGraph {
+  blocks: CfgBlock[];
+  edges: CfgEdge[];
+  loopCount: number;
+}
+
+type BranchKind = 'none' | 'conditional' | 'jump' | 'indirect' | 'return' | 'stop';
+
+const CONDITIONAL_BRANCHES = new Set([
+  // AArch64
+  'cbz', 'cbnz', 'tbz', 'tbnz',
+  // RISC-V, including pseudo-instructions
+  'beq', 'bne', 'blt', 'bge', 'bltu', 'bgeu', 'beqz', 'bnez', 'blez', 'bgez', 'bltz', 'bgtz',
+  'bgt', 'ble', 'bgtu', 'bleu',
+  // x86 loop instructions
+  'loop', 'loope', 'loopne', 'jcxz', 'jecxz', 'jrcxz'
+]);
+
+// Mnemonic and operands of an objdump line ("encoding\tmnemonic operands")
+const splitInstruction = (instruction: string): { mnemonic: string; operands: string } => {
+  const parts = instruction.split('\t');
+  const text = (parts.length > 1 ? parts.slice(1).join(' ') : parts[0]).trim();
+  const space = text.search(/\s/);
+  const mnemonic = (space < 0 ? text : text.substring(0, space)).toLowerCase();
+  const operands = space < 0 ? '' : text.substring(space).trim().replace(/\s+(#|\/\/|;).*$/, '');
+  return { mnemonic: mnemonic.replace(/^c\./, '').replace(/^(bnd|notrack)$/, ''), operands };
+};
+
+// Direct branch target: "401140 <main+0x1a>" from objdump, or a bare hex last operand
+const branchTarget = (operands: string): number | undefined => {
+  const symbolic = operands.match(/\b(?:0x)?([0-9a-f]+)\s*</);
+  if (symbolic) return parseInt(symbolic[1], 16);
+  const last = operands.split(',').pop()!.trim();
+  return /^(0x)?[0-9a-f]+$/.test(last) ? parseInt(last, 16) : undefined;
+};
+
+function classify(instruction: string): { kind: BranchKind; target?: number } {
+  let { mnemonic, operands } = splitInstruction(instruction);
+  if (!mnemonic) ({ mnemonic, operands } = splitInstruction(operands)); // prefixes such as "bnd jmp"
+  mnemonic = mnemonic.replace(/[lqw]$/, m => (mnemonic.startsWith('ret') || mnemonic.startsWith('jmp')) ? '' : m);
+
+  if (/^(ret|iret|eret|mret|sret)/.test(mnemonic) || (mnemonic === 'jr' && operands === 'ra')) return { kind: 'return' };
+  if (/^(ud2|hlt|brk|udf)$/.test(mnemonic)) return { kind: 'stop' };
+  if (mnemonic === 'jmp' || mnemonic === 'b' || mnemonic === 'j') {
+    return operands.startsWith('*') ? { kind: 'indirect' } : { kind: 'jump', target: branchTarget(operands) };
+  }
+  if (mnemonic === 'br' || mnemonic === 'jr') return { kind: 'indirect' };
+  if (mnemonic === 'jal' && /^zero,/.test(operands)) return { kind: 'jump', target: branchTarget(operands) };
+  if (mnemonic.startsWith('b.') || CONDITIONAL_BRANCHES.has(mnemonic) || (/^j[a-z]+$/.test(mnemonic) && mnemonic !== 'jal' && mnemonic !== 'jalr')) {
+    return { kind: 'conditional', target: branchTarget(operands) };
+  }
+  return { kind: 'none' };
+}
+
+export function buildControlFlowGraph(
+  instructions: AssemblyInstruction[],
+  jumps: JumpInfo[] = [],
+  pcLines: Record<string, { line: number }> = {}
+): ControlFlowGraph {
+  const sorted = instructions
+    .map(inst => ({ inst, pc: parseInt(inst.pc, 16), branch: classify(inst.instruction) }))
+    .sort((a, b) => a.pc - b.pc);
+  if (sorted.length === 0) return { blocks: [], edges: [], loopCount: 0 };
+
+  const indexOfPc = new Map<number, number>();
+  sorted.forEach((entry, i) => indexOfPc.set(entry.pc, i));
+
+  // Leaders: the entry, every branch target inside the function and every instruction after a branch
+  const leaders = new Set<number>([0]);
+  sorted.forEach((entry, i) => {
+    if (entry.branch.kind === 'none') return;
+    if (i + 1 < sorted.length) leaders.add(i + 1);
+    const target = entry.branch.target !== undefined ? indexOfPc.get(entry.branch.target) : undefined;
+    if (target !== undefined) leaders.add(target);
+  });
+  jumps.forEach(jump => {
+    const target = indexOfPc.get(parseInt(jump.targetPc, 16));
+    if (target !== undefined) leaders.add(target);
+  });
+
+  const blockOf = new Int32Array(sorted.length);
+  const blocks: CfgBlock[] = [];
+  sorted.forEach((entry, i) => {
+    if (leaders.has(i)) {
+      blocks.push({
+        id: blocks.length,
+        startPc: entry.inst.pc,
+        endPc: entry.inst.pc,
+        instructions: [],
+        costs: {},
+        executed: false,
+        loopDepth: 0,
+        loopHeader: false
+      });
+    }
+    const block = blocks[blocks.length - 1];
+    block.instructions.push(entry.inst);
+    block.endPc = entry.inst.pc;
+    Object.entries(entry.inst.events || {}).forEach(([event, value]) => {
+      block.costs[event] = (block.costs[event] || 0) + value;
+    });
+    block.executed = block.executed || !!entry.inst.executed;
+    const line = entry.inst.line ?? pcLines[entry.inst.pc]?.line;
+    if (block.line === undefined && line) block.line = line;
+    blockOf[i] = block.id;
+  });
+
+  // Taken counts per (jump instruction, target)
+  const jumpsFrom = new Map<string, JumpInfo[]>();
+  jumps.forEach(jump => {
+    const list = jumpsFrom.get(jump.sourcePc) || [];
+    list.push(jump);
+    jumpsFrom.set(jump.sourcePc, list);
+  });
+  const lastIr = (block: CfgBlock) => block.instructions[block.instructions.length - 1].events?.['Ir'];
+
+  const edges: CfgEdge[] = [];
+  blocks.forEach(block => {
+    const lastIndex = indexOfPc.get(parseInt(block.endPc, 16))!;
+    const branch = sorted[lastIndex].branch;
+    const recorded = jumpsFrom.get(block.endPc) || [];
+    const next = lastIndex + 1 < sorted.length ? blockOf[lastIndex + 1] : -1;
+    const targetBlock = branch.target !== undefined ? indexOfPc.get(branch.target) : undefined;
+
+    if (branch.kind === 'conditional' || branch.kind === 'jump') {
+      const taken = recorded.filter(jump => parseInt(jump.targetPc, 16) === branch.target);
+      const takenCount = taken.length > 0 ? taken.reduce((sum, jump) => sum + jump.count, 0) : undefined;
+      if (targetBlock !== undefined) {
+        edges.push({ from: block.id, to: blockOf[targetBlock], kind: 'taken', count: takenCount, backEdge: false });
+      }
+      if (branch.kind === 'conditional' && next >= 0) {
+        // One jcnd= record per dump context; each carries that context's execution count
+        const conditionalRecords = recorded.filter(jump => jump.executed !== undefined);
+        const executed = conditionalRecords.length > 0
+          ? conditionalRecords.reduce((sum, jump) => sum + jump.executed!, 0)
+          : lastIr(block);
+        edges.push({
+          from: block.id,
+          to: next,
+          kind: 'fallthrough',
+          count: executed !== undefined ? Math.max(0, executed - (takenCount || 0)) : undefined,
+          backEdge: false
+        });
+      }
+    } else if (branch.kind === 'indirect') {
+      recorded.forEach(jump => {
+        const target = indexOfPc.get(parseInt(jump.targetPc, 16));
+        if (target !== undefined) {
+          edges.push({ from: block.id, to: blockOf[target], kind: 'indirect', count: jump.count, backEdge: false });
+        }
+      });
+    } else if (branch.kind === 'none' && next >= 0) {
+      edges.push({ from: block.id, to: next, kind: 'fallthrough', count: lastIr(block), backEdge: false });
+    }
+  });
+
+  const loopCount = markLoops(blocks, edges);
+  return { blocks, edges, loopCount };
+}
+
+// Flag back edges with an iterative DFS from the entry, then mark the natural loop of each
+function markLoops(blocks: CfgBlock[], edges: CfgEdge[]): number {
+  const successors: CfgEdge[][] = blocks.map(() => []);
+  const predecessors: number[][] = blocks.map(() => []);
+  edges.forEach(edge => {
+    successors[edge.from].push(edge);
+    predecessors[edge.to].push(edge.from);
+  });
+
+  const state = new Uint8Array(blocks.length); // 0 unvisited, 1 on stack, 2 done
+  const stack: { block: number; next: number }[] = [{ block: 0, next: 0 }];
+  state[0] = 1;
+  while (stack.length > 0) {
+    const top = stack[stack.length - 1];
+    if (top.next < successors[top.block].length) {
+      const edge = successors[top.block][top.next++];
+      if (state[edge.to] === 1) edge.backEdge = true;
+      else if (state[edge.to] === 0) {
+        state[edge.to] = 1;
+        stack.push({ block: edge.to, next: 0 });
+      }
+    } else {
+      state[top.block] = 2;
+      stack.pop();
+    }
+  }
+
+  let loopCount = 0;
+  const seenHeaders = new Map<number, Set<number>>();
+  edges.filter(edge => edge.backEdge).forEach(edge => {
+    const header = edge.to;
+    let body = seenHeaders.get(header);
+    if (!body) {
+      body = new Set([header]);
+      seenHeaders.set(header, body);
+      loopCount++;
+    }
+    const work = [edge.from];
+    while (work.length > 0) {
+      const block = work.pop()!;
+      if (body.has(block)) continue;
+      body.add(block);
+      predecessors[block].forEach(p => work.push(p));
+    }
+  });
+  seenHeaders.forEach((body, header) => {
+    blocks[header].loopHeader = true;
+    body.forEach(block => blocks[block].loopDepth++);
+  });
+  return loopCount;
+}
@@ -0,0 +1,114 @@
+/**
+ * Layered layout of a control-flow graph: blocks are placed in rows by
+ * their longest forward-edge distance from the entry (back edges are left
+ * out so loops do not stretch the graph), then each row is ordered by the
+ * barycenter of its neighbours to cut down edge crossings. Normally runs
+ * in lib/control-flow-layout.worker.ts.
+ */
+
+export const BLOCK_WIDTH = 168;
+export const BLOCK_HEIGHT = 40;
+const COLUMN_GAP = 32;
+const ROW_GAP = 48;
+const ORDERING_SWEEPS = 6;
+
+export interface CfgLayoutInput {
+  blockCount: number;
+  from: Int32Array; // forward edges only
+  to: Int32Array;
+}
+
+export interface CfgLayout {
+  x: Float64Array; // top-left corner of each block
+  y: Float64Array;
+  width: number;
+  height: number;
+}
+
+export function layoutControlFlowGraph({ blockCount, from, to }: CfgLayoutInput): CfgLayout {
+  const successors: number[][] = Array.from({ length: blockCount }, () => []);
+  const predecessors: number[][] = Array.from({ length: blockCount }, () => []);
+  const indegree = new Int32Array(blockCount);
+  for (let e = 0; e < from.length; e++) {
+    if (from[e] === to[e]) continue;
+    successors[from[e]].push(to[e]);
+    predecessors[to[e]].push(from[e]);
+    indegree[to[e]]++;
+  }
+
+  // Longest-path layering in topological order; blocks left over by a
+  // cycle the DFS never reached go below everything else
+  const layer = new Int32Array(blockCount);
+  const placed = new Uint8Array(blockCount);
+  const queue: number[] = [];
+  for (let b = 0; b < blockCount; b++) if (indegree[b] === 0) queue.push(b);
+  let maxLayer = 0;
+  for (let head = 0; head < queue.length; head++) {
+    const b = queue[head];
+    placed[b] = 1;
+    maxLayer = Math.max(maxLayer, layer[b]);
+    for (const s of successors[b]) {
+      layer[s] = Math.max(layer[s], layer[b] + 1);
+      if (--indegree[s] === 0) queue.push(s);
+    }
+  }
+  for (let b = 0; b < blockCount; b++) {
+    if (!placed[b]) layer[b] = ++maxLayer;
+  }
+
+  const rows: number[][] = Array.from({ length: blockCount > 0 ? maxLayer + 1 : 0 }, () => []);
+  for (let b = 0; b < blockCount; b++) rows[layer[b]].push(b);
+
+  // Barycenter ordering, alternating downward and upward sweeps
+  const position = new Float64Array(blockCount);
+  const renumber = (row: number[]) => row.forEach((b, i) => { position[b] = i - (row.length - 1) / 2; });
+  rows.forEach(renumber);
+  const barycenter = (neighbours: number[], b: number) =>
+    neighbours.length === 0 ? position[b] : neighbours.reduce((sum, n) => sum + position[n], 0) / neighbours.length;
+  for (let sweep = 0; sweep < ORDERING_SWEEPS; sweep++) {
+    const downward = sweep % 2 === 0;
+    const order = downward ? rows : [...rows].reverse();
+    for (const row of order) {
+      const keys = new Map(row.map(b => [b, barycenter(downward ? predecessors[b] : successors[b], b)]));
+      row.sort((a, b) => keys.get(a)! - keys.get(b)! || a - b);
+      renumber(row);
+    }
+  }
+
+  const widest = rows.reduce((max, row) => Math.max(max, row.length), 0);
+  const width = widest * (BLOCK_WIDTH + COLUMN_GAP) - COLUMN_GAP;
+  const x = new Float64Array(blockCount);
+  const y = new Float64Array(blockCount);
+  for (let b = 0; b < blockCount; b++) {
+    x[b] = width / 2 + position[b] * (BLOCK_WIDTH + COLUMN_GAP) - BLOCK_WIDTH / 2;
+    y[b] = layer[b] * (BLOCK_HEIGHT + ROW_GAP);
+  }
+  return { x, y, width: Math.max(width, 0), height: Math.max(rows.length * (BLOCK_HEIGHT + ROW_GAP) - ROW_GAP, 0) };
+}
+
+let worker: Worker | null = null;
+let nextRequestId = 0;
+const pending = new Map<number, (layout: CfgLayout) => void>();
+
+/**
+ * Lay the graph out in a dedicated worker, so large functions do not block
+ * the page. Falls back to the main thread where workers are unavailable.
+ */
+export function layoutInWorker(input: CfgLayoutInput): Promise<CfgLayout> {
+  if (typeof window === 'undefined' || typeof Worker === 'undefined') {
+    return Promise.resolve(layoutControlFlowGraph(input));
+  }
+  if (!worker) {
+    worker = new Worker(new URL('./control-flow-layout.worker.ts', import.meta.url));
+    worker.onmessage = (event: MessageEvent<{ requestId: number; layout: CfgLayout }>) => {
+      const resolve = pending.get(event.data.requestId);
+      pending.delete(event.data.requestId);
+      resolve?.(event.data.layout);
+    };
+  }
+  const requestId = nextRequestId++;
+  return new Promise(resolve => {
+    pending.set(requestId, resolve);
+    worker!.postMessage({ requestId, ...input });
+  });
+}
@@ -0,0 +1,18 @@
+import { layoutControlFlowGraph } from './control-flow-layout';
+
+/**
+ * Dedicated worker running the control-flow graph layout. Requests are
+ * { requestId, blockCount, from, to }; replies { requestId, layout }, with
+ * the coordinate arrays transferred back.
+ */
+
+const scope = self as unknown as {
+  onmessage: ((event: MessageEvent) => void) | null;
+  postMessage: (message: unknown, transfer: Transferable[]) => void;
+};
+
+scope.onmessage = (event: MessageEvent) => {
+  const { requestId, blockCount, from, to } = event.data;
+  const layout = layoutControlFlowGraph({ blockCount, from, to });
+  scope.postMessage({ requestId, layout }, [layout.x.buffer, layout.y.buffer]);
+};
@@ -0,0 +1,158 @@
+import { CachegrindData } from '@/types/profiler';
+
+/**
+ * Hierarchy of self cost by object file, source directory, file and
+ * function. Each node holds one value per profile event, so switching the
+ * event does not rebuild the tree. Path components are interned while
+ * building; single-child directory chains are merged into one node.
+ */
+
+export type CostTreeKind = 'root' | 'object' | 'directory' | 'file' | 'function';
+
+export interface CostTreeNode {
+  name: string;
+  kind: CostTreeKind;
+  path: string; // full path for objects, files and directories, function key for functions
+  values: Float64Array; // indexed like data.events
+  children: CostTreeNode[]; // heaviest first by the profile's main event
+  parent?: CostTreeNode;
+}
+
+export interface TreemapRect {
+  node: CostTreeNode;
+  x: number;
+  y: number;
+  width: number;
+  height: number;
+}
+
+export function buildCostTree(data: CachegrindData): CostTreeNode {
+  const eventCount = data.events.length;
+  const makeNode = (name: string, kind: CostTreeKind, path: string, parent?: CostTreeNode): CostTreeNode =>
+    ({ name, kind, path, values: new Float64Array(eventCount), children: [], parent });
+
+  const root = makeNode(data.projectName || 'program', 'root', '');
+  const index = new Map<CostTreeNode, Map<string, CostTreeNode>>();
+  // Children are keyed by path, so objects with the same basename stay apart
+  const child = (parent: CostTreeNode, name: string, kind: CostTreeKind, path: string) => {
+    let children = index.get(parent);
+    if (!children) {
+      children = new Map();
+      index.set(parent, children);
+    }
+    let node = children.get(path);
+    if (!node) {
+      node = makeNode(name, kind, path, parent);
+      children.set(path, node);
+      parent.children.push(node);
+    }
+    return node;
+  };
+
+  Object.entries(data.fileCoverage).forEach(([file, fileData]) => {
+    const objectFile = fileData.objectFile || '???';
+    let node = child(root, objectFile.split('/').pop() || objectFile, 'object', objectFile);
+
+    const parts = file.split('/').filter(Boolean);
+    let dirPath = file.startsWith('/') ? '' : '.';
+    parts.slice(0, -1).forEach(part => {
+      dirPath = `${dirPath}/${part}`;
+      node = child(node, part, 'directory', dirPath);
+    });
+    node = child(node, parts[parts.length - 1] || file, 'file', file);
+
+    Object.entries(fileData.functions || {}).forEach(([functionName, functionData]) => {
+      const leaf = child(node, functionName, 'function', `${file}:${functionName}`);
+      data.events.forEach((event, i) => {
+        leaf.values[i] += functionData.totals[event] || 0;
+      });
+    });
+  });
+
+  // Roll values up, merge single-child directory chains and sort by the main event
+  const mainEvent = Math.max(0, data.events.indexOf(data.events.includes('Cy') ? 'Cy' : 'Ir'));
+  const finish = (node: CostTreeNode) => {
+    node.children.forEach(c => {
+      finish(c);
+      for (let i = 0; i < eventCount; i++) node.values[i] += c.values[i];
+    });
+    node.children = node.children.map(c => {
+      let merged = c;
+      while (merged.kind === 'directory' && merged.children.length === 1 && merged.children[0].kind === 'directory') {
+        const only = merged.children[0];
+        only.name = `${merged.name}/${only.name}`;
+        merged = only;
+      }
+      merged.parent = node;
+      return merged;
+    });
+    node.children.sort((a, b) => b.values[mainEvent] - a.values[mainEvent]);
+  };
+  finish(root);
+  return root;
+}
+
+export function costTreePath(node: CostTreeNode): CostTreeNode[] {
+  const path: CostTreeNode[] = [];
+  for (let current: CostTreeNode | undefined = node; current; current = current.parent) path.unshift(current);
+  return path;
+}
+
+// Worst aspect ratio of a row of areas laid along a side (smaller is squarer)
+const worstRatio = (sum: number, min: number, max: number, side: number) => {
+  const s2 = side * side;
+  return Math.max((s2 * max) / (sum * sum), (sum * sum) / (s2 * min));
+};
+
+/**
+ * Lay out children of a node in a rectangle with the squarified treemap
+ * algorithm (Bruls, Huizing, van Wijk). Children with no cost for the
+ * event are left out.
+ */
+export function squarify(children: CostTreeNode[], eventIndex: number, x: number, y: number, width: number, height: number): TreemapRect[] {
+  const items = children
+    .filter(c => c.values[eventIndex] > 0)
+    .sort((a, b) => b.values[eventIndex] - a.values[eventIndex]);
+  const total = items.reduce((sum, c) => sum + c.values[eventIndex], 0);
+  const rects: TreemapRect[] = [];
+  if (total <= 0 || width <= 0 || height <= 0) return rects;
+
+  const scale = (width * height) / total;
+  let start = 0;
+  while (start < items.length) {
+    const side = Math.min(width, height);
+    const first = items[start].values[eventIndex] * scale;
+    let sum = first;
+    let min = first;
+    let max = first;
+    let end = start + 1;
+    while (end < items.length) {
+      const area = items[end].values[eventIndex] * scale;
+      if (worstRatio(sum + area, Math.min(min, area), Math.max(max, area), side) > worstRatio(sum, min, max, side)) break;
+      sum += area;
+      min = Math.min(min, area);
+      max = Math.max(max, area);
+      end++;
+    }
+
+    // Place the row along the shorter side
+    const thickness = sum / side;
+    let offset = 0;
+    for (let i = start; i < end; i++) {
+      const length = (items[i].values[eventIndex] * scale) / thickness;
+      rects.push(width >= height
+        ? { node: items[i], x, y: y + offset, width: thickness, height: length }
+        : { node: items[i], x: x + offset, y, width: length, height: thickness });
+      offset += length;
+    }
+    if (width >= height) {
+      x += thickness;
+      width -= thickness;
+    } else {
+      y += thickness;
+      height -= thickness;
+    }
+    start = end;
+  }
+  return rects;
+}
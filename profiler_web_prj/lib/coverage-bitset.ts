@@ -0,0 +1,205 @@
+import { scanProfile } from './profile-scanner';
+
+/**
+ * Growable bitset indexed by source line number. Line numbers are used
+ * directly as bit positions so bitsets from different runs line up and can
+ * be merged with a plain word-wise OR.
+ */
+export class LineBitset {
+  words: Uint32Array;
+
+  constructor(words: Uint32Array = new Uint32Array(0)) {
+    this.words = words;
+  }
+
+  static fromLines(lines: Iterable<number>): LineBitset {
+    const bitset = new LineBitset();
+    for (const line of lines) bitset.add(line);
+    return bitset;
+  }
+
+  private ensureCapacity(wordCount: number) {
+    if (wordCount <= this.words.length) return;
+    const words = new Uint32Array(Math.max(wordCount, this.words.length * 2));
+    words.set(this.words);
+    this.words = words;
+  }
+
+  add(line: number) {
+    if (line < 0 || !Number.isFinite(line)) return;
+    const word = line >>> 5;
+    this.ensureCapacity(word + 1);
+    this.words[word] |= 1 << (line & 31);
+  }
+
+  has(line: number): boolean {
+    const word = line >>> 5;
+    return word < this.words.length && (this.words[word] & (1 << (line & 31))) !== 0;
+  }
+
+  or(other: LineBitset): this {
+    this.ensureCapacity(other.words.length);
+    const words = this.words;
+    const otherWords = other.words;
+    for (let i = 0; i < otherWords.length; i++) {
+      words[i] |= otherWords[i];
+    }
+    return this;
+  }
+
+  // Bits set here and not in `other`
+  andNot(other: LineBitset): LineBitset {
+    const words = new Uint32Array(this.words.length);
+    const otherWords = other.words;
+    for (let i = 0; i < words.length; i++) {
+      words[i] = this.words[i] & ~(i < otherWords.length ? otherWords[i] : 0);
+    }
+    return new LineBitset(words);
+  }
+
+  count(): number {
+    let total = 0;
+    for (let i = 0; i < this.words.length; i++) {
+      let v = this.words[i];
+      v = v - ((v >>> 1) & 0x55555555);
+      v = (v & 0x33333333) + ((v >>> 2) & 0x33333333);
+      total += (((v + (v >>> 4)) & 0x0f0f0f0f) * 0x01010101) >>> 24;
+    }
+    return total;
+  }
+
+  toLines(): number[] {
+    const lines: number[] = [];
+    for (let i = 0; i < this.words.length; i++) {
+      let v = this.words[i];
+      while (v !== 0) {
+        const bit = 31 - Math.clz32(v & -v);
+        lines.push(i * 32 + bit);
+        v &= v - 1;
+      }
+    }
+    return lines;
+  }
+
+  clone(): LineBitset {
+    return new LineBitset(this.words.slice());
+  }
+}
+
+export interface FileLineCoverage {
+  compiled: LineBitset; // lines with debug info in the dump
+  covered: LineBitset; // lines with non-zero cost
+}
+
+export type LineCoverage = Map<string, FileLineCoverage>;
+
+export interface CoverageFileSummary {
+  file: string;
+  compiledLines: number;
+  coveredLines: number;
+  coveragePercentage: number;
+}
+
+export interface CoverageDiffEntry {
+  file: string;
+  newlyCovered: number[];
+  lost: number[];
+}
+
+const getFileCoverage = (coverage: LineCoverage, file: string): FileLineCoverage => {
+  let entry = coverage.get(file);
+  if (!entry) {
+    entry = { compiled: new LineBitset(), covered: new LineBitset() };
+    coverage.set(file, entry);
+  }
+  return entry;
+};
+
+/**
+ * Extract line coverage straight from a dump without building the full
+ * profile model. Files with unknown location ("???") are skipped.
+ */
+export function scanLineCoverage(content: string): LineCoverage {
+  const coverage: LineCoverage = new Map();
+  let lastFile = '';
+  let lastEntry: FileLineCoverage | null = null;
+
+  const record = (file: string, line: number, executed: boolean) => {
+    if (!file || file === '???' || line <= 0) return;
+    if (file !== lastFile || !lastEntry) {
+      lastFile = file;
+      lastEntry = getFileCoverage(coverage, file);
+    }
+    lastEntry.compiled.add(line);
+    if (executed) lastEntry.covered.add(line);
+  };
+
+  scanProfile(content, {
+    onCost: (file, _fn, line, costs) => {
+      let executed = false;
+      for (let i = 0; i < costs.length; i++) {
+        if (costs[i] > 0) {
+          executed = true;
+          break;
+        }
+      }
+      record(file, line, executed);
+    },
+    onCall: (file, _fn, line, _targetFile, _targetFunction, count) => {
+      record(file, line, count > 0);
+    }
+  });
+
+  return coverage;
+}
+
+export function unionCoverage(runs: Iterable<LineCoverage>): LineCoverage {
+  const union: LineCoverage = new Map();
+  for (const run of runs) {
+    run.forEach((fileCoverage, file) => {
+      const entry = union.get(file);
+      if (!entry) {
+        union.set(file, { compiled: fileCoverage.compiled.clone(), covered: fileCoverage.covered.clone() });
+      } else {
+        entry.compiled.or(fileCoverage.compiled);
+        entry.covered.or(fileCoverage.covered);
+      }
+    });
+  }
+  return union;
+}
+
+/**
+ * Lines covered in `head` but not in `base`, and lines covered in `base`
+ * but no longer in `head`. Files without changes are omitted.
+ */
+export function diffCoverage(base: LineCoverage, head: LineCoverage): CoverageDiffEntry[] {
+  const empty = new LineBitset();
+  const files = new Set([...base.keys(), ...head.keys()]);
+  const diff: CoverageDiffEntry[] = [];
+
+  files.forEach(file => {
+    const baseCovered = base.get(file)?.covered || empty;
+    const headCovered = head.get(file)?.covered || empty;
+    const newlyCovered = headCovered.andNot(baseCovered).toLines();
+    const lost = baseCovered.andNot(headCovered).toLines();
+    if (newlyCovered.length > 0 || lost.length > 0) {
+      diff.push({ file, newlyCovered, lost });
+    }
+  });
+
+  return diff.sort((a, b) => (b.newlyCovered.length + b.lost.length) - (a.newlyCovered.length + a.lost.length));
+}
+
+export function summarizeCoverage(coverage: LineCoverage): CoverageFileSummary[] {
+  return Array.from(coverage.entries()).map(([file, entry]) => {
+    const compiledLines = entry.compiled.count();
+    const coveredLines = entry.covered.count();
+    return {
+      file,
+      compiledLines,
+      coveredLines,
+      coveragePercentage: compiledLines > 0 ? (coveredLines / compiledLines) * 100 : 0
+    };
+  }).sort((a, b) => a.file.localeCompare(b.file));
+}
@@ -0,0 +1,584 @@
+import { DecodedInstruction } from './disassembler';
+
+/**
+ * AArch64 decoder for the integer, load/store (including LSE atomics),
+ * branch, system and scalar floating-point instructions compilers emit for
+ * ordinary code. Output follows GNU objdump, including its preferred
+ * aliases (mov, cmp, lsl, cset, ...). Unsupported encodings, e.g. Advanced
+ * SIMD, are shown as `.inst`.
+ */
+
+const CONDITIONS = ['eq', 'ne', 'cs', 'cc', 'mi', 'pl', 'vs', 'vc', 'hi', 'ls', 'ge', 'lt', 'gt', 'le', 'al', 'nv'];
+const SHIFTS = ['lsl', 'lsr', 'asr', 'ror'];
+const EXTENDS = ['uxtb', 'uxth', 'uxtw', 'uxtx', 'sxtb', 'sxth', 'sxtw', 'sxtx'];
+const BARRIER_OPTIONS: Record<number, string> = {
+  1: 'oshld', 2: 'oshst', 3: 'osh', 5: 'nshld', 6: 'nshst', 7: 'nsh',
+  9: 'ishld', 10: 'ishst', 11: 'ish', 13: 'ld', 14: 'st', 15: 'sy'
+};
+const SYSTEM_REGISTERS: Record<string, string> = {
+  's3_3_c4_c2_0': 'nzcv', 's3_3_c4_c4_0': 'fpcr', 's3_3_c4_c4_1': 'fpsr',
+  's3_3_c13_c0_2': 'tpidr_el0', 's3_3_c13_c0_3': 'tpidrro_el0',
+  's3_3_c14_c0_0': 'cntfrq_el0', 's3_3_c14_c0_1': 'cntpct_el0', 's3_3_c14_c0_2': 'cntvct_el0',
+  's3_0_c0_c0_5': 'mpidr_el1', 's3_3_c0_c0_1': 'ctr_el0', 's3_3_c9_c13_0': 'pmccntr_el0'
+};
+
+// Prefetch operation of prfm, e.g. pldl1keep
+const prefetchOperation = (op: number) => {
+  const type = ['pld', 'pli', 'pst'][op >>> 3];
+  const level = (op >>> 1) & 3;
+  return type && level < 3 ? `${type}l${level + 1}${op & 1 ? 'strm' : 'keep'}` : `#${op}`;
+};
+
+const hex = (value: number | bigint) => '0x' + value.toString(16);
+const target = (pc: number, offset: number) => (pc + offset).toString(16);
+const signExtend = (value: number, bits: number) => (value << (32 - bits)) >> (32 - bits);
+
+// General register n; 31 is the stack pointer or the zero register depending on the operand
+const reg = (n: number, is64: boolean, sp = false) =>
+  n === 31 ? (sp ? (is64 ? 'sp' : 'wsp') : (is64 ? 'xzr' : 'wzr')) : `${is64 ? 'x' : 'w'}${n}`;
+
+const FP_PREFIXES = ['s', 'd', '', 'h'];
+
+// Bitmask immediate of the logical instructions (DecodeBitMasks in the Arm ARM)
+function decodeBitMask(n: number, imms: number, immr: number, is64: boolean): bigint | null {
+  const combined = (n << 6) | (~imms & 0x3f);
+  if (combined === 0) return null;
+  const length = 31 - Math.clz32(combined);
+  if (length < 1) return null;
+  const size = 1 << length;
+  const levels = size - 1;
+  const s = imms & levels;
+  const r = immr & levels;
+  if (s === levels) return null;
+  const sizeMask = (BigInt(1) << BigInt(size)) - BigInt(1);
+  const ones = (BigInt(1) << BigInt(s + 1)) - BigInt(1);
+  const element = r === 0 ? ones : ((ones >> BigInt(r)) | (ones << BigInt(size - r))) & sizeMask;
+  const width = is64 ? 64 : 32;
+  let mask = BigInt(0);
+  for (let i = 0; i < width; i += size) mask |= element << BigInt(i);
+  return mask;
+}
+
+function decodeBranch(w: number, pc: number): [string, string] | null {
+  if ((w & 0x7c000000) === 0x14000000) {
+    return [(w >>> 31) ? 'bl' : 'b', target(pc, signExtend(w & 0x3ffffff, 26) * 4)];
+  }
+  if ((w & 0xff000010) === 0x54000000) {
+    return [`b.${CONDITIONS[w & 0xf]}`, target(pc, signExtend((w >>> 5) & 0x7ffff, 19) * 4)];
+  }
+  if ((w & 0x7e000000) === 0x34000000) {
+    const is64 = (w >>> 31) === 1;
+    return [(w >>> 24) & 1 ? 'cbnz' : 'cbz', `${reg(w & 31, is64)}, ${target(pc, signExtend((w >>> 5) & 0x7ffff, 19) * 4)}`];
+  }
+  if ((w & 0x7e000000) === 0x36000000) {
+    const bit = ((w >>> 31) << 5) | ((w >>> 19) & 31);
+    return [
+      (w >>> 24) & 1 ? 'tbnz' : 'tbz',
+      `${reg(w & 31, bit >= 32)}, #${bit}, ${target(pc, signExtend((w >>> 5) & 0x3fff, 14) * 4)}`
+    ];
+  }
+  const rn = (w >>> 5) & 31;
+  switch ((w & 0xfffffc1f) >>> 0) {
+    case 0xd65f0000: return ['ret', rn === 30 ? '' : reg(rn, true)];
+    case 0xd61f0000: return ['br', reg(rn, true)];
+    case 0xd63f0000: return ['blr', reg(rn, true)];
+    default: return null;
+  }
+}
+
+function decodeSystem(w: number): [string, string] | null {
+  if (((w & 0xfffff01f) >>> 0) === 0xd503201f) {
+    const hint = (w >>> 5) & 0x7f;
+    const names: Record<number, string> = {
+      0: 'nop', 1: 'yield', 2: 'wfe', 3: 'wfi', 4: 'sev', 5: 'sevl', 0x19: 'paciasp', 0x1d: 'autiasp'
+    };
+    if (names[hint]) return [names[hint], ''];
+    if ((hint & 0x79) === 0x20) return ['bti', ['', 'c', 'j', 'jc'][(hint >>> 1) & 3]];
+    return ['hint', `#${hex(hint)}`];
+  }
+  if (((w & 0xfffff01f) >>> 0) === 0xd503301f) {
+    const option = (w >>> 8) & 0xf;
+    switch ((w >>> 5) & 7) {
+      case 2: return ['clrex', ''];
+      case 4: return ['dsb', BARRIER_OPTIONS[option] || `#${hex(option)}`];
+      case 5: return ['dmb', BARRIER_OPTIONS[option] || `#${hex(option)}`];
+      case 6: return ['isb', ''];
+      default: return null;
+    }
+  }
+  if (((w & 0xffd00000) >>> 0) === 0xd5100000) {
+    const name = `s${2 + ((w >>> 19) & 1)}_${(w >>> 16) & 7}_c${(w >>> 12) & 0xf}_c${(w >>> 8) & 0xf}_${(w >>> 5) & 7}`;
+    const register = SYSTEM_REGISTERS[name] || name;
+    return (w >>> 21) & 1
+      ? ['mrs', `${reg(w & 31, true)}, ${register}`]
+      : ['msr', `${register}, ${reg(w & 31, true)}`];
+  }
+  if (((w & 0xffe0001f) >>> 0) === 0xd4000001) return ['svc', `#${hex((w >>> 5) & 0xffff)}`];
+  if (((w & 0xffe0001f) >>> 0) === 0xd4200000) return ['brk', `#${hex((w >>> 5) & 0xffff)}`];
+  return null;
+}
+
+function decodeDataImmediate(w: number, pc: number): [string, string] | null {
+  const is64 = (w >>> 31) === 1;
+  const rd = w & 31;
+  const rn = (w >>> 5) & 31;
+
+  // PC-relative addressing
+  if ((w & 0x1f000000) === 0x10000000) {
+    const offset = (signExtend((w >>> 5) & 0x7ffff, 19) * 4) | ((w >>> 29) & 3);
+    return (w >>> 31)
+      ? ['adrp', `${reg(rd, true)}, ${target(Math.floor(pc / 4096) * 4096, offset * 4096)}`]
+      : ['adr', `${reg(rd, true)}, ${target(pc, offset)}`];
+  }
+  // Add/subtract (immediate)
+  if ((w & 0x1f800000) === 0x11000000) {
+    const sub = (w >>> 30) & 1;
+    const setFlags = (w >>> 29) & 1;
+    const imm = ((w >>> 10) & 0xfff);
+    const shift = (w >>> 22) & 1 ? ', lsl #12' : '';
+    if (setFlags && rd === 31) return [sub ? 'cmp' : 'cmn', `${reg(rn, is64, true)}, #${hex(imm)}${shift}`];
+    if (!sub && !setFlags && imm === 0 && !shift && (rd === 31 || rn === 31)) {
+      return ['mov', `${reg(rd, is64, true)}, ${reg(rn, is64, true)}`];
+    }
+    return [
+      (sub ? 'sub' : 'add') + (setFlags ? 's' : ''),
+      `${reg(rd, is64, !setFlags)}, ${reg(rn, is64, true)}, #${hex(imm)}${shift}`
+    ];
+  }
+  // Logical (immediate)
+  if ((w & 0x1f800000) === 0x12000000) {
+    const opc = (w >>> 29) & 3;
+    if (!is64 && (w >>> 22) & 1) return null;
+    const mask = decodeBitMask((w >>> 22) & 1, (w >>> 10) & 0x3f, (w >>> 16) & 0x3f, is64);
+    if (mask === null) return null;
+    if (opc === 3 && rd === 31) return ['tst', `${reg(rn, is64)}, #${hex(mask)}`];
+    if (opc === 1 && rn === 31) return ['mov', `${reg(rd, is64, true)}, #${hex(mask)}`];
+    return [['and', 'orr', 'eor', 'ands'][opc], `${reg(rd, is64, opc !== 3)}, ${reg(rn, is64)}, #${hex(mask)}`];
+  }
+  // Move wide (immediate)
+  if ((w & 0x1f800000) === 0x12800000) {
+    const opc = (w >>> 29) & 3;
+    const shift = ((w >>> 21) & 3) * 16;
+    if (!is64 && shift >= 32) return null;
+    const imm = BigInt((w >>> 5) & 0xffff) << BigInt(shift);
+    const width = is64 ? BigInt('0xffffffffffffffff') : BigInt(0xffffffff);
+    switch (opc) {
+      case 0: return ['mov', `${reg(rd, is64)}, #${hex(~imm & width)}`];
+      case 2: return ['mov', `${reg(rd, is64)}, #${hex(imm)}`];
+      case 3: return ['movk', `${reg(rd, is64)}, #${hex((w >>> 5) & 0xffff)}${shift ? `, lsl #${shift}` : ''}`];
+      default: return null;
+    }
+  }
+  // Bitfield
+  if ((w & 0x1f800000) === 0x13000000) {
+    const opc = (w >>> 29) & 3;
+    const immr = (w >>> 16) & 0x3f;
+    const imms = (w >>> 10) & 0x3f;
+    const width = is64 ? 64 : 32;
+    if (((w >>> 22) & 1) !== (is64 ? 1 : 0) || immr >= width || imms >= width) return null;
+    const d = reg(rd, is64);
+    const n = reg(rn, is64);
+    if (opc === 2 && imms === width - 1) return ['lsr', `${d}, ${n}, #${immr}`];
+    if (opc === 2 && imms + 1 === immr) return ['lsl', `${d}, ${n}, #${width - 1 - imms}`];
+    if (opc === 0 && imms === width - 1) return ['asr', `${d}, ${n}, #${immr}`];
+    if (opc === 0 && immr === 0 && (imms === 7 || imms === 15 || imms === 31)) {
+      return [['sxtb', 'sxth', 'sxtw'][imms === 7 ? 0 : imms === 15 ? 1 : 2], `${d}, ${reg(rn, false)}`];
+    }
+    if (opc === 2 && !is64 && immr === 0 && (imms === 7 || imms === 15)) {
+      return [imms === 7 ? 'uxtb' : 'uxth', `${d}, ${n}`];
+    }
+    const prefix = ['sbf', 'bf', 'ubf'][opc];
+    if (!prefix) return null;
+    if (opc === 1 && rn === 31 && imms < immr) return ['bfc', `${d}, #${(width - immr) % width}, #${imms + 1}`];
+    return imms >= immr
+      ? [opc === 1 ? 'bfxil' : `${prefix}x`, `${d}, ${n}, #${immr}, #${imms - immr + 1}`]
+      : [opc === 1 ? 'bfi' : `${prefix}iz`, `${d}, ${n}, #${(width - immr) % width}, #${imms + 1}`];
+  }
+  // Extract
+  if ((w & 0x1f800000) === 0x13800000) {
+    const rm = (w >>> 16) & 31;
+    const lsb = (w >>> 10) & 0x3f;
+    if ((w & 0x60200000) || ((w >>> 22) & 1) !== (is64 ? 1 : 0) || (!is64 && lsb >= 32)) return null;
+    return rn === rm
+      ? ['ror', `${reg(rd, is64)}, ${reg(rn, is64)}, #${lsb}`]
+      : ['extr', `${reg(rd, is64)}, ${reg(rn, is64)}, ${reg(rm, is64)}, #${lsb}`];
+  }
+  return null;
+}
+
+function decodeDataRegister(w: number): [string, string] | null {
+  const is64 = (w >>> 31) === 1;
+  const rd = w & 31;
+  const rn = (w >>> 5) & 31;
+  const rm = (w >>> 16) & 31;
+  const d = reg(rd, is64);
+  const n = reg(rn, is64);
+  const m = reg(rm, is64);
+
+  // Logical (shifted register)
+  if ((w & 0x1f000000) === 0x0a000000) {
+    const opc = ((w >>> 29) & 3) * 2 + ((w >>> 21) & 1);
+    const amount = (w >>> 10) & 0x3f;
+    if (!is64 && amount >= 32) return null;
+    const shift = amount ? `, ${SHIFTS[(w >>> 22) & 3]} #${amount}` : '';
+    if (opc === 2 && rn === 31 && !shift) return ['mov', `${d}, ${m}`];
+    if (opc === 3 && rn === 31) return ['mvn', `${d}, ${m}${shift}`];
+    if (opc === 6 && rd === 31) return ['tst', `${n}, ${m}${shift}`];
+    return [['and', 'bic', 'orr', 'orn', 'eor', 'eon', 'ands', 'bics'][opc], `${d}, ${n}, ${m}${shift}`];
+  }
+  // Add/subtract (shifted register)
+  if ((w & 0x1f200000) === 0x0b000000) {
+    const sub = (w >>> 30) & 1;
+    const setFlags = (w >>> 29) & 1;
+    const amount = (w >>> 10) & 0x3f;
+    if (((w >>> 22) & 3) === 3 || (!is64 && amount >= 32)) return null;
+    const shift = amount ? `, ${SHIFTS[(w >>> 22) & 3]} #${amount}` : '';
+    if (setFlags && rd === 31) return [sub ? 'cmp' : 'cmn', `${n}, ${m}${shift}`];
+    if (sub && rn === 31) return [setFlags ? 'negs' : 'neg', `${d}, ${m}${shift}`];
+    return [(sub ? 'sub' : 'add') + (setFlags ? 's' : ''), `${d}, ${n}, ${m}${shift}`];
+  }
+  // Add/subtract (extended register)
+  if ((w & 0x1f200000) === 0x0b200000) {
+    const sub = (w >>> 30) & 1;
+    const setFlags = (w >>> 29) & 1;
+    const option = (w >>> 13) & 7;
+    const amount = (w >>> 10) & 7;
+    if (amount > 4 || (w >>> 22) & 3) return null;
+    const source = reg(rm, is64 && (option & 3) === 3);
+    const extend = `${EXTENDS[option]}${amount ? ` #${amount}` : ''}`;
+    if (setFlags && rd === 31) return [sub ? 'cmp' : 'cmn', `${reg(rn, is64, true)}, ${source}, ${extend}`];
+    return [
+      (sub ? 'sub' : 'add') + (setFlags ? 's' : ''),
+      `${reg(rd, is64, !setFlags)}, ${reg(rn, is64, true)}, ${source}, ${extend}`
+    ];
+  }
+  // Conditional select
+  if ((w & 0x1fe00000) === 0x1a800000) {
+    if ((w & 0x20000800)) return null;
+    const op = ((w >>> 30) & 1) * 2 + ((w >>> 10) & 1);
+    const cond = (w >>> 12) & 0xf;
+    const inverted = CONDITIONS[cond ^ 1];
+    if (op === 1 && rn === 31 && rm === 31 && cond < 14) return ['cset', `${d}, ${inverted}`];
+    if (op === 2 && rn === 31 && rm === 31 && cond < 14) return ['csetm', `${d}, ${inverted}`];
+    if (op > 0 && rn === rm && rn !== 31 && cond < 14) return [['', 'cinc', 'cinv', 'cneg'][op], `${d}, ${n}, ${inverted}`];
+    return [['csel', 'csinc', 'csinv', 'csneg'][op], `${d}, ${n}, ${m}, ${CONDITIONS[cond]}`];
+  }
+  // Conditional compare (register and immediate)
+  if (((w & 0x3fe00410) >>> 0) === 0x3a400000) {
+    const name = (w >>> 30) & 1 ? 'ccmp' : 'ccmn';
+    const operand = (w >>> 11) & 1 ? `#${hex(rm)}` : m;
+    return [name, `${n}, ${operand}, #${hex(w & 0xf)}, ${CONDITIONS[(w >>> 12) & 0xf]}`];
+  }
+  // Data-processing (2 source)
+  if ((w & 0x5fe00000) === 0x1ac00000) {
+    if (w & 0x20000000) return null;
+    const name = ({ 2: 'udiv', 3: 'sdiv', 8: 'lsl', 9: 'lsr', 10: 'asr', 11: 'ror' } as Record<number, string>)[(w >>> 10) & 0x3f];
+    return name ? [name, `${d}, ${n}, ${m}`] : null;
+  }
+  // Data-processing (1 source)
+  if ((w & 0x5fe00000) === 0x5ac00000) {
+    const names = ['rbit', 'rev16', is64 ? 'rev32' : 'rev', is64 ? 'rev' : '', 'clz', 'cls'];
+    if (w & 0x201f0000) return null;
+    const name = names[(w >>> 10) & 0x3f];
+    return name ? [name, `${d}, ${n}`] : null;
+  }
+  // Data-processing (3 source)
+  if ((w & 0x1f000000) === 0x1b000000) {
+    const ra = (w >>> 10) & 31;
+    const op = ((w >>> 21) & 7) * 2 + ((w >>> 15) & 1);
+    // Only madd and msub have 32-bit forms
+    if ((w & 0x60000000) || (!is64 && op > 1)) return null;
+    switch (op) {
+      case 0: return ra === 31 ? ['mul', `${d}, ${n}, ${m}`] : ['madd', `${d}, ${n}, ${m}, ${reg(ra, is64)}`];
+      case 1: return ra === 31 ? ['mneg', `${d}, ${n}, ${m}`] : ['msub', `${d}, ${n}, ${m}, ${reg(ra, is64)}`];
+      case 2:
+      case 3:
+      case 10:
+      case 11: {
+        const signed = op < 8 ? 's' : 'u';
+        const subtract = op & 1;
+        return ra === 31
+          ? [`${signed}${subtract ? 'mnegl' : 'mull'}`, `${d}, ${reg(rn, false)}, ${reg(rm, false)}`]
+          : [`${signed}m${subtract ? 'subl' : 'addl'}`, `${d}, ${reg(rn, false)}, ${reg(rm, false)}, ${reg(ra, true)}`];
+      }
+      case 4: return ['smulh', `${d}, ${n}, ${m}`];
+      case 12: return ['umulh', `${d}, ${n}, ${m}`];
+      default: return null;
+    }
+  }
+  return null;
+}
+
+// Register name of a load/store transfer register
+const transferRegister = (n: number, size: number, simd: boolean, is64: boolean) =>
+  simd ? `${['b', 'h', 's', 'd', 'q'][size]}${n}` : reg(n, is64);
+
+function decodeLoadStore(w: number, pc: number): [string, string] | null {
+  const rt = w & 31;
+  const rn = (w >>> 5) & 31;
+  const base = reg(rn, true, true);
+
+  // Load/store pair
+  if ((w & 0x3a000000) === 0x28000000) {
+    const opc = w >>> 30;
+    const simd = ((w >>> 26) & 1) === 1;
+    const mode = (w >>> 23) & 3;
+    const load = (w >>> 22) & 1;
+    const size = simd ? 2 + opc : opc === 2 ? 3 : 2;
+    const offset = signExtend((w >>> 15) & 0x7f, 7) * (1 << size);
+    const is64 = opc !== 0;
+    // opc 3 is reserved, and opc 1 without SIMD only exists as ldpsw
+    if (opc === 3 || (!simd && opc === 1 && (!load || mode === 0))) return null;
+    const name = (mode === 0 ? (load ? 'ldnp' : 'stnp') : (load ? 'ldp' : 'stp')) + (!simd && opc === 1 ? 'sw' : '');
+    const registers = `${transferRegister(rt, size, simd, is64)}, ${transferRegister((w >>> 10) & 31, size, simd, is64)}`;
+    const address = mode === 1 ? `[${base}], #${offset}`
+      : mode === 3 ? `[${base}, #${offset}]!`
+      : offset ? `[${base}, #${offset}]` : `[${base}]`;
+    return [name, `${registers}, ${address}`];
+  }
+  // Load register (literal)
+  if ((w & 0x3b000000) === 0x18000000) {
+    const opc = w >>> 30;
+    const simd = ((w >>> 26) & 1) === 1;
+    const address = target(pc, signExtend((w >>> 5) & 0x7ffff, 19) * 4);
+    if (simd) return opc === 3 ? null : ['ldr', `${transferRegister(rt, 2 + opc, true, false)}, ${address}`];
+    if (opc === 3) return ['prfm', `${prefetchOperation(rt)}, ${address}`];
+    return [opc === 2 ? 'ldrsw' : 'ldr', `${reg(rt, opc !== 0)}, ${address}`];
+  }
+  // Load/store exclusive and ordered
+  if ((w & 0x3f000000) === 0x08000000) {
+    const size = w >>> 30;
+    const ordered = (w >>> 23) & 1;
+    const load = (w >>> 22) & 1;
+    const pair = (w >>> 21) & 1;
+    const acquireRelease = (w >>> 15) & 1;
+    const rs = (w >>> 16) & 31;
+    const rt2 = (w >>> 10) & 31;
+    const suffix = ['b', 'h', '', ''][size];
+    const is64 = size === 3;
+    if (pair) {
+      // Compare and swap (LSE): cas, casp and their ordering variants
+      const ordering = `${load ? 'a' : ''}${acquireRelease ? 'l' : ''}`;
+      if (rt2 !== 31 && (ordered || size < 2)) return null;
+      if (ordered) return [`cas${ordering}${suffix}`, `${reg(rs, is64)}, ${reg(rt, is64)}, [${base}]`];
+      if (size < 2) {
+        if ((rs & 1) || (rt & 1)) return null;
+        const wide = size === 1;
+        return [
+          `casp${ordering}`,
+          `${reg(rs, wide)}, ${reg(rs + 1, wide)}, ${reg(rt, wide)}, ${reg(rt + 1, wide)}, [${base}]`
+        ];
+      }
+      // Exclusive pair
+      const pairIs64 = size === 3;
+      return load
+        ? [acquireRelease ? 'ldaxp' : 'ldxp', `${reg(rt, pairIs64)}, ${reg(rt2, pairIs64)}, [${base}]`]
+        : [acquireRelease ? 'stlxp' : 'stxp', `${reg(rs, false)}, ${reg(rt, pairIs64)}, ${reg(rt2, pairIs64)}, [${base}]`];
+    }
+    if (ordered) {
+      return load
+        ? [`${acquireRelease ? 'ldar' : 'ldlar'}${suffix}`, `${reg(rt, is64)}, [${base}]`]
+        : [`${acquireRelease ? 'stlr' : 'stllr'}${suffix}`, `${reg(rt, is64)}, [${base}]`];
+    }
+    return load
+      ? [`${acquireRelease ? 'ldaxr' : 'ldxr'}${suffix}`, `${reg(rt, is64)}, [${base}]`]
+      : [`${acquireRelease ? 'stlxr' : 'stxr'}${suffix}`, `${reg(rs, false)}, ${reg(rt, is64)}, [${base}]`];
+  }
+  // Atomic memory operations (LSE): ld<op>, st<op> and swp
+  if (((w & 0x3f200c00) >>> 0) === 0x38200000) {
+    const size = w >>> 30;
+    const acquire = (w >>> 23) & 1;
+    const release = (w >>> 22) & 1;
+    const rs = (w >>> 16) & 31;
+    const op = (w >>> 12) & 7;
+    const suffix = ['b', 'h', '', ''][size];
+    const is64 = size === 3;
+    if ((w >>> 15) & 1) {
+      if (op === 4 && acquire && !release && rs === 31) return [`ldapr${suffix}`, `${reg(rt, is64)}, [${base}]`];
+      if (op !== 0) return null;
+      return [`swp${acquire ? 'a' : ''}${release ? 'l' : ''}${suffix}`, `${reg(rs, is64)}, ${reg(rt, is64)}, [${base}]`];
+    }
+    const operation = ['add', 'clr', 'eor', 'set', 'smax', 'smin', 'umax', 'umin'][op];
+    // Without a destination (and without acquire) the preferred form is st<op>
+    if (rt === 31 && !acquire) return [`st${operation}${release ? 'l' : ''}${suffix}`, `${reg(rs, is64)}, [${base}]`];
+    return [`ld${operation}${acquire ? 'a' : ''}${release ? 'l' : ''}${suffix}`, `${reg(rs, is64)}, ${reg(rt, is64)}, [${base}]`];
+  }
+  // Load/store register: unsigned offset, unscaled, pre/post-index and register offset
+  if ((w & 0x3a000000) !== 0x38000000) return null;
+  const sizeBits = w >>> 30;
+  const simd = ((w >>> 26) & 1) === 1;
+  const opc = (w >>> 22) & 3;
+  const unsignedOffset = ((w >>> 24) & 1) === 1;
+
+  let name: string;
+  let size = sizeBits;
+  let is64 = sizeBits === 3;
+  if (simd) {
+    // The 128-bit forms are encoded with size 0
+    if (opc >= 2) {
+      if (sizeBits !== 0) return null;
+      size = 4;
+    }
+    name = opc & 1 ? 'ldr' : 'str';
+  } else if (opc === 0 || opc === 1) {
+    name = (opc ? 'ldr' : 'str') + ['b', 'h', '', ''][sizeBits];
+  } else if (sizeBits === 3) {
+    if (opc === 3) return null;
+    name = 'prfm';
+  } else if (sizeBits === 2) {
+    if (opc === 3) return null;
+    name = 'ldrsw';
+    is64 = true;
+  } else {
+    name = 'ldrs' + ['b', 'h'][sizeBits];
+    is64 = opc === 2;
+  }
+  const transfer = name === 'prfm' ? prefetchOperation(rt) : transferRegister(rt, size, simd, is64);
+
+  if (unsignedOffset) {
+    const offset = ((w >>> 10) & 0xfff) * (1 << size);
+    return [name, `${transfer}, ${offset ? `[${base}, #${offset}]` : `[${base}]`}`];
+  }
+  if ((w >>> 21) & 1) {
+    const option = (w >>> 13) & 7;
+    if (((w >>> 10) & 3) !== 2 || !(option & 2)) return null;
+    const amount = (w >>> 12) & 1 ? size : 0;
+    const index = reg((w >>> 16) & 31, (option & 3) === 3);
+    const extend = option === 3 ? (amount ? `, lsl #${amount}` : '') : `, ${EXTENDS[option]}${amount ? ` #${amount}` : ''}`;
+    return [name, `${transfer}, [${base}, ${index}${extend}]`];
+  }
+  const offset = signExtend((w >>> 12) & 0x1ff, 9);
+  const indexMode = (w >>> 10) & 3;
+  // There are no unprivileged SIMD accesses and no indexed or unprivileged prefetch
+  if ((simd && indexMode === 2) || (name === 'prfm' && indexMode !== 0)) return null;
+  switch (indexMode) {
+    case 0: return [name.replace(/^(ld|st)r/, '$1ur').replace('prfm', 'prfum'), `${transfer}, ${offset ? `[${base}, #${offset}]` : `[${base}]`}`];
+    case 1: return [name, `${transfer}, [${base}], #${offset}`];
+    case 3: return [name, `${transfer}, [${base}, #${offset}]!`];
+    default: return [name.replace(/^(ld|st)r/, '$1tr'), `${transfer}, ${offset ? `[${base}, #${offset}]` : `[${base}]`}`];
+  }
+}
+
+function decodeFloatingPoint(w: number): [string, string] | null {
+  const prefix = FP_PREFIXES[(w >>> 22) & 3];
+  const rd = w & 31;
+  const rn = (w >>> 5) & 31;
+  const rm = (w >>> 16) & 31;
+
+  // Data-processing (3 source): fused multiply-add
+  if ((w & 0xff000000) === 0x1f000000) {
+    if (!prefix) return null;
+    const name = ['fmadd', 'fmsub', 'fnmadd', 'fnmsub'][((w >>> 21) & 1) * 2 + ((w >>> 15) & 1)];
+    return [name, `${prefix}${rd}, ${prefix}${rn}, ${prefix}${rm}, ${prefix}${(w >>> 10) & 31}`];
+  }
+  // Conversion between floating-point and fixed-point
+  if ((w & 0x7f200000) === 0x1e000000 && prefix) {
+    const is64 = (w >>> 31) === 1;
+    const fbits = 64 - ((w >>> 10) & 0x3f);
+    const name = ({ 0x02: 'scvtf', 0x03: 'ucvtf', 0x18: 'fcvtzs', 0x19: 'fcvtzu' } as Record<number, string>)[(w >>> 16) & 0x1f];
+    if (!name || (!is64 && fbits > 32)) return null;
+    return name.endsWith('cvtf')
+      ? [name, `${prefix}${rd}, ${reg(rn, is64)}, #${fbits}`]
+      : [name, `${reg(rd, is64)}, ${prefix}${rn}, #${fbits}`];
+  }
+  if ((w & 0x5f200000) !== 0x1e200000 || !prefix) return null;
+  // M and S must be clear; bit 31 is only sf of the integer conversions
+  if ((w & 0x20000000) || ((w >>> 31) && (w & 0x0000fc00) !== 0)) return null;
+
+  // Data-processing (2 source)
+  if ((w & 0x00000c00) === 0x00000800) {
+    const names = ['fmul', 'fdiv', 'fadd', 'fsub', 'fmax', 'fmin', 'fmaxnm', 'fminnm', 'fnmul'];
+    const name = names[(w >>> 12) & 0xf];
+    return name ? [name, `${prefix}${rd}, ${prefix}${rn}, ${prefix}${rm}`] : null;
+  }
+  // Conditional compare
+  if ((w & 0x00000c00) === 0x00000400) {
+    return [
+      (w >>> 4) & 1 ? 'fccmpe' : 'fccmp',
+      `${prefix}${rn}, ${prefix}${rm}, #${hex(w & 0xf)}, ${CONDITIONS[(w >>> 12) & 0xf]}`
+    ];
+  }
+  // Conditional select
+  if ((w & 0x00000c00) === 0x00000c00) {
+    return ['fcsel', `${prefix}${rd}, ${prefix}${rn}, ${prefix}${rm}, ${CONDITIONS[(w >>> 12) & 0xf]}`];
+  }
+  // Data-processing (1 source)
+  if ((w & 0x00007c00) === 0x00004000) {
+    const opcode = (w >>> 15) & 0x3f;
+    const names = ['fmov', 'fabs', 'fneg', 'fsqrt'];
+    if (opcode < 4) return [names[opcode], `${prefix}${rd}, ${prefix}${rn}`];
+    if (opcode >= 4 && opcode <= 7) return ['fcvt', `${FP_PREFIXES[opcode & 3]}${rd}, ${prefix}${rn}`];
+    return null;
+  }
+  // Compare
+  if ((w & 0x0000fc00) === 0x00002000) {
+    const name = (w >>> 4) & 1 ? 'fcmpe' : 'fcmp';
+    return [name, (w >>> 3) & 1 ? `${prefix}${rn}, #0.0` : `${prefix}${rn}, ${prefix}${rm}`];
+  }
+  // Move immediate
+  if ((w & 0x00001fe0) === 0x00001000) {
+    // VFPExpandImm: sign, 3-bit exponent and 4-bit fraction
+    const imm = (w >>> 13) & 0xff;
+    const value = (imm & 0x80 ? -1 : 1) * (16 + (imm & 0xf)) / 16 * Math.pow(2, (((imm >>> 4) & 7) ^ 4) - 3);
+    return ['fmov', `${prefix}${rd}, #${value.toExponential(18)}`];
+  }
+  // Conversion between floating-point and integer
+  if ((w & 0x0000fc00) === 0x00000000) {
+    const is64 = (w >>> 31) === 1;
+    const rmode = (w >>> 19) & 3;
+    const opcode = (w >>> 16) & 7;
+    const names: Record<number, string> = {
+      0x00: 'fcvtns', 0x01: 'fcvtnu', 0x02: 'scvtf', 0x03: 'ucvtf', 0x04: 'fcvtas', 0x05: 'fcvtau',
+      0x06: 'fmov', 0x07: 'fmov', 0x08: 'fcvtps', 0x09: 'fcvtpu', 0x10: 'fcvtms', 0x11: 'fcvtmu',
+      0x18: 'fcvtzs', 0x19: 'fcvtzu'
+    };
+    const name = names[rmode * 8 + opcode];
+    if (!name) return null;
+    const toFloat = opcode === 2 || opcode === 3 || opcode === 7;
+    return toFloat
+      ? [name, `${prefix}${rd}, ${reg(rn, is64)}`]
+      : [name, `${reg(rd, is64)}, ${prefix}${rn}`];
+  }
+  return null;
+}
+
+export function disassembleAarch64(code: Buffer, address: number, littleEndian: boolean): DecodedInstruction[] {
+  const instructions: DecodedInstruction[] = [];
+  for (let offset = 0; offset + 4 <= code.length; offset += 4) {
+    const pc = address + offset;
+    const w = littleEndian ? code.readInt32LE(offset) : code.readInt32BE(offset);
+    let decoded: [string, string] | null = null;
+    switch ((w >>> 25) & 0xf) {
+      case 0x8:
+      case 0x9:
+        decoded = decodeDataImmediate(w, pc);
+        break;
+      case 0xa:
+      case 0xb:
+        decoded = decodeBranch(w, pc) || decodeSystem(w);
+        break;
+      case 0x5:
+      case 0xd:
+        decoded = decodeDataRegister(w);
+        break;
+      case 0x4:
+      case 0x6:
+      case 0xc:
+      case 0xe:
+        decoded = decodeLoadStore(w, pc);
+        break;
+      case 0x7:
+      case 0xf:
+        decoded = decodeFloatingPoint(w);
+        break;
+    }
+    instructions.push({
+      address: pc,
+      bytes: 4,
+      encoding: (w >>> 0).toString(16).padStart(8, '0'),
+      mnemonic: decoded ? decoded[0] : '.inst',
+      operands: decoded ? decoded[1] : `${hex(w >>> 0)} ; undefined`
+    });
+  }
+  return instructions;
+}
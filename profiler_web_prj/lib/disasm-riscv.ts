@@ -0,0 +1,384 @@
+import { DecodedInstruction } from './disassembler';
+
+/**
+ * RISC-V decoder for RV32/RV64 IMAFD, Zicsr and the C extension. Output
+ * follows GNU objdump: ABI register names, common pseudo-instructions and
+ * compressed instructions shown in their expanded form.
+ */
+
+const X = [
+  'zero', 'ra', 'sp', 'gp', 'tp', 't0', 't1', 't2', 's0', 's1',
+  'a0', 'a1', 'a2', 'a3', 'a4', 'a5', 'a6', 'a7',
+  's2', 's3', 's4', 's5', 's6', 's7', 's8', 's9', 's10', 's11',
+  't3', 't4', 't5', 't6'
+];
+const F = [
+  'ft0', 'ft1', 'ft2', 'ft3', 'ft4', 'ft5', 'ft6', 'ft7', 'fs0', 'fs1',
+  'fa0', 'fa1', 'fa2', 'fa3', 'fa4', 'fa5', 'fa6', 'fa7',
+  'fs2', 'fs3', 'fs4', 'fs5', 'fs6', 'fs7', 'fs8', 'fs9', 'fs10', 'fs11',
+  'ft8', 'ft9', 'ft10', 'ft11'
+];
+
+const CSRS: Record<number, string> = {
+  0x001: 'fflags', 0x002: 'frm', 0x003: 'fcsr',
+  0x100: 'sstatus', 0x104: 'sie', 0x105: 'stvec', 0x140: 'sscratch', 0x141: 'sepc', 0x142: 'scause',
+  0x143: 'stval', 0x144: 'sip', 0x180: 'satp',
+  0x300: 'mstatus', 0x301: 'misa', 0x302: 'medeleg', 0x303: 'mideleg', 0x304: 'mie', 0x305: 'mtvec',
+  0x340: 'mscratch', 0x341: 'mepc', 0x342: 'mcause', 0x343: 'mtval', 0x344: 'mip',
+  0xb00: 'mcycle', 0xb02: 'minstret', 0xc00: 'cycle', 0xc01: 'time', 0xc02: 'instret',
+  0xf11: 'mvendorid', 0xf12: 'marchid', 0xf13: 'mimpid', 0xf14: 'mhartid'
+};
+
+const hex = (value: number) => '0x' + (value >>> 0).toString(16);
+const target = (pc: number, offset: number) => (pc + offset).toString(16);
+const signExtend = (value: number, bits: number) => (value << (32 - bits)) >> (32 - bits);
+const mem = (offset: number, base: number) => `${offset}(${X[base]})`;
+
+// Static rounding mode operand; the dynamic mode (7) is implied, 5 and 6 are reserved
+const ROUNDING_MODES = ['rne', 'rtz', 'rdn', 'rup', 'rmm'];
+const rounded = (name: string, operands: string, rm: number): [string, string] | null =>
+  rm === 7 ? [name, operands] : ROUNDING_MODES[rm] ? [name, `${operands},${ROUNDING_MODES[rm]}`] : null;
+
+// Predecessor or successor set of fence, e.g. rw
+const fenceSet = (bits: number) => bits ? ['i', 'o', 'r', 'w'].filter((_, i) => bits & (8 >>> i)).join('') : '0';
+
+function decode32(w: number, pc: number, xlen: 32 | 64): [string, string] | null {
+  const opcode = w & 0x7f;
+  const rd = (w >>> 7) & 31;
+  const funct3 = (w >>> 12) & 7;
+  const rs1 = (w >>> 15) & 31;
+  const rs2 = (w >>> 20) & 31;
+  const funct7 = w >>> 25;
+  const immI = w >> 20;
+  const immS = ((w >> 25) << 5) | ((w >>> 7) & 31);
+  const immB = ((w >> 31) << 12) | (((w >>> 7) & 1) << 11) | (((w >>> 25) & 0x3f) << 5) | (((w >>> 8) & 0xf) << 1);
+  const immJ = ((w >> 31) << 20) | (((w >>> 12) & 0xff) << 12) | (((w >>> 20) & 1) << 11) | (((w >>> 21) & 0x3ff) << 1);
+
+  switch (opcode) {
+    case 0x37: return ['lui', `${X[rd]},${hex(w >>> 12)}`];
+    case 0x17: return ['auipc', `${X[rd]},${hex(w >>> 12)}`];
+    case 0x6f:
+      if (rd === 0) return ['j', target(pc, immJ)];
+      if (rd === 1) return ['jal', target(pc, immJ)];
+      return ['jal', `${X[rd]},${target(pc, immJ)}`];
+    case 0x67:
+      if (funct3 !== 0) return null;
+      if (rd === 0 && rs1 === 1 && immI === 0) return ['ret', ''];
+      if (rd === 0 && immI === 0) return ['jr', X[rs1]];
+      if (rd === 1 && immI === 0) return ['jalr', X[rs1]];
+      return ['jalr', `${X[rd]},${mem(immI, rs1)}`];
+    case 0x63: {
+      const names = ['beq', 'bne', '', '', 'blt', 'bge', 'bltu', 'bgeu'];
+      if (!names[funct3]) return null;
+      const to = target(pc, immB);
+      if (rs2 === 0 && funct3 <= 5) return [`${names[funct3]}z`, `${X[rs1]},${to}`];
+      if (rs1 === 0 && funct3 === 4) return ['bgtz', `${X[rs2]},${to}`];
+      if (rs1 === 0 && funct3 === 5) return ['blez', `${X[rs2]},${to}`];
+      return [names[funct3], `${X[rs1]},${X[rs2]},${to}`];
+    }
+    case 0x03: {
+      const names = ['lb', 'lh', 'lw', 'ld', 'lbu', 'lhu', 'lwu'];
+      if (!names[funct3]) return null;
+      return [names[funct3], `${X[rd]},${mem(immI, rs1)}`];
+    }
+    case 0x23: {
+      const names = ['sb', 'sh', 'sw', 'sd'];
+      if (!names[funct3]) return null;
+      return [names[funct3], `${X[rs2]},${mem(immS, rs1)}`];
+    }
+    case 0x07:
+    case 0x27: {
+      const width = funct3 === 2 ? 'w' : funct3 === 3 ? 'd' : '';
+      if (!width) return null;
+      return opcode === 0x07
+        ? [`fl${width}`, `${F[rd]},${mem(immI, rs1)}`]
+        : [`fs${width}`, `${F[rs2]},${mem(immS, rs1)}`];
+    }
+    case 0x13: {
+      const shamt = (w >>> 20) & (xlen === 64 ? 0x3f : 0x1f);
+      switch (funct3) {
+        case 0:
+          if (rd === 0 && rs1 === 0 && immI === 0) return ['nop', ''];
+          if (rs1 === 0) return ['li', `${X[rd]},${immI}`];
+          if (immI === 0) return ['mv', `${X[rd]},${X[rs1]}`];
+          return ['addi', `${X[rd]},${X[rs1]},${immI}`];
+        case 1: return (w >>> 26) === 0 ? ['slli', `${X[rd]},${X[rs1]},${hex(shamt)}`] : null;
+        case 2: return ['slti', `${X[rd]},${X[rs1]},${immI}`];
+        case 3: return immI === 1 ? ['seqz', `${X[rd]},${X[rs1]}`] : ['sltiu', `${X[rd]},${X[rs1]},${immI}`];
+        case 4: return immI === -1 ? ['not', `${X[rd]},${X[rs1]}`] : ['xori', `${X[rd]},${X[rs1]},${immI}`];
+        case 5:
+          if (((w >>> 26) & 0x2f) !== 0) return null;
+          return [(w >>> 30) & 1 ? 'srai' : 'srli', `${X[rd]},${X[rs1]},${hex(shamt)}`];
+        case 6: return ['ori', `${X[rd]},${X[rs1]},${immI}`];
+        default: return ['andi', `${X[rd]},${X[rs1]},${immI}`];
+      }
+    }
+    case 0x1b: {
+      if (xlen !== 64) return null;
+      if (funct3 === 0) {
+        return immI === 0 ? ['sext.w', `${X[rd]},${X[rs1]}`] : ['addiw', `${X[rd]},${X[rs1]},${immI}`];
+      }
+      if (funct3 === 1 && funct7 === 0) return ['slliw', `${X[rd]},${X[rs1]},${hex(rs2)}`];
+      if (funct3 === 5 && (funct7 === 0 || funct7 === 0x20)) return [funct7 ? 'sraiw' : 'srliw', `${X[rd]},${X[rs1]},${hex(rs2)}`];
+      return null;
+    }
+    case 0x33:
+    case 0x3b: {
+      const word = opcode === 0x3b;
+      if (word && xlen !== 64) return null;
+      let name: string | undefined;
+      if (funct7 === 0x01) {
+        name = (word
+          ? ['mulw', '', '', '', 'divw', 'divuw', 'remw', 'remuw']
+          : ['mul', 'mulh', 'mulhsu', 'mulhu', 'div', 'divu', 'rem', 'remu'])[funct3];
+      } else if (funct7 === 0x00) {
+        name = (word
+          ? ['addw', 'sllw', '', '', '', 'srlw', '', '']
+          : ['add', 'sll', 'slt', 'sltu', 'xor', 'srl', 'or', 'and'])[funct3];
+      } else if (funct7 === 0x20) {
+        name = funct3 === 0 ? (word ? 'subw' : 'sub') : funct3 === 5 ? (word ? 'sraw' : 'sra') : undefined;
+      }
+      if (!name) return null;
+      if (rs1 === 0 && (name === 'sub' || name === 'subw')) return [name === 'sub' ? 'neg' : 'negw', `${X[rd]},${X[rs2]}`];
+      if (rs1 === 0 && name === 'sltu') return ['snez', `${X[rd]},${X[rs2]}`];
+      return [name, `${X[rd]},${X[rs1]},${X[rs2]}`];
+    }
+    case 0x2f: {
+      const width = funct3 === 2 ? 'w' : funct3 === 3 ? 'd' : '';
+      const names: Record<number, string> = {
+        0x00: 'amoadd', 0x01: 'amoswap', 0x02: 'lr', 0x03: 'sc', 0x04: 'amoxor', 0x08: 'amoor',
+        0x0c: 'amoand', 0x10: 'amomin', 0x14: 'amomax', 0x18: 'amominu', 0x1c: 'amomaxu'
+      };
+      const name = names[w >>> 27];
+      if (!width || !name || (name === 'lr' && rs2 !== 0)) return null;
+      const ordering = ['', '.rl', '.aq', '.aqrl'][(w >>> 25) & 3];
+      const mnemonic = `${name}.${width}${ordering}`;
+      return name === 'lr'
+        ? [mnemonic, `${X[rd]},(${X[rs1]})`]
+        : [mnemonic, `${X[rd]},${X[rs2]},(${X[rs1]})`];
+    }
+    case 0x0f: {
+      if (funct3 === 1) return ['fence.i', ''];
+      // fm, rs1 and rd are reserved apart from fence.tso
+      if (funct3 !== 0 || (w & 0xf00fff80)) {
+        return (w >>> 0) === 0x8330000f ? ['fence.tso', ''] : null;
+      }
+      const pred = (w >>> 24) & 0xf;
+      const succ = (w >>> 20) & 0xf;
+      return pred === 0xf && succ === 0xf ? ['fence', ''] : ['fence', `${fenceSet(pred)},${fenceSet(succ)}`];
+    }
+    case 0x73: {
+      if (funct3 === 0) {
+        const system: Record<number, string> = {
+          0x00000073: 'ecall', 0x00100073: 'ebreak', 0x10200073: 'sret',
+          0x30200073: 'mret', 0x10500073: 'wfi'
+        };
+        if (system[w >>> 0]) return [system[w >>> 0], ''];
+        if (funct7 === 0x09 && rd === 0) return ['sfence.vma', rs1 || rs2 ? `${X[rs1]},${X[rs2]}` : ''];
+        return null;
+      }
+      const csr = w >>> 20;
+      const csrName = CSRS[csr] || hex(csr);
+      const names = ['', 'csrrw', 'csrrs', 'csrrc', '', 'csrrwi', 'csrrsi', 'csrrci'];
+      if (!names[funct3]) return null;
+      const source = funct3 >= 5 ? `${rs1}` : X[rs1];
+      if (funct3 === 2 && rs1 === 0) return ['csrr', `${X[rd]},${csrName}`];
+      if (rd === 0) return [names[funct3].replace('csrr', 'csr'), `${csrName},${source}`];
+      return [names[funct3], `${X[rd]},${csrName},${source}`];
+    }
+    case 0x43:
+    case 0x47:
+    case 0x4b:
+    case 0x4f: {
+      const fmt = funct7 & 3;
+      if (fmt > 1) return null;
+      const name = ['fmadd', 'fmsub', 'fnmsub', 'fnmadd'][(opcode >>> 2) & 3];
+      return rounded(`${name}.${fmt ? 'd' : 's'}`, `${F[rd]},${F[rs1]},${F[rs2]},${F[w >>> 27]}`, funct3);
+    }
+    case 0x53: {
+      if ((funct7 & 3) > 1) return null; // half and quad precision
+      const fmt = funct7 & 3 ? 'd' : 's';
+      const intFmt = ['w', 'wu', 'l', 'lu'][rs2 & 3];
+      switch (funct7 >>> 2) {
+        case 0x00: return rounded(`fadd.${fmt}`, `${F[rd]},${F[rs1]},${F[rs2]}`, funct3);
+        case 0x01: return rounded(`fsub.${fmt}`, `${F[rd]},${F[rs1]},${F[rs2]}`, funct3);
+        case 0x02: return rounded(`fmul.${fmt}`, `${F[rd]},${F[rs1]},${F[rs2]}`, funct3);
+        case 0x03: return rounded(`fdiv.${fmt}`, `${F[rd]},${F[rs1]},${F[rs2]}`, funct3);
+        case 0x0b: return rs2 ? null : rounded(`fsqrt.${fmt}`, `${F[rd]},${F[rs1]}`, funct3);
+        case 0x04:
+          if (funct3 > 2) return null;
+          if (rs1 === rs2) return [[`fmv.${fmt}`, `fneg.${fmt}`, `fabs.${fmt}`][funct3], `${F[rd]},${F[rs1]}`];
+          return [[`fsgnj.${fmt}`, `fsgnjn.${fmt}`, `fsgnjx.${fmt}`][funct3], `${F[rd]},${F[rs1]},${F[rs2]}`];
+        case 0x05:
+          if (funct3 > 1) return null;
+          return [funct3 ? `fmax.${fmt}` : `fmin.${fmt}`, `${F[rd]},${F[rs1]},${F[rs2]}`];
+        // Widening conversions are exact and show no rounding mode
+        case 0x08:
+          if (rs2 !== (fmt === 'd' ? 0 : 1)) return null;
+          return fmt === 'd' ? ['fcvt.d.s', `${F[rd]},${F[rs1]}`] : rounded('fcvt.s.d', `${F[rd]},${F[rs1]}`, funct3);
+        case 0x14:
+          if (funct3 > 2) return null;
+          return [[`fle.${fmt}`, `flt.${fmt}`, `feq.${fmt}`][funct3], `${X[rd]},${F[rs1]},${F[rs2]}`];
+        case 0x18: return rs2 > 3 ? null : rounded(`fcvt.${intFmt}.${fmt}`, `${X[rd]},${F[rs1]}`, funct3);
+        case 0x1a:
+          if (rs2 > 3) return null;
+          if (fmt === 'd' && rs2 < 2) return [`fcvt.d.${intFmt}`, `${F[rd]},${X[rs1]}`];
+          return rounded(`fcvt.${fmt}.${intFmt}`, `${F[rd]},${X[rs1]}`, funct3);
+        case 0x1c:
+          if (rs2 !== 0 || funct3 > 1 || (funct3 === 0 && fmt === 'd' && xlen === 32)) return null;
+          if (funct3 === 1) return [`fclass.${fmt}`, `${X[rd]},${F[rs1]}`];
+          return [fmt === 'd' ? 'fmv.x.d' : 'fmv.x.w', `${X[rd]},${F[rs1]}`];
+        case 0x1e:
+          if (rs2 !== 0 || funct3 !== 0 || (fmt === 'd' && xlen === 32)) return null;
+          return [fmt === 'd' ? 'fmv.d.x' : 'fmv.w.x', `${F[rd]},${X[rs1]}`];
+        default: return null;
+      }
+    }
+    default:
+      return null;
+  }
+}
+
+function decode16(h: number, pc: number, xlen: 32 | 64): [string, string] | null {
+  const funct3 = h >>> 13;
+  const rdFull = (h >>> 7) & 31;
+  const rs2Full = (h >>> 2) & 31;
+  const rdShort = 8 + ((h >>> 2) & 7);
+  const rs1Short = 8 + ((h >>> 7) & 7);
+  const imm6 = signExtend((((h >>> 12) & 1) << 5) | ((h >>> 2) & 31), 6);
+  const shamt = (((h >>> 12) & 1) << 5) | ((h >>> 2) & 31);
+  const offsetJ = signExtend(
+    (((h >>> 12) & 1) << 11) | (((h >>> 11) & 1) << 4) | (((h >>> 9) & 3) << 8) | (((h >>> 8) & 1) << 10) |
+    (((h >>> 7) & 1) << 6) | (((h >>> 6) & 1) << 7) | (((h >>> 3) & 7) << 1) | (((h >>> 2) & 1) << 5), 12);
+  // Scaled offsets of the register-relative loads and stores
+  const offsetW = (((h >>> 10) & 7) << 3) | (((h >>> 6) & 1) << 2) | (((h >>> 5) & 1) << 6);
+  const offsetD = (((h >>> 10) & 7) << 3) | (((h >>> 5) & 3) << 6);
+
+  switch (h & 3) {
+    case 0:
+      switch (funct3) {
+        case 0: {
+          const imm = (((h >>> 6) & 1) << 2) | (((h >>> 5) & 1) << 3) | (((h >>> 11) & 3) << 4) | (((h >>> 7) & 0xf) << 6);
+          return imm ? ['addi', `${X[rdShort]},sp,${imm}`] : null;
+        }
+        case 1: return ['fld', `${F[rdShort]},${mem(offsetD, rs1Short)}`];
+        case 2: return ['lw', `${X[rdShort]},${mem(offsetW, rs1Short)}`];
+        case 3: return xlen === 64
+          ? ['ld', `${X[rdShort]},${mem(offsetD, rs1Short)}`]
+          : ['flw', `${F[rdShort]},${mem(offsetW, rs1Short)}`];
+        case 5: return ['fsd', `${F[rdShort]},${mem(offsetD, rs1Short)}`];
+        case 6: return ['sw', `${X[rdShort]},${mem(offsetW, rs1Short)}`];
+        case 7: return xlen === 64
+          ? ['sd', `${X[rdShort]},${mem(offsetD, rs1Short)}`]
+          : ['fsw', `${F[rdShort]},${mem(offsetW, rs1Short)}`];
+        default: return null;
+      }
+    case 1:
+      switch (funct3) {
+        case 0: return rdFull === 0 ? ['nop', ''] : ['addi', `${X[rdFull]},${X[rdFull]},${imm6}`];
+        case 1:
+          if (xlen === 32) return ['jal', target(pc, offsetJ)];
+          if (rdFull === 0) return null;
+          return imm6 === 0 ? ['sext.w', `${X[rdFull]},${X[rdFull]}`] : ['addiw', `${X[rdFull]},${X[rdFull]},${imm6}`];
+        case 2: return ['li', `${X[rdFull]},${imm6}`];
+        case 3:
+          if (rdFull === 2) {
+            const imm = signExtend(
+              (((h >>> 12) & 1) << 9) | (((h >>> 6) & 1) << 4) | (((h >>> 5) & 1) << 6) |
+              (((h >>> 3) & 3) << 7) | (((h >>> 2) & 1) << 5), 10);
+            return ['addi', `sp,sp,${imm}`];
+          }
+          return ['lui', `${X[rdFull]},${hex(imm6 & 0xfffff)}`];
+        case 4: {
+          const rd = X[rs1Short];
+          switch ((h >>> 10) & 3) {
+            case 0: return ['srli', `${rd},${rd},${hex(shamt)}`];
+            case 1: return ['srai', `${rd},${rd},${hex(shamt)}`];
+            case 2: return ['andi', `${rd},${rd},${imm6}`];
+            default: {
+              const name = ((h >>> 12) & 1)
+                ? ['subw', 'addw', '', ''][(h >>> 5) & 3]
+                : ['sub', 'xor', 'or', 'and'][(h >>> 5) & 3];
+              return name ? [name, `${rd},${rd},${X[rdShort]}`] : null;
+            }
+          }
+        }
+        case 5: return ['j', target(pc, offsetJ)];
+        default: {
+          const offset = signExtend(
+            (((h >>> 12) & 1) << 8) | (((h >>> 10) & 3) << 3) | (((h >>> 5) & 3) << 6) |
+            (((h >>> 3) & 3) << 1) | (((h >>> 2) & 1) << 5), 9);
+          return [funct3 === 6 ? 'beqz' : 'bnez', `${X[rs1Short]},${target(pc, offset)}`];
+        }
+      }
+    default:
+      switch (funct3) {
+        case 0: return ['slli', `${X[rdFull]},${X[rdFull]},${hex(shamt)}`];
+        case 1:
+        case 3: {
+          const offset = (((h >>> 12) & 1) << 5) | (((h >>> 5) & 3) << 3) | (((h >>> 2) & 7) << 6);
+          if (funct3 === 3 && xlen === 64) return rdFull ? ['ld', `${X[rdFull]},${offset}(sp)`] : null;
+          if (funct3 === 1) return ['fld', `${F[rdFull]},${offset}(sp)`];
+          const offsetW = (((h >>> 12) & 1) << 5) | (((h >>> 4) & 7) << 2) | (((h >>> 2) & 3) << 6);
+          return ['flw', `${F[rdFull]},${offsetW}(sp)`];
+        }
+        case 2: {
+          const offset = (((h >>> 12) & 1) << 5) | (((h >>> 4) & 7) << 2) | (((h >>> 2) & 3) << 6);
+          return rdFull ? ['lw', `${X[rdFull]},${offset}(sp)`] : null;
+        }
+        case 4:
+          if (((h >>> 12) & 1) === 0) {
+            if (rs2Full === 0) return rdFull === 1 ? ['ret', ''] : ['jr', X[rdFull]];
+            return ['mv', `${X[rdFull]},${X[rs2Full]}`];
+          }
+          if (rdFull === 0 && rs2Full === 0) return ['ebreak', ''];
+          if (rs2Full === 0) return ['jalr', X[rdFull]];
+          return ['add', `${X[rdFull]},${X[rdFull]},${X[rs2Full]}`];
+        case 5:
+        case 7: {
+          const offset = (((h >>> 10) & 7) << 3) | (((h >>> 7) & 7) << 6);
+          if (funct3 === 7 && xlen === 64) return ['sd', `${X[rs2Full]},${offset}(sp)`];
+          if (funct3 === 5) return ['fsd', `${F[rs2Full]},${offset}(sp)`];
+          const offsetW = (((h >>> 9) & 0xf) << 2) | (((h >>> 7) & 3) << 6);
+          return ['fsw', `${F[rs2Full]},${offsetW}(sp)`];
+        }
+        default: {
+          const offset = (((h >>> 9) & 0xf) << 2) | (((h >>> 7) & 3) << 6);
+          return ['sw', `${X[rs2Full]},${offset}(sp)`];
+        }
+      }
+  }
+}
+
+export function disassembleRiscv(code: Buffer, address: number, xlen: 32 | 64): DecodedInstruction[] {
+  const instructions: DecodedInstruction[] = [];
+  let offset = 0;
+  while (offset + 2 <= code.length) {
+    const pc = address + offset;
+    const half = code.readUInt16LE(offset);
+    if ((half & 3) !== 3) {
+      const decoded = decode16(half, pc, xlen);
+      instructions.push({
+        address: pc,
+        bytes: 2,
+        encoding: half.toString(16).padStart(4, '0'),
+        mnemonic: decoded ? decoded[0] : '.short',
+        operands: decoded ? decoded[1] : hex(half)
+      });
+      offset += 2;
+      continue;
+    }
+    if (offset + 4 > code.length) break;
+    const word = code.readInt32LE(offset);
+    const decoded = decode32(word, pc, xlen);
+    instructions.push({
+      address: pc,
+      bytes: 4,
+      encoding: (word >>> 0).toString(16).padStart(8, '0'),
+      mnemonic: decoded && decoded[0] ? decoded[0] : '.word',
+      operands: decoded && decoded[0] ? decoded[1] : hex(word)
+    });
+    offset += 4;
+  }
+  return instructions;
+}
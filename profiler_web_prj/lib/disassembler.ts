@@ -0,0 +1,42 @@
+import { AssemblyInstruction } from '@/types/profiler';
+import { ElfFile, readCode } from './elf';
+import { disassembleAarch64 } from './disasm-aarch64';
+import { disassembleRiscv } from './disasm-riscv';
+
+/**
+ * In-process disassembly for targets that would otherwise need a cross
+ * objdump. x86 objects are left to the host objdump, which always
+ * understands them.
+ */
+
+export interface DecodedInstruction {
+  address: number;
+  bytes: number;
+  encoding: string; // hex, as objdump prints it
+  mnemonic: string;
+  operands: string;
+}
+
+export function hasBuiltinDisassembler(elf: ElfFile): boolean {
+  return elf.machine === 'riscv' || elf.machine === 'aarch64';
+}
+
+/**
+ * Decode [start, end) of an ELF image into objdump-style instructions
+ * ("encoding\tmnemonic\toperands"), or null when the architecture has no
+ * built-in decoder or the range is outside every executable section.
+ */
+export function disassembleRange(buffer: Buffer, elf: ElfFile, start: number, end: number): AssemblyInstruction[] | null {
+  if (!hasBuiltinDisassembler(elf)) return null;
+  const range = readCode(buffer, elf, start, end);
+  if (!range) return null;
+
+  const decoded = elf.machine === 'riscv'
+    ? disassembleRiscv(range.code, range.address, elf.is64 ? 64 : 32)
+    : disassembleAarch64(range.code, range.address, elf.littleEndian);
+
+  return decoded.map(inst => ({
+    pc: '0x' + inst.address.toString(16),
+    instruction: `${inst.encoding.padEnd(20)}\t${inst.mnemonic}${inst.operands ? `\t${inst.operands}` : ''}`
+  }));
+}
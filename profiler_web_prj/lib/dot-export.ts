@@ -0,0 +1,87 @@
+import { CallGraph, CallGraphNode } from './call-graph';
+
+export type DotClusterBy = 'object' | 'file' | 'none';
+
+export interface DotExportOptions {
+  costEvent?: string; // defaults to Cy if present, else Ir
+  clusterBy?: DotClusterBy;
+  title?: string;
+}
+
+const quote = (value: string) => `"${value.replace(/\\/g, '\\\\').replace(/"/g, '\\"').replace(/\n/g, '\\n')}"`;
+
+const formatShare = (value: number, total: number) =>
+  total > 0 ? `${((value / total) * 100).toFixed(2)}%` : '0%';
+
+// Blue for cold through green and yellow to red for hot, as HSV for graphviz.
+// The square root spreads out the many functions with a small share.
+const heatColor = (fraction: number, saturation: number, value: number) => {
+  const hue = (2 / 3) * (1 - Math.sqrt(Math.min(1, Math.max(0, fraction))));
+  return `${hue.toFixed(3)} ${saturation} ${value}`;
+};
+
+const penWidth = (fraction: number) => (0.5 + 5.5 * Math.sqrt(Math.min(1, Math.max(0, fraction)))).toFixed(2);
+
+const clusterOf = (node: CallGraphNode, clusterBy: DotClusterBy): string => {
+  if (clusterBy === 'object') return node.objectFile || '???';
+  if (clusterBy === 'file') return node.file || '???';
+  return '';
+};
+
+/**
+ * Emit a call graph as graphviz DOT, one statement per chunk, so large
+ * graphs can be written to a stream without building the whole text.
+ * Node fill follows self cost and edge width follows the call's inclusive
+ * cost, both relative to the total cost of the profile.
+ */
+export function* generateDot(graph: CallGraph, events: string[], options: DotExportOptions = {}): Generator<string> {
+  const costEvent = options.costEvent
+    || (events.includes('Cy') ? 'Cy' : (events.includes('Ir') ? 'Ir' : events[0]));
+  const clusterBy = options.clusterBy || 'object';
+
+  let total = 0;
+  graph.nodes.forEach(node => { total += node.self[costEvent] || 0; });
+
+  yield `digraph ${quote(options.title || 'callgraph')} {\n`;
+  yield '  graph [fontname="Helvetica", nodesep=0.25, ranksep=0.5, rankdir=TB];\n';
+  yield '  node [fontname="Helvetica", shape=box, style="filled,rounded", fontsize=10];\n';
+  yield '  edge [fontname="Helvetica", fontsize=9, arrowsize=0.5];\n';
+
+  const ids = new Map<CallGraphNode, string>();
+  const clusters = new Map<string, CallGraphNode[]>();
+  graph.nodes.forEach(node => {
+    ids.set(node, `n${ids.size}`);
+    const cluster = clusterOf(node, clusterBy);
+    let members = clusters.get(cluster);
+    if (!members) {
+      members = [];
+      clusters.set(cluster, members);
+    }
+    members.push(node);
+  });
+
+  let clusterIndex = 0;
+  for (const [cluster, members] of clusters) {
+    const indent = cluster ? '    ' : '  ';
+    if (cluster) {
+      yield `  subgraph cluster_${clusterIndex++} {\n`;
+      yield `    label=${quote(cluster.split('/').pop() || cluster)}; tooltip=${quote(cluster)}; style=dashed; color=gray60;\n`;
+    }
+    for (const node of members) {
+      const self = node.self[costEvent] || 0;
+      const inclusive = node.inclusive[costEvent] || 0;
+      const label = `${node.functionName}\n${formatShare(inclusive, total)} (${formatShare(self, total)} self)`;
+      yield `${indent}${ids.get(node)} [label=${quote(label)}, tooltip=${quote(node.key)}, fillcolor=${quote(heatColor(total > 0 ? self / total : 0, 0.55, 0.95))}];\n`;
+    }
+    if (cluster) yield '  }\n';
+  }
+
+  for (const edge of graph.edges) {
+    const inclusive = edge.inclusive[costEvent] || 0;
+    const fraction = total > 0 ? inclusive / total : 0;
+    const label = `${formatShare(inclusive, total)}\n${edge.count.toLocaleString('en-US')}×`;
+    yield `  ${ids.get(edge.caller)} -> ${ids.get(edge.callee)} [label=${quote(label)}, penwidth=${penWidth(fraction)}, color=${quote(heatColor(fraction, 0.9, 0.7))}];\n`;
+  }
+
+  yield '}\n';
+}
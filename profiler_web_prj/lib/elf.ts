@@ -0,0 +1,152 @@
+/**
+ * Minimal ELF reader: the header fields needed to pick a disassembler, the
+ * section table to find the bytes behind an address range, and the sized
+ * function symbols, so objects can be read without a (cross) binutils.
+ */
+
+export type ElfMachine = 'x86' | 'x86-64' | 'arm' | 'aarch64' | 'riscv' | 'unknown';
+
+export interface ElfSection {
+  name: string;
+  address: number;
+  offset: number;
+  size: number;
+  executable: boolean;
+}
+
+export interface ElfSymbol {
+  name: string; // as stored, i.e. not demangled
+  address: number;
+  size: number;
+  binding: 'local' | 'global' | 'weak';
+  file?: string; // from the preceding STT_FILE symbol, for local symbols only
+}
+
+export interface ElfFile {
+  is64: boolean;
+  littleEndian: boolean;
+  machine: ElfMachine;
+  sections: ElfSection[];
+  functions: ElfSymbol[]; // defined, sized STT_FUNC symbols sorted by address
+}
+
+const MACHINES: Record<number, ElfMachine> = {
+  3: 'x86',
+  40: 'arm',
+  62: 'x86-64',
+  183: 'aarch64',
+  243: 'riscv'
+};
+
+const SHT_SYMTAB = 2;
+const SHT_NOBITS = 8;
+const SHT_DYNSYM = 11;
+const SHF_EXECINSTR = 0x4;
+const STT_FUNC = 2;
+const STT_FILE = 4;
+const BINDINGS: Record<number, ElfSymbol['binding']> = { 0: 'local', 1: 'global', 2: 'weak' };
+
+export function isElf(buffer: Buffer): boolean {
+  return buffer.length >= 52 && buffer.readUInt32BE(0) === 0x7f454c46;
+}
+
+export function parseElf(buffer: Buffer): ElfFile {
+  if (!isElf(buffer)) {
+    throw new Error('Invalid file format: not an ELF object file');
+  }
+  const is64 = buffer[4] === 2;
+  const littleEndian = buffer[5] === 1;
+  const u16 = (offset: number) => littleEndian ? buffer.readUInt16LE(offset) : buffer.readUInt16BE(offset);
+  const u32 = (offset: number) => littleEndian ? buffer.readUInt32LE(offset) : buffer.readUInt32BE(offset);
+  const word = (offset: number) => is64
+    ? Number(littleEndian ? buffer.readBigUInt64LE(offset) : buffer.readBigUInt64BE(offset))
+    : u32(offset);
+
+  const machine = MACHINES[u16(18)] || 'unknown';
+  const sectionTable = word(is64 ? 0x28 : 0x20);
+  const entrySize = u16(is64 ? 0x3a : 0x2e);
+  const count = u16(is64 ? 0x3c : 0x30);
+  const namesIndex = u16(is64 ? 0x3e : 0x32);
+
+  const raw = [];
+  for (let i = 0; i < count; i++) {
+    const base = sectionTable + i * entrySize;
+    if (base + entrySize > buffer.length) break;
+    raw.push({
+      nameOffset: u32(base),
+      type: u32(base + 4),
+      flags: word(base + 8),
+      address: word(base + (is64 ? 0x10 : 0x0c)),
+      offset: word(base + (is64 ? 0x18 : 0x10)),
+      size: word(base + (is64 ? 0x20 : 0x14)),
+      link: u32(base + (is64 ? 0x28 : 0x18))
+    });
+  }
+
+  const stringAt = (table: { offset: number; size: number } | undefined, offset: number) => {
+    if (!table || offset >= table.size) return '';
+    const start = table.offset + offset;
+    const end = buffer.indexOf(0, start);
+    return buffer.toString('latin1', start, end < 0 ? start : end);
+  };
+  const nameAt = (offset: number) => stringAt(raw[namesIndex], offset);
+
+  // .symtab, or .dynsym for stripped objects
+  const symbolTable = raw.find(section => section.type === SHT_SYMTAB) || raw.find(section => section.type === SHT_DYNSYM);
+  const functions: ElfSymbol[] = [];
+  if (symbolTable) {
+    const symbolSize = is64 ? 24 : 16;
+    const strings = raw[symbolTable.link];
+    const end = Math.min(symbolTable.offset + symbolTable.size, buffer.length);
+    let file: string | undefined;
+    for (let base = symbolTable.offset; base + symbolSize <= end; base += symbolSize) {
+      const info = buffer[base + (is64 ? 4 : 12)];
+      const sectionIndex = u16(base + (is64 ? 6 : 14));
+      const type = info & 0xf;
+      if (type === STT_FILE) {
+        file = stringAt(strings, u32(base)) || undefined;
+        continue;
+      }
+      const binding = BINDINGS[info >> 4];
+      if (type !== STT_FUNC || !binding || sectionIndex === 0) continue;
+      const size = is64 ? word(base + 16) : u32(base + 8);
+      if (size === 0) continue;
+      functions.push({
+        name: stringAt(strings, u32(base)),
+        address: is64 ? word(base + 8) : u32(base + 4),
+        size,
+        binding,
+        ...(binding === 'local' && file ? { file } : {})
+      });
+    }
+    functions.sort((a, b) => a.address - b.address);
+  }
+
+  return {
+    is64,
+    littleEndian,
+    machine,
+    sections: raw
+      .filter(section => section.type !== SHT_NOBITS)
+      .map(section => ({
+        name: nameAt(section.nameOffset),
+        address: section.address,
+        offset: section.offset,
+        size: section.size,
+        executable: (section.flags & SHF_EXECINSTR) !== 0
+      })),
+    functions
+  };
+}
+
+/**
+ * Bytes of [start, end) from the executable section containing `start`,
+ * clipped to the section, or null when no such section exists.
+ */
+export function readCode(buffer: Buffer, elf: ElfFile, start: number, end: number): { address: number; code: Buffer } | null {
+  const section = elf.sections.find(s => s.executable && start >= s.address && start < s.address + s.size);
+  if (!section) return null;
+  const stop = Math.min(end, section.address + section.size);
+  const offset = section.offset + (start - section.address);
+  return { address: start, code: buffer.subarray(offset, offset + (stop - start)) };
+}
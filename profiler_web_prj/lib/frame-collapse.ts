@@ -0,0 +1,205 @@
+import { CachegrindData, CallInfo, FileCoverage, FunctionData } from '@/types/profiler';
+import { functionKey } from './call-graph';
+
+export interface FrameCollapseRules {
+  enabled: boolean;
+  namePatterns: string[]; // glob patterns on function names, e.g. "*@plt"
+  objectPatterns: string[]; // glob patterns on object file paths or basenames
+  autoSelfRatio: number; // collapse forwarding frames with self/inclusive below this ratio (0 disables)
+}
+
+export const DEFAULT_COLLAPSE_RULES: FrameCollapseRules = {
+  enabled: true,
+  namePatterns: ['*@plt', '__x86.get_pc_thunk.*', '_dl_runtime_resolve*'],
+  objectPatterns: [],
+  autoSelfRatio: 0
+};
+
+const COLLAPSE_RULES_STORAGE_KEY = 'profiler-collapse-rules';
+
+export function loadCollapseRules(): FrameCollapseRules {
+  if (typeof window === 'undefined') return DEFAULT_COLLAPSE_RULES;
+  try {
+    const saved = localStorage.getItem(COLLAPSE_RULES_STORAGE_KEY);
+    if (saved) {
+      return { ...DEFAULT_COLLAPSE_RULES, ...JSON.parse(saved) };
+    }
+  } catch {
+    // Fall back to defaults on malformed settings
+  }
+  return DEFAULT_COLLAPSE_RULES;
+}
+
+export function saveCollapseRules(rules: FrameCollapseRules): void {
+  localStorage.setItem(COLLAPSE_RULES_STORAGE_KEY, JSON.stringify(rules));
+}
+
+export function globToRegExp(pattern: string): RegExp {
+  const escaped = pattern.replace(/[.+^${}()|[\]\\]/g, '\\$&').replace(/\*/g, '.*').replace(/\?/g, '.');
+  return new RegExp(`^${escaped}$`);
+}
+
+interface WorkingFunction {
+  file: string;
+  name: string;
+  objectFile?: string;
+  data: FunctionData;
+}
+
+/**
+ * Remove trampoline, thunk and PLT frames from the call graph by splicing
+ * their callers directly to their callees. A collapsed frame's self cost and
+ * outgoing calls are apportioned to each caller by that caller's share of the
+ * frame's incoming inclusive cost, so caller inclusive totals are preserved.
+ *
+ * Returns a new CachegrindData; the input is not modified. Source-level line
+ * data is left untouched, only function totals and call lists change.
+ */
+export function collapseFrames(data: CachegrindData, rules: FrameCollapseRules): CachegrindData {
+  if (!rules.enabled) return data;
+
+  const nameRegexps = rules.namePatterns.filter(p => p.trim()).map(p => globToRegExp(p.trim()));
+  const objectRegexps = rules.objectPatterns.filter(p => p.trim()).map(p => globToRegExp(p.trim()));
+  if (nameRegexps.length === 0 && objectRegexps.length === 0 && !(rules.autoSelfRatio > 0)) {
+    return data;
+  }
+
+  const costEvent = data.events.includes('Cy') ? 'Cy' : (data.events.includes('Ir') ? 'Ir' : data.events[0]);
+
+  // Working copy: functions are cloned so totals and call lists can be rewritten
+  const functions = new Map<string, WorkingFunction>();
+  Object.entries(data.fileCoverage).forEach(([filename, fileData]) => {
+    Object.entries(fileData.functions || {}).forEach(([funcName, funcData]) => {
+      functions.set(functionKey(filename, funcName), {
+        file: filename,
+        name: funcName,
+        objectFile: fileData.objectFile,
+        data: { ...funcData, totals: { ...funcData.totals }, calls: funcData.calls ? [...funcData.calls] : undefined }
+      });
+    });
+  });
+
+  // Reverse index: callee key -> caller keys
+  const callersOf = new Map<string, Set<string>>();
+  const targetKey = (caller: WorkingFunction, call: CallInfo) => functionKey(call.targetFile || caller.file, call.targetFunction || '');
+  functions.forEach((func, key) => {
+    func.data.calls?.forEach(call => {
+      if (!call.targetFunction) return;
+      const target = targetKey(func, call);
+      if (!callersOf.has(target)) callersOf.set(target, new Set());
+      callersOf.get(target)!.add(key);
+    });
+  });
+
+  const shouldCollapse = (key: string, func: WorkingFunction): boolean => {
+    // Never collapse roots; there would be nobody to absorb the cost
+    if (!callersOf.get(key)?.size) return false;
+    if (nameRegexps.some(re => re.test(func.name))) return true;
+    if (func.objectFile && objectRegexps.length > 0) {
+      const base = func.objectFile.split('/').pop() || func.objectFile;
+      if (objectRegexps.some(re => re.test(func.objectFile!) || re.test(base))) return true;
+    }
+    if (rules.autoSelfRatio > 0) {
+      const targets = new Set((func.data.calls || []).filter(c => c.targetFunction).map(c => targetKey(func, c)));
+      targets.delete(key);
+      if (targets.size === 1) {
+        const self = func.data.totals[costEvent] || 0;
+        const inclusive = self + (func.data.calls || []).reduce((sum, c) =>
+          targetKey(func, c) === key ? sum : sum + (c.inclusiveEvents?.[costEvent] || 0), 0);
+        if (inclusive > 0 && self / inclusive < rules.autoSelfRatio) return true;
+      }
+    }
+    return false;
+  };
+
+  const collapseKeys = Array.from(functions.entries())
+    .filter(([key, func]) => shouldCollapse(key, func))
+    .map(([key]) => key);
+
+  collapseKeys.forEach(key => {
+    const frame = functions.get(key);
+    const callerKeys = callersOf.get(key);
+    if (!frame || !callerKeys || callerKeys.size === 0) return;
+
+    const outgoing = (frame.data.calls || []).filter(c => c.targetFunction && targetKey(frame, c) !== key);
+
+    // Incoming calls with their weights
+    const incoming: Array<{ caller: WorkingFunction; call: CallInfo; weight: number }> = [];
+    callerKeys.forEach(callerKey => {
+      const caller = functions.get(callerKey);
+      if (!caller || callerKey === key) return;
+      caller.data.calls?.forEach(call => {
+        if (call.targetFunction && targetKey(caller, call) === key) {
+          incoming.push({ caller, call, weight: call.inclusiveEvents?.[costEvent] || call.count || 1 });
+        }
+      });
+    });
+    const totalWeight = incoming.reduce((sum, entry) => sum + entry.weight, 0);
+    if (incoming.length === 0 || totalWeight <= 0) return;
+
+    incoming.forEach(({ caller, call, weight }) => {
+      const share = weight / totalWeight;
+
+      // Fold the frame's self cost into the caller
+      Object.entries(frame.data.totals).forEach(([event, value]) => {
+        caller.data.totals[event] = (caller.data.totals[event] || 0) + value * share;
+      });
+
+      // Replace the call into the frame with calls to the frame's callees
+      const spliced: CallInfo[] = outgoing.map(out => ({
+        targetFile: out.targetFile || frame.file,
+        targetFunction: out.targetFunction,
+        targetObject: out.targetObject,
+        count: Math.max(1, Math.round(out.count * share)),
+        sourcePc: call.sourcePc,
+        sourceLine: call.sourceLine,
+        inclusiveEvents: out.inclusiveEvents
+          ? Object.fromEntries(Object.entries(out.inclusiveEvents).map(([event, value]) => [event, Math.round(value * share)]))
+          : undefined
+      }));
+      const calls = (caller.data.calls || []).filter(c => c !== call);
+      spliced.forEach(out => {
+        // Merge with an existing call from the same site to the same target
+        const existingIndex = calls.findIndex(c =>
+          c.sourcePc === out.sourcePc && targetKey(caller, c) === targetKey(caller, out));
+        if (existingIndex === -1) {
+          calls.push(out);
+          return;
+        }
+        const existing = calls[existingIndex];
+        const inclusiveEvents: Record<string, number> = { ...(existing.inclusiveEvents || {}) };
+        Object.entries(out.inclusiveEvents || {}).forEach(([event, value]) => {
+          inclusiveEvents[event] = (inclusiveEvents[event] || 0) + value;
+        });
+        calls[existingIndex] = { ...existing, count: existing.count + out.count, inclusiveEvents };
+      });
+      caller.data.calls = calls;
+
+      spliced.forEach(out => {
+        const target = targetKey(caller, out);
+        if (!callersOf.has(target)) callersOf.set(target, new Set());
+        callersOf.get(target)!.add(functionKey(caller.file, caller.name));
+      });
+    });
+
+    outgoing.forEach(out => callersOf.get(targetKey(frame, out))?.delete(key));
+    callersOf.delete(key);
+    functions.delete(key);
+  });
+
+  if (collapseKeys.length === 0) return data;
+
+  // Rebuild per-file function maps, keeping all non-function fields as they are
+  const fileCoverage: Record<string, FileCoverage> = {};
+  Object.entries(data.fileCoverage).forEach(([filename, fileData]) => {
+    fileCoverage[filename] = { ...fileData, functions: {} };
+  });
+  functions.forEach(func => {
+    func.data.totals = Object.fromEntries(
+      Object.entries(func.data.totals).map(([event, value]) => [event, Math.round(value)])
+    );
+    fileCoverage[func.file].functions[func.name] = func.data;
+  });
+
+  return { ...data, fileCoverage };
+}
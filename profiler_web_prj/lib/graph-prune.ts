@@ -0,0 +1,230 @@
+import { CachegrindData, CallInfo, FileCoverage, FunctionData } from '@/types/profiler';
+import { CallGraph, CallGraphEdge, CallGraphNode, buildCallGraph, functionKey } from './call-graph';
+
+export interface PruneThresholds {
+  nodeThreshold: number; // drop functions whose inclusive cost is below this fraction of the total (0 disables)
+  edgeThreshold: number; // drop calls whose inclusive cost is below this fraction of the total (0 disables)
+}
+
+export const DEFAULT_PRUNE_THRESHOLDS: PruneThresholds = {
+  nodeThreshold: 0,
+  edgeThreshold: 0
+};
+
+const PRUNE_THRESHOLDS_STORAGE_KEY = 'profiler-prune-thresholds';
+
+export function loadPruneThresholds(): PruneThresholds {
+  if (typeof window === 'undefined') return DEFAULT_PRUNE_THRESHOLDS;
+  try {
+    const saved = localStorage.getItem(PRUNE_THRESHOLDS_STORAGE_KEY);
+    if (saved) {
+      return { ...DEFAULT_PRUNE_THRESHOLDS, ...JSON.parse(saved) };
+    }
+  } catch {
+    // Fall back to defaults on malformed settings
+  }
+  return DEFAULT_PRUNE_THRESHOLDS;
+}
+
+export function savePruneThresholds(thresholds: PruneThresholds): void {
+  localStorage.setItem(PRUNE_THRESHOLDS_STORAGE_KEY, JSON.stringify(thresholds));
+}
+
+export const OTHER_BUCKET_PREFIX = '[other]';
+
+export function isOtherBucket(functionName: string): boolean {
+  return functionName.startsWith(OTHER_BUCKET_PREFIX);
+}
+
+/**
+ * Prunes a call graph by cost, in the style of gprof2dot's node and edge
+ * thresholds. Calls from a kept function into pruned functions are folded
+ * into one "[other]" bucket per caller, whose self cost is the folded calls'
+ * inclusive cost, so every kept function keeps its inclusive total and the
+ * graph's total cost is unchanged. A function whose every call is below the
+ * edge threshold is pruned the same way, with the functions only it calls.
+ * Cheap calls into a function that is still called elsewhere are kept:
+ * folding them would count that function's cost twice, once in the bucket
+ * and once under its remaining callers.
+ *
+ * The graph, inclusive costs and the cost ordering are computed once. When
+ * only the node threshold changes, just the callers of functions that cross
+ * the threshold are rebuilt, and untouched files keep their objects.
+ */
+export class GraphPruner {
+  private graph: CallGraph;
+  private costEvent: string;
+  private total: number;
+  private byInclusive: CallGraphNode[]; // ascending inclusive cost
+  private pruned = new Set<string>();
+  private current: PruneThresholds = DEFAULT_PRUNE_THRESHOLDS;
+  private functions = new Map<string, { file: string; name: string; data: FunctionData }>();
+  private fileCoverage: Record<string, FileCoverage>;
+  private result: CachegrindData;
+
+  constructor(private data: CachegrindData) {
+    this.graph = buildCallGraph(data);
+    this.costEvent = data.events.includes('Cy') ? 'Cy' : (data.events.includes('Ir') ? 'Ir' : data.events[0]);
+    this.total = 0;
+    this.graph.nodes.forEach(node => { this.total += node.self[this.costEvent] || 0; });
+    this.byInclusive = Array.from(this.graph.nodes.values())
+      .filter(node => node.data)
+      .sort((a, b) => (a.inclusive[this.costEvent] || 0) - (b.inclusive[this.costEvent] || 0));
+    this.fileCoverage = data.fileCoverage;
+    this.result = data;
+  }
+
+  prune(thresholds: PruneThresholds): CachegrindData {
+    const nodeThreshold = Math.max(0, thresholds.nodeThreshold || 0);
+    const edgeThreshold = Math.max(0, thresholds.edgeThreshold || 0);
+    if (nodeThreshold === this.current.nodeThreshold && edgeThreshold === this.current.edgeThreshold) {
+      return this.result;
+    }
+
+    const edgeChanged = edgeThreshold !== this.current.edgeThreshold;
+    this.current = { nodeThreshold, edgeThreshold };
+    if (nodeThreshold === 0 && edgeThreshold === 0) {
+      this.pruned.clear();
+      this.functions.clear();
+      this.fileCoverage = this.data.fileCoverage;
+      this.result = this.data;
+      return this.result;
+    }
+
+    // Functions reached only through calls below the edge threshold, and
+    // then the functions only they call. The rule below keeps any of them
+    // that still calls a kept function; its cheap calls then stay as they are
+    const minEdgeCost = edgeThreshold * this.total;
+    const orphaned = new Set<string>();
+    const keptCall = (edge: CallGraphEdge) => edge.caller !== edge.callee
+      && !orphaned.has(edge.caller.key)
+      && (edge.inclusive[this.costEvent] || 0) >= minEdgeCost;
+    const orphans = minEdgeCost > 0 ? Array.from(this.graph.nodes.values()).filter(node => node.data) : [];
+    while (orphans.length > 0) {
+      const node = orphans.pop()!;
+      if (orphaned.has(node.key) || node.callers.length === 0 || node.callers.some(keptCall)) continue;
+      orphaned.add(node.key);
+      node.callees.forEach(edge => {
+        if (edge.callee.data && !orphaned.has(edge.callee.key)) orphans.push(edge.callee);
+      });
+    }
+
+    // Candidates are the cheap prefix of the sorted order. Roots stay so the graph keeps its entry points
+    const minCost = nodeThreshold * this.total;
+    const nextPruned = new Set<string>(orphaned);
+    for (const node of this.byInclusive) {
+      if ((node.inclusive[this.costEvent] || 0) >= minCost) break;
+      if (node.callers.length > 0) nextPruned.add(node.key);
+    }
+
+    // A function that still calls a kept function is kept too, so pruned functions only
+    // ever form whole subtrees and the buckets above them hold exactly their cost
+    const worklist = Array.from(nextPruned);
+    while (worklist.length > 0) {
+      const key = worklist.pop()!;
+      if (!nextPruned.has(key)) continue;
+      const node = this.graph.nodes.get(key)!;
+      const callsKept = node.callees.some(edge =>
+        edge.callee !== node && edge.callee.data && !nextPruned.has(edge.callee.key));
+      if (!callsKept) continue;
+      nextPruned.delete(key);
+      node.callers.forEach(edge => {
+        if (nextPruned.has(edge.caller.key)) worklist.push(edge.caller.key);
+      });
+    }
+
+    const dirty = new Set<string>();
+    if (edgeChanged || this.functions.size === 0) {
+      this.graph.nodes.forEach(node => { if (node.data) dirty.add(node.key); });
+    } else {
+      const flipped = new Set<string>();
+      nextPruned.forEach(key => { if (!this.pruned.has(key)) flipped.add(key); });
+      this.pruned.forEach(key => { if (!nextPruned.has(key)) flipped.add(key); });
+      flipped.forEach(key => {
+        dirty.add(key);
+        this.graph.nodes.get(key)!.callers.forEach(edge => dirty.add(edge.caller.key));
+      });
+    }
+    this.pruned = nextPruned;
+
+    const dirtyFiles = new Set<string>();
+    dirty.forEach(key => {
+      const node = this.graph.nodes.get(key)!;
+      dirtyFiles.add(node.file);
+      const bucketKey = functionKey(node.file, `${OTHER_BUCKET_PREFIX} ${node.functionName}`);
+      this.functions.delete(bucketKey);
+      if (!node.data || this.pruned.has(key)) {
+        this.functions.delete(key);
+        return;
+      }
+
+      // Rebuild this function's calls against the current pruned set
+      const prunedCalls = new Set<CallInfo>();
+      const bucket: Record<string, number> = {};
+      let bucketCalls = 0;
+      node.callees.forEach(edge => {
+        if (!this.pruned.has(edge.callee.key)) return;
+        Object.entries(edge.inclusive).forEach(([event, value]) => {
+          bucket[event] = (bucket[event] || 0) + value;
+        });
+        bucketCalls += edge.count;
+        prunedCalls.add(edge.call);
+      });
+      const bucketFunctions = prunedCalls.size;
+      const calls = (node.data.calls || []).filter(call => !prunedCalls.has(call));
+
+      const data: FunctionData = bucketFunctions > 0 ? { ...node.data, calls } : node.data;
+      this.functions.set(key, { file: node.file, name: node.functionName, data });
+      if (bucketFunctions > 0) {
+        const bucketName = `${OTHER_BUCKET_PREFIX} ${node.functionName}`;
+        calls.push({
+          targetFile: node.file,
+          targetFunction: bucketName,
+          count: bucketCalls,
+          sourcePc: '',
+          inclusiveEvents: bucket
+        });
+        this.functions.set(bucketKey, {
+          file: node.file,
+          name: bucketName,
+          data: {
+            lines: {},
+            totals: bucket,
+            coveredLines: [],
+            uncoveredLines: [],
+            coveragePercentage: 0,
+            prunedCalls: bucketFunctions
+          }
+        });
+      }
+    });
+
+    // Files with no dirty functions keep their previous FileCoverage object
+    const fileCoverage: Record<string, FileCoverage> = { ...this.fileCoverage };
+    dirtyFiles.forEach(file => {
+      const original = this.data.fileCoverage[file];
+      if (!original) return;
+      fileCoverage[file] = { ...original, functions: {} };
+    });
+    dirtyFiles.forEach(file => {
+      const original = this.data.fileCoverage[file];
+      if (!original) return;
+      Object.keys(original.functions).forEach(name => {
+        const key = functionKey(file, name);
+        if (this.pruned.has(key)) return;
+        const entry = this.functions.get(key);
+        fileCoverage[file].functions[name] = entry ? entry.data : original.functions[name];
+        const bucket = this.functions.get(functionKey(file, `${OTHER_BUCKET_PREFIX} ${name}`));
+        if (bucket) fileCoverage[file].functions[bucket.name] = bucket.data;
+      });
+    });
+
+    this.fileCoverage = fileCoverage;
+    this.result = { ...this.data, fileCoverage };
+    return this.result;
+  }
+
+  get prunedCount(): number {
+    return this.pruned.size;
+  }
+}
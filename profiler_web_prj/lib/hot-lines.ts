@@ -0,0 +1,162 @@
+import { CachegrindData } from '@/types/profiler';
+
+/**
+ * Project-wide ranking of the hottest source lines. Line costs are summed
+ * per (file, line) over every function that has cost there (inlined code
+ * shows up in several functions), then the top K are picked with a bounded
+ * min-heap instead of sorting every line of the program.
+ */
+
+export interface HotLineMetric {
+  id: string;
+  label: string;
+  events: string[]; // events the metric needs
+  value: (line: Record<string, number>) => number;
+}
+
+export interface HotLineEntry {
+  file: string;
+  line: number;
+  value: number;
+  functions: string[]; // functions with cost on this line, heaviest first
+  events: Record<string, number>;
+}
+
+export interface HotLineGroup {
+  file: string;
+  functionName: string;
+  value: number;
+  lines: HotLineEntry[];
+}
+
+const sum = (...events: string[]) => (line: Record<string, number>) =>
+  events.reduce((total, event) => total + (line[event] || 0), 0);
+
+// Sums of raw events that are more useful to rank by than any single one of them
+const DERIVED_METRICS: HotLineMetric[] = [
+  { id: 'D1miss', label: 'L1 data misses (D1mr + D1mw)', events: ['D1mr', 'D1mw'], value: sum('D1mr', 'D1mw') },
+  { id: 'LLmiss', label: 'Last-level misses (ILmr + DLmr + DLmw)', events: ['ILmr', 'DLmr', 'DLmw'], value: sum('ILmr', 'DLmr', 'DLmw') },
+  { id: 'Bmiss', label: 'Branch mispredicts (Bcm + Bim)', events: ['Bcm', 'Bim'], value: sum('Bcm', 'Bim') },
+  { id: 'Dr+Dw', label: 'Memory accesses (Dr + Dw)', events: ['Dr', 'Dw'], value: sum('Dr', 'Dw') }
+];
+
+/**
+ * Metrics available for a profile: every recorded event, plus derived
+ * metrics whose events were all recorded.
+ */
+export function availableHotLineMetrics(events: string[]): HotLineMetric[] {
+  const raw = events.map(event => ({
+    id: event,
+    label: event,
+    events: [event],
+    value: (line: Record<string, number>) => line[event] || 0
+  }));
+  const derived = DERIVED_METRICS.filter(metric => metric.events.every(event => events.includes(event)));
+  return [...raw, ...derived];
+}
+
+// Bounded min-heap: the root is the smallest of the K largest values seen so far
+class TopK<T> {
+  private heap: T[] = [];
+
+  constructor(private k: number, private score: (item: T) => number) {}
+
+  push(item: T) {
+    if (this.heap.length < this.k) {
+      this.heap.push(item);
+      this.siftUp(this.heap.length - 1);
+    } else if (this.k > 0 && this.score(item) > this.score(this.heap[0])) {
+      this.heap[0] = item;
+      this.siftDown(0);
+    }
+  }
+
+  sorted(): T[] {
+    return this.heap.slice().sort((a, b) => this.score(b) - this.score(a));
+  }
+
+  private siftUp(i: number) {
+    while (i > 0) {
+      const parent = (i - 1) >> 1;
+      if (this.score(this.heap[i]) >= this.score(this.heap[parent])) break;
+      [this.heap[i], this.heap[parent]] = [this.heap[parent], this.heap[i]];
+      i = parent;
+    }
+  }
+
+  private siftDown(i: number) {
+    const n = this.heap.length;
+    for (;;) {
+      const left = 2 * i + 1;
+      const right = left + 1;
+      let smallest = i;
+      if (left < n && this.score(this.heap[left]) < this.score(this.heap[smallest])) smallest = left;
+      if (right < n && this.score(this.heap[right]) < this.score(this.heap[smallest])) smallest = right;
+      if (smallest === i) break;
+      [this.heap[i], this.heap[smallest]] = [this.heap[smallest], this.heap[i]];
+      i = smallest;
+    }
+  }
+}
+
+export function findHotLines(data: CachegrindData, metric: HotLineMetric, k: number): HotLineEntry[] {
+  const topK = new TopK<HotLineEntry>(k, entry => entry.value);
+
+  Object.entries(data.fileCoverage).forEach(([file, fileData]) => {
+    const lines = new Map<number, { events: Record<string, number>; byFunction: Map<string, number> }>();
+    Object.entries(fileData.functions || {}).forEach(([functionName, functionData]) => {
+      Object.entries(functionData.lines || {}).forEach(([lineKey, lineData]) => {
+        const line = Number(lineKey);
+        if (!(line > 0)) return;
+        let entry = lines.get(line);
+        if (!entry) {
+          entry = { events: {}, byFunction: new Map() };
+          lines.set(line, entry);
+        }
+        const lineEvents: Record<string, number> = {};
+        Object.entries(lineData).forEach(([event, value]) => {
+          if (typeof value !== 'number') return;
+          lineEvents[event] = value;
+          entry!.events[event] = (entry!.events[event] || 0) + value;
+        });
+        entry.byFunction.set(functionName, (entry.byFunction.get(functionName) || 0) + metric.value(lineEvents));
+      });
+    });
+
+    lines.forEach(({ events, byFunction }, line) => {
+      const value = metric.value(events);
+      if (value <= 0) return;
+      topK.push({
+        file,
+        line,
+        value,
+        events,
+        functions: Array.from(byFunction.entries())
+          .sort((a, b) => b[1] - a[1])
+          .map(([name]) => name)
+      });
+    });
+  });
+
+  return topK.sorted();
+}
+
+/**
+ * Group ranked lines under the function that owns most of their cost,
+ * ordered by the summed value of the function's ranked lines.
+ */
+export function groupHotLinesByFunction(entries: HotLineEntry[]): HotLineGroup[] {
+  const groups = new Map<string, HotLineGroup>();
+  entries.forEach(entry => {
+    const functionName = entry.functions[0] || '???';
+    const key = `${entry.file}:${functionName}`;
+    let group = groups.get(key);
+    if (!group) {
+      group = { file: entry.file, functionName, value: 0, lines: [] };
+      groups.set(key, group);
+    }
+    group.value += entry.value;
+    group.lines.push(entry);
+  });
+  return Array.from(groups.values()).sort((a, b) => b.value - a.value);
+}
@@ -0,0 +1,150 @@
+import { AssemblyInstruction } from '@/types/profiler';
+import { CallGraph, CallGraphNode, findApplicationObjects, isApplicationNode } from './call-graph';
+
+/**
+ * Ranking of call edges by the instructions spent on the call itself: the
+ * call and return, plus the callee's prologue and epilogue. These are what
+ * inlining the callee into the caller would save. Prologue and epilogue
+ * sizes come from the callee's disassembly when it has been loaded;
+ * otherwise only the call and return are counted.
+ */
+
+export interface FrameOverhead {
+  prologue: number; // instructions executed on entry before the body
+  epilogue: number; // instructions executed before returning
+}
+
+export interface InlineCandidate {
+  caller: CallGraphNode;
+  callee: CallGraphNode;
+  calls: number;
+  bodyPerCall: number; // callee self cost per call, frame included
+  inclusivePerCall: number;
+  overheadPerCall: number;
+  savings: number; // calls * overheadPerCall
+  frame?: FrameOverhead; // undefined when the callee was not disassembled
+  suggestion: 'always_inline' | 'inline';
+}
+
+export interface InlineCandidateOptions {
+  maxBodyPerCall?: number; // callees doing more than this per call are not worth inlining
+  minCalls?: number;
+}
+
+const CALL_AND_RETURN = 2;
+
+// x86-64, AArch64 and RISC-V forms of frame setup and teardown, matched on
+// the mnemonic and its operands with whitespace removed
+const PROLOGUE_PATTERNS: [RegExp, RegExp][] = [
+  [/^endbr(32|64)$/, /.*/],
+  [/^push[lq]?$/, /.*/],
+  [/^mov[lq]?$/, /^%[re]sp,%[re]bp$/],
+  [/^sub[lq]?$/, /^\$[^,]+,%[re]sp$/],
+  [/^paciasp$/, /.*/],
+  [/^stp$/, /\[sp/],
+  [/^mov$/, /^x29,sp$/],
+  [/^sub$/, /^sp,sp,/],
+  [/^(c\.)?addi(16sp)?$/, /^sp,sp,-/],
+  [/^(c\.)?(sd|sw)(sp)?$/, /^(ra|fp|s\d+),\d+\(sp\)$/],
+  [/^(c\.)?addi(4spn)?$/, /^(s0|fp),sp,/]
+];
+
+const EPILOGUE_PATTERNS: [RegExp, RegExp][] = [
+  [/^pop[lq]?$/, /.*/],
+  [/^leave[lq]?$/, /.*/],
+  [/^add[lq]?$/, /^\$[^,]+,%[re]sp$/],
+  [/^mov[lq]?$/, /^%[re]bp,%[re]sp$/],
+  [/^ldp$/, /\[sp\]/],
+  [/^add$/, /^sp,sp,/],
+  [/^autiasp$/, /.*/],
+  [/^(c\.)?(ld|lw)(sp)?$/, /^(ra|fp|s\d+),\d+\(sp\)$/],
+  [/^(c\.)?addi(16sp)?$/, /^sp,sp,\d/]
+];
+
+const isReturn = (mnemonic: string, operands: string) =>
+  /^(ret[lqw]?|c\.jr|jr)$/.test(mnemonic) && (mnemonic.startsWith('ret') || operands === 'ra');
+
+// objdump lines hold the encoding, a tab, then the mnemonic and operands
+const splitInstruction = (instruction: string): { mnemonic: string; operands: string } => {
+  const parts = instruction.split('\t');
+  const text = (parts.length > 1 ? parts.slice(1).join(' ') : parts[0]).trim();
+  const [mnemonic = '', ...rest] = text.split(/\s+/);
+  return { mnemonic: mnemonic.toLowerCase(), operands: rest.join('').replace(/#.*$|<.*$/, '') };
+};
+
+const matches = (patterns: [RegExp, RegExp][], mnemonic: string, operands: string) =>
+  patterns.some(([m, o]) => m.test(mnemonic) && o.test(operands));
+
+/**
+ * Count prologue instructions from the function's first address and the
+ * epilogue instructions before its first return. Instructions outside
+ * [startPc, endPc] are ignored, since disassembly is fetched with padding.
+ */
+export function analyzeFrame(instructions: AssemblyInstruction[], startPc: number, endPc: number): FrameOverhead {
+  const body = instructions
+    .filter(inst => {
+      const pc = parseInt(inst.pc, 16);
+      return pc >= startPc && pc <= endPc;
+    })
+    .map(inst => splitInstruction(inst.instruction));
+
+  let prologue = 0;
+  while (prologue < body.length && matches(PROLOGUE_PATTERNS, body[prologue].mnemonic, body[prologue].operands)) {
+    prologue++;
+  }
+
+  let epilogue = 0;
+  const ret = body.findIndex(inst => isReturn(inst.mnemonic, inst.operands));
+  if (ret > 0) {
+    for (let i = ret - 1; i >= prologue && matches(EPILOGUE_PATTERNS, body[i].mnemonic, body[i].operands); i--) {
+      epilogue++;
+    }
+  }
+  return { prologue, epilogue };
+}
+
+/**
+ * Rank call edges into small application functions by `calls * overhead`.
+ * `frames` holds the analyzed frame of callees that have been disassembled,
+ * keyed by node key.
+ */
+export function rankInlineCandidates(
+  graph: CallGraph,
+  event: string,
+  frames: Map<string, FrameOverhead>,
+  options: InlineCandidateOptions = {}
+): InlineCandidate[] {
+  const maxBodyPerCall = options.maxBodyPerCall ?? 64;
+  const minCalls = options.minCalls ?? 2;
+  const applicationObjects = findApplicationObjects(graph);
+  const candidates: InlineCandidate[] = [];
+
+  graph.nodes.forEach(callee => {
+    if (!callee.data || !isApplicationNode(callee, applicationObjects)) return;
+    const totalCalls = callee.callers.reduce((sum, edge) => sum + edge.count, 0);
+    if (totalCalls === 0) return;
+    const bodyPerCall = (callee.self[event] || 0) / totalCalls;
+    if (bodyPerCall > maxBodyPerCall) return;
+
+    const frame = frames.get(callee.key);
+    const overheadPerCall = CALL_AND_RETURN + (frame ? frame.prologue + frame.epilogue : 0);
+    const inclusivePerCall = (callee.inclusive[event] || 0) / totalCalls;
+
+    callee.callers.forEach(edge => {
+      if (edge.caller === callee || edge.count < minCalls) return;
+      candidates.push({
+        caller: edge.caller,
+        callee,
+        calls: edge.count,
+        bodyPerCall,
+        inclusivePerCall,
+        overheadPerCall,
+        savings: edge.count * overheadPerCall,
+        frame,
+        suggestion: bodyPerCall <= 2 * overheadPerCall ? 'always_inline' : 'inline'
+      });
+    });
+  });
+
+  return candidates.sort((a, b) => b.savings - a.savings || b.calls - a.calls);
+}
@@ -0,0 +1,138 @@
+/**
+ * Line mapping between two versions of a source file, from a Myers diff.
+ * Used to carry line costs of one profile over to the source lines of
+ * another profile built from a different commit.
+ */
+
+// Past this many edits the files are treated as unrelated instead of diffed
+const MAX_EDIT_DISTANCE = 2000;
+const CACHE_LIMIT = 500;
+
+export const fnv1a = (text: string): number => {
+  let hash = 0x811c9dc5;
+  for (let i = 0; i < text.length; i++) {
+    hash ^= text.charCodeAt(i);
+    hash = Math.imul(hash, 0x01000193);
+  }
+  return hash >>> 0;
+};
+
+// Lines compare by content with surrounding whitespace ignored, so reindented code still matches
+const lineIds = (lines: string[], ids: Map<string, number>): Int32Array => {
+  const result = new Int32Array(lines.length);
+  lines.forEach((line, i) => {
+    const key = line.trim();
+    let id = ids.get(key);
+    if (id === undefined) {
+      id = ids.size;
+      ids.set(key, id);
+    }
+    result[i] = id;
+  });
+  return result;
+};
+
+/**
+ * Map each line of `a` to its line in `b` (0-based), or -1 when the line
+ * was removed or changed. Null when the files are too different to align.
+ */
+export function alignLines(a: string[], b: string[]): Int32Array | null {
+  const ids = new Map<string, number>();
+  return alignSequences(lineIds(a, ids), lineIds(b, ids));
+}
+
+/**
+ * Map each element of `x` to the index of its match in `y`, or -1. Equal
+ * ids match. Common prefix and suffix are matched directly, and the middle
+ * is diffed with Myers' O(ND) algorithm. Returns null when the middle needs
+ * more than MAX_EDIT_DISTANCE edits; callers then compare positions as-is.
+ */
+export function alignSequences(x: Int32Array, y: Int32Array): Int32Array | null {
+  const mapping = new Int32Array(x.length).fill(-1);
+
+  let start = 0;
+  while (start < x.length && start < y.length && x[start] === y[start]) {
+    mapping[start] = start;
+    start++;
+  }
+  let endA = x.length;
+  let endB = y.length;
+  while (endA > start && endB > start && x[endA - 1] === y[endB - 1]) {
+    endA--;
+    endB--;
+    mapping[endA] = endB;
+  }
+
+  const n = endA - start;
+  const m = endB - start;
+  if (n === 0 || m === 0) return mapping;
+
+  // Forward pass, keeping a copy of the frontier for each edit distance to backtrack through
+  const max = Math.min(n + m, MAX_EDIT_DISTANCE);
+  const offset = max + 1;
+  const v = new Int32Array(2 * max + 3);
+  const trace: Int32Array[] = [];
+  let found = -1;
+  for (let d = 0; d <= max && found < 0; d++) {
+    for (let k = -d; k <= d; k += 2) {
+      let i = (k === -d || (k !== d && v[offset + k - 1] < v[offset + k + 1]))
+        ? v[offset + k + 1]
+        : v[offset + k - 1] + 1;
+      let j = i - k;
+      while (i < n && j < m && x[start + i] === y[start + j]) {
+        i++;
+        j++;
+      }
+      v[offset + k] = i;
+      if (i >= n && j >= m) {
+        found = d;
+        break;
+      }
+    }
+    trace.push(v.slice(offset - d - 1, offset + d + 2));
+  }
+  if (found < 0) return null;
+
+  // Walk back from the end, recording the diagonal (matching) runs
+  let i = n;
+  let j = m;
+  for (let d = found; d > 0; d--) {
+    const prev = trace[d - 1]; // covers k in [-(d-1)-1, (d-1)+1]
+    const at = (k: number) => prev[k + d];
+    const k = i - j;
+    const down = k === -d || (k !== d && at(k - 1) < at(k + 1));
+    const prevK = down ? k + 1 : k - 1;
+    const prevI = at(prevK);
+    const prevJ = prevI - prevK;
+    while (i > prevI + (down ? 0 : 1) && j > prevJ + (down ? 1 : 0)) {
+      i--;
+      j--;
+      mapping[start + i] = start + j;
+    }
+    i = prevI;
+    j = prevJ;
+  }
+  while (i > 0 && j > 0) {
+    i--;
+    j--;
+    mapping[start + i] = start + j;
+  }
+  return mapping;
+}
+
+const cache = new Map<string, Int32Array | null>();
+
+/**
+ * alignLines() over whole file contents, cached by the pair of contents so
+ * repeated comparisons of the same two versions reuse the mapping.
+ */
+export function alignSources(baseSource: string, headSource: string): Int32Array | null {
+  const key = `${fnv1a(baseSource)}:${baseSource.length}:${fnv1a(headSource)}:${headSource.length}`;
+  let mapping = cache.get(key);
+  if (mapping === undefined) {
+    mapping = alignLines(baseSource.split('\n'), headSource.split('\n'));
+    if (cache.size >= CACHE_LIMIT) cache.delete(cache.keys().next().value as string);
+    cache.set(key, mapping);
+  }
+  return mapping;
+}
@@ -0,0 +1,156 @@
+import { FunctionSymbol } from '@/types/profiler';
+import { scanProfile } from './profile-scanner';
+
+/**
+ * Functions that no run of a corpus ever executed, sized from the object
+ * files' symbol tables. Execution is taken from instruction addresses when
+ * dumps have them (--dump-instr=yes) and from function names otherwise, so
+ * a symbol counts as executed if either matches.
+ */
+
+export interface ExecutedCode {
+  addresses: Map<string, Set<number>>; // object file -> executed instruction addresses
+  functions: Map<string, Set<string>>; // object file -> functions with any executed cost
+}
+
+export interface NeverExecutedFunction {
+  objectFile: string;
+  name: string;
+  address: string;
+  size: number;
+  file?: string;
+  line?: number;
+}
+
+export interface NeverExecutedGroup {
+  key: string; // object, source file or directory
+  neverBytes: number;
+  neverFunctions: number;
+  totalBytes: number;
+  totalFunctions: number;
+}
+
+export interface NeverExecutedReport {
+  functions: NeverExecutedFunction[]; // largest first
+  files: NeverExecutedGroup[]; // by never-executed bytes
+  directories: NeverExecutedGroup[];
+  objects: NeverExecutedGroup[];
+}
+
+const getSet = <T>(map: Map<string, Set<T>>, key: string): Set<T> => {
+  let set = map.get(key);
+  if (!set) {
+    set = new Set();
+    map.set(key, set);
+  }
+  return set;
+};
+
+export function scanExecutedCode(content: string): ExecutedCode {
+  const executed: ExecutedCode = { addresses: new Map(), functions: new Map() };
+  let addresses = getSet(executed.addresses, '');
+  let functions = getSet(executed.functions, '');
+  let lastFunction = '';
+
+  scanProfile(content, {
+    onObject: (objectFile) => {
+      addresses = getSet(executed.addresses, objectFile);
+      functions = getSet(executed.functions, objectFile);
+      lastFunction = '';
+    },
+    onInstr: (address, wasExecuted) => {
+      if (wasExecuted) addresses.add(address);
+    },
+    onCost: (_file, functionName, _line, costs) => {
+      if (functionName === lastFunction) return;
+      for (let i = 0; i < costs.length; i++) {
+        if (costs[i] > 0) {
+          functions.add(functionName);
+          lastFunction = functionName;
+          return;
+        }
+      }
+    }
+  });
+  executed.addresses.delete('');
+  executed.functions.delete('');
+  return executed;
+}
+
+export function mergeExecutedCode(into: ExecutedCode, run: ExecutedCode) {
+  run.addresses.forEach((addresses, objectFile) => {
+    const target = getSet(into.addresses, objectFile);
+    addresses.forEach(address => target.add(address));
+  });
+  run.functions.forEach((names, objectFile) => {
+    const target = getSet(into.functions, objectFile);
+    names.forEach(name => target.add(name));
+  });
+}
+
+const directoryOf = (file: string) => {
+  const slash = file.lastIndexOf('/');
+  return slash > 0 ? file.substring(0, slash) : '.';
+};
+
+/**
+ * Match every sized function symbol against the executed code and group
+ * the never-executed ones by object, source file and directory.
+ */
+export function findNeverExecuted(symbolsByObject: Map<string, FunctionSymbol[]>, executed: ExecutedCode): NeverExecutedReport {
+  const functions: NeverExecutedFunction[] = [];
+  const groups = {
+    files: new Map<string, NeverExecutedGroup>(),
+    directories: new Map<string, NeverExecutedGroup>(),
+    objects: new Map<string, NeverExecutedGroup>()
+  };
+  const addTo = (map: Map<string, NeverExecutedGroup>, key: string, size: number, never: boolean) => {
+    let group = map.get(key);
+    if (!group) {
+      group = { key, neverBytes: 0, neverFunctions: 0, totalBytes: 0, totalFunctions: 0 };
+      map.set(key, group);
+    }
+    group.totalBytes += size;
+    group.totalFunctions++;
+    if (never) {
+      group.neverBytes += size;
+      group.neverFunctions++;
+    }
+  };
+
+  symbolsByObject.forEach((symbols, objectFile) => {
+    const addresses = Float64Array.from(executed.addresses.get(objectFile) || []).sort();
+    const names = executed.functions.get(objectFile) || new Set<string>();
+
+    symbols.forEach(symbol => {
+      const start = parseInt(symbol.address, 16);
+      // First executed address at or after the symbol start
+      let lo = 0;
+      let hi = addresses.length;
+      while (lo < hi) {
+        const mid = (lo + hi) >>> 1;
+        if (addresses[mid] < start) lo = mid + 1;
+        else hi = mid;
+      }
+      const wasExecuted = (lo < addresses.length && addresses[lo] < start + symbol.size) || names.has(symbol.name);
+      const file = symbol.file || `${objectFile} (no debug info)`;
+
+      addTo(groups.objects, objectFile, symbol.size, !wasExecuted);
+      addTo(groups.files, file, symbol.size, !wasExecuted);
+      addTo(groups.directories, symbol.file ? directoryOf(symbol.file) : file, symbol.size, !wasExecuted);
+      if (!wasExecuted) {
+        functions.push({ objectFile, name: symbol.name, address: symbol.address, size: symbol.size, file: symbol.file, line: symbol.line });
+      }
+    });
+  });
+
+  const sorted = (map: Map<string, NeverExecutedGroup>) => Array.from(map.values())
+    .filter(group => group.neverFunctions > 0)
+    .sort((a, b) => b.neverBytes - a.neverBytes);
+  return {
+    functions: functions.sort((a, b) => b.size - a.size),
+    files: sorted(groups.files),
+    directories: sorted(groups.directories),
+    objects: sorted(groups.objects)
+  };
+}
@@ -0,0 +1,65 @@
+import fs from 'fs/promises';
+import path from 'path';
+
+// Server-side helpers for profile dumps stored under the project's output/ directory
+
+// callgrind.out.<pid>[.<part>], or a tagged name like cachegrind.out.with_libs
+const PROFILE_FILE_PATTERN = /^(callgrind|cachegrind)\.out(\.[\w-]+)*$/;
+// Files derived from a dump (graph exports, reports) start with its name
+const DERIVED_FILE_PATTERN = /\.(dot|svg|html|json)$/;
+
+/**
+ * Resolve a path relative to the project root and make sure it stays inside
+ * output/. Returns null for anything outside it.
+ */
+export function resolveOutputPath(relativePath: string): string | null {
+  const projectRoot = process.cwd();
+  const resolvedOutput = path.resolve(projectRoot, 'output');
+  const resolvedPath = path.resolve(projectRoot, relativePath);
+
+  if (resolvedPath !== resolvedOutput && !resolvedPath.startsWith(resolvedOutput + path.sep)) {
+    return null;
+  }
+  return resolvedPath;
+}
+
+export function toProjectRelative(absolutePath: string): string {
+  return path.relative(process.cwd(), absolutePath);
+}
+
+/**
+ * Recursively list profile dumps (callgrind.out.*, cachegrind.out.*) below
+ * a directory, sorted by path.
+ */
+export async function findProfileFiles(directory: string): Promise<string[]> {
+  const found: string[] = [];
+  const walk = async (dir: string) => {
+    const entries = await fs.readdir(dir, { withFileTypes: true });
+    for (const entry of entries) {
+      const fullPath = path.join(dir, entry.name);
+      if (entry.isDirectory()) {
+        await walk(fullPath);
+      } else if (entry.isFile() && PROFILE_FILE_PATTERN.test(entry.name) && !DERIVED_FILE_PATTERN.test(entry.name)) {
+        found.push(fullPath);
+      }
+    }
+  };
+  await walk(directory);
+  return found.sort();
+}
+
+/**
+ * Run `task` over `items` with at most `limit` tasks in flight.
+ */
+export async function mapWithConcurrency<T, R>(items: T[], limit: number, task: (item: T) => Promise<R>): Promise<R[]> {
+  const results = new Array<R>(items.length);
+  let next = 0;
+  const worker = async () => {
+    while (next < items.length) {
+      const index = next++;
+      results[index] = await task(items[index]);
+    }
+  };
+  await Promise.all(Array.from({ length: Math.min(limit, items.length) }, worker));
+  return results;
+}
@@ -0,0 +1,151 @@
+import { CachegrindData, FileCoverage } from '@/types/profiler';
+import { alignSources } from './line-alignment';
+
+/**
+ * Line-level cost comparison of two profiles. When both profiles have the
+ * source of a file, base line numbers are first carried over to the head
+ * version through a line alignment, so code inserted above a hot loop does
+ * not show up as the loop's cost moving to other lines.
+ */
+
+export interface LineCostDelta {
+  baseLine: number | null; // null for lines only in the head version
+  headLine: number | null; // null for lines removed or rewritten since the base version
+  base: number;
+  head: number;
+  delta: number;
+  text: string;
+}
+
+export interface FileCostDelta {
+  file: string; // head path, or base path for files only in the base profile
+  base: number;
+  head: number;
+  delta: number;
+  aligned: boolean; // false when line numbers were compared as-is
+  lines: LineCostDelta[]; // changed lines, largest |delta| first
+}
+
+const MISSING_SOURCE = 'Source code not available';
+
+const lineCosts = (coverage: FileCoverage, event: string): Map<number, number> => {
+  const costs = new Map<number, number>();
+  Object.values(coverage.functions).forEach(functionData => {
+    Object.entries(functionData.lines || {}).forEach(([lineKey, lineData]) => {
+      const cost = lineData[event];
+      if (typeof cost !== 'number' || cost === 0) return;
+      const line = Number(lineKey);
+      costs.set(line, (costs.get(line) || 0) + cost);
+    });
+  });
+  return costs;
+};
+
+const baseName = (file: string) => file.split('/').pop() || file;
+
+// Head file for each base file: same path, else the only head file with the same name
+const pairFiles = (base: CachegrindData, head: CachegrindData): Map<string, string> => {
+  const byName = new Map<string, string[]>();
+  Object.keys(head.fileCoverage).forEach(file => {
+    const name = baseName(file);
+    byName.set(name, [...(byName.get(name) || []), file]);
+  });
+  const pairs = new Map<string, string>();
+  const taken = new Set<string>();
+  Object.keys(base.fileCoverage).forEach(file => {
+    if (head.fileCoverage[file]) {
+      pairs.set(file, file);
+      taken.add(file);
+    }
+  });
+  Object.keys(base.fileCoverage).forEach(file => {
+    if (pairs.has(file)) return;
+    const candidates = (byName.get(baseName(file)) || []).filter(candidate => !taken.has(candidate));
+    if (candidates.length === 1) {
+      pairs.set(file, candidates[0]);
+      taken.add(candidates[0]);
+    }
+  });
+  return pairs;
+};
+
+const diffFile = (
+  file: string,
+  baseCoverage: FileCoverage | undefined,
+  headCoverage: FileCoverage | undefined,
+  event: string
+): FileCostDelta => {
+  const baseCosts = baseCoverage ? lineCosts(baseCoverage, event) : new Map<number, number>();
+  const headCosts = headCoverage ? lineCosts(headCoverage, event) : new Map<number, number>();
+  const baseText = baseCoverage && baseCoverage.sourceCode !== MISSING_SOURCE ? baseCoverage.sourceCode.split('\n') : null;
+  const headText = headCoverage && headCoverage.sourceCode !== MISSING_SOURCE ? headCoverage.sourceCode.split('\n') : null;
+  // Null when either source is missing or the two are too different to align
+  const mapping = baseText && headText ? alignSources(baseCoverage!.sourceCode, headCoverage!.sourceCode) : null;
+
+  // Base cost keyed by the head line it maps to; lines with no counterpart are kept apart
+  const mapped = new Map<number, { baseLine: number; cost: number }>();
+  const removed: LineCostDelta[] = [];
+  baseCosts.forEach((cost, baseLine) => {
+    const headLine = mapping
+      ? (baseLine - 1 < mapping.length && mapping[baseLine - 1] >= 0 ? mapping[baseLine - 1] + 1 : null)
+      : (headCoverage ? baseLine : null);
+    if (headLine === null) {
+      removed.push({ baseLine, headLine: null, base: cost, head: 0, delta: -cost, text: baseText?.[baseLine - 1]?.trim() || '' });
+    } else {
+      mapped.set(headLine, { baseLine, cost });
+    }
+  });
+
+  const lines: LineCostDelta[] = [...removed];
+  const headLines = new Set<number>([...Array.from(headCosts.keys()), ...Array.from(mapped.keys())]);
+  headLines.forEach(headLine => {
+    const base = mapped.get(headLine);
+    const head = headCosts.get(headLine) || 0;
+    const delta = head - (base?.cost || 0);
+    if (delta === 0) return;
+    lines.push({
+      baseLine: base ? base.baseLine : null,
+      headLine,
+      base: base?.cost || 0,
+      head,
+      delta,
+      text: headText?.[headLine - 1]?.trim() || ''
+    });
+  });
+  lines.sort((a, b) => Math.abs(b.delta) - Math.abs(a.delta));
+
+  let baseTotal = 0;
+  let headTotal = 0;
+  baseCosts.forEach(cost => { baseTotal += cost; });
+  headCosts.forEach(cost => { headTotal += cost; });
+  return {
+    file,
+    base: baseTotal,
+    head: headTotal,
+    delta: headTotal - baseTotal,
+    aligned: mapping !== null,
+    lines
+  };
+};
+
+/**
+ * Per-file line cost deltas for `event` from `base` to `head`. Files with
+ * no change are dropped; the rest are sorted by |delta|.
+ */
+export function diffProfileLines(base: CachegrindData, head: CachegrindData, event: string): FileCostDelta[] {
+  const pairs = pairFiles(base, head);
+  const pairedHeads = new Set(pairs.values());
+  const results: FileCostDelta[] = [];
+
+  Object.keys(base.fileCoverage).forEach(file => {
+    const headFile = pairs.get(file);
+    results.push(diffFile(headFile || file, base.fileCoverage[file], headFile ? head.fileCoverage[headFile] : undefined, event));
+  });
+  Object.keys(head.fileCoverage).forEach(file => {
+    if (!pairedHeads.has(file)) results.push(diffFile(file, undefined, head.fileCoverage[file], event));
+  });
+
+  return results
+    .filter(result => result.lines.length > 0)
+    .sort((a, b) => Math.abs(b.delta) - Math.abs(a.delta));
+}
@@ -0,0 +1,203 @@
+/**
+ * Lightweight single-pass scanner for callgrind/cachegrind dumps.
+ *
+ * Unlike CachegrindParser it builds no per-line or per-PC structures and
+ * reads no source files; it only reports cost and call lines to a visitor.
+ * This is what corpus-wide features (coverage union, test impact) use to get
+ * through hundreds of dumps quickly.
+ */
+
+export interface ProfileScanVisitor {
+  onHeader?: (events: string[], positions: string[]) => void;
+  // Self cost of one position. `costs` is reused between calls; copy it if it must be kept.
+  // `file` is the source file of the line (fi=/fe= aware), `functionFile` the file of the function (fl=).
+  onCost?: (file: string, functionName: string, line: number, costs: Float64Array, functionFile: string) => void;
+  // A call from `file:functionName` at `line`; `inclusive` is reused between calls.
+  onCall?: (
+    file: string,
+    functionName: string,
+    line: number,
+    targetFile: string,
+    targetFunction: string,
+    count: number,
+    inclusive: Float64Array,
+    functionFile: string
+  ) => void;
+  // Object file (ob=) of the cost and call lines that follow
+  onObject?: (objectFile: string) => void;
+  // Address of each cost or call position, for dumps with an instr position (--dump-instr=yes)
+  onInstr?: (address: number, executed: boolean) => void;
+}
+
+export interface ProfileScanResult {
+  events: string[];
+  positions: string[];
+  summary: Record<string, number>;
+}
+
+// Compressed names are written as "(id) name" once and "(id)" afterwards
+const resolveName = (value: string, table: Map<string, string>): string => {
+  if (value[0] !== '(') return value;
+  const close = value.indexOf(')');
+  if (close === -1) return value;
+  const id = value.substring(0, close + 1);
+  const name = value.substring(close + 1).trim();
+  if (name) {
+    table.set(id, name);
+    return name;
+  }
+  return table.get(id) || value;
+};
+
+export function scanProfile(content: string, visitor: ProfileScanVisitor): ProfileScanResult {
+  let events: string[] = [];
+  let positions: string[] = ['line'];
+  let summary: Record<string, number> = {};
+  let headerReported = false;
+
+  const fileNames = new Map<string, string>();
+  const functionNames = new Map<string, string>();
+  const objectNames = new Map<string, string>();
+
+  let currentFile = '';
+  let costFile = ''; // fi=/fe= switch the file of cost lines without changing the function
+  let currentFunction = '';
+  let callFile = '';
+  let callFunction = '';
+  let callCount = -1;
+  let skipPositionLine = false; // jump=/jcnd= lines are followed by a position line that carries no cost
+
+  let lastPositions: number[] = [];
+  let costs = new Float64Array(0);
+  let lineColumn = 0;
+  let instrColumn = -1;
+
+  const reportHeader = () => {
+    if (headerReported) return;
+    headerReported = true;
+    costs = new Float64Array(events.length);
+    lastPositions = new Array(positions.length).fill(0);
+    lineColumn = Math.max(0, positions.indexOf('line'));
+    instrColumn = positions.indexOf('instr');
+    visitor.onHeader?.(events, positions);
+  };
+
+  let start = 0;
+  const length = content.length;
+  while (start < length) {
+    let end = content.indexOf('\n', start);
+    if (end === -1) end = length;
+    let line = content.substring(start, end);
+    start = end + 1;
+    if (line.endsWith('\r')) line = line.substring(0, line.length - 1);
+    if (!line || line[0] === '#') continue;
+
+    const first = line.charCodeAt(0);
+    const isPositionLine = (first >= 48 && first <= 57) || first === 43 || first === 45 || first === 42; // 0-9 + - *
+
+    if (isPositionLine) {
+      if (!headerReported) reportHeader();
+      const parts = line.trim().split(/\s+/);
+      if (skipPositionLine) {
+        skipPositionLine = false;
+        continue;
+      }
+
+      for (let p = 0; p < positions.length; p++) {
+        const token = parts[p];
+        if (token === undefined) break;
+        let value: number;
+        if (token === '*') {
+          value = lastPositions[p];
+        } else if (token[0] === '+' || token[0] === '-') {
+          value = lastPositions[p] + (token.startsWith('+0x') || token.startsWith('-0x')
+            ? (token[0] === '-' ? -1 : 1) * parseInt(token.substring(1), 16)
+            : parseInt(token, 10));
+        } else {
+          value = token.startsWith('0x') ? parseInt(token, 16) : parseInt(token, 10);
+        }
+        lastPositions[p] = value;
+      }
+
+      costs.fill(0);
+      for (let e = 0; e < events.length; e++) {
+        const token = parts[positions.length + e];
+        if (token === undefined) break;
+        costs[e] = parseInt(token, 10) || 0;
+      }
+
+      const lineNumber = lastPositions[lineColumn];
+      if (instrColumn >= 0 && visitor.onInstr) {
+        let executed = callCount > 0;
+        for (let e = 0; e < costs.length && !executed; e++) executed = costs[e] > 0;
+        visitor.onInstr(lastPositions[instrColumn], executed);
+      }
+      if (callCount >= 0) {
+        visitor.onCall?.(costFile, currentFunction, lineNumber, callFile || currentFile, callFunction, callCount, costs, currentFile);
+        callCount = -1;
+        callFile = '';
+      } else {
+        visitor.onCost?.(costFile, currentFunction, lineNumber, costs, currentFile);
+      }
+      continue;
+    }
+
+    const eq = line.indexOf('=');
+    const colon = line.indexOf(':');
+    if (eq > 0 && (colon === -1 || eq < colon)) {
+      const key = line.substring(0, eq);
+      const value = line.substring(eq + 1);
+      switch (key) {
+        case 'fl':
+          currentFile = resolveName(value, fileNames);
+          costFile = currentFile;
+          break;
+        case 'fi':
+        case 'fe':
+          costFile = resolveName(value, fileNames);
+          break;
+        case 'ob':
+          visitor.onObject?.(resolveName(value, objectNames));
+          break;
+        case 'cob':
+          resolveName(value, objectNames); // only to learn compressed names
+          break;
+        case 'fn':
+          currentFunction = resolveName(value, functionNames);
+          costFile = currentFile;
+          break;
+        case 'cfi':
+        case 'cfl':
+          callFile = resolveName(value, fileNames);
+          break;
+        case 'cfn':
+          callFunction = resolveName(value, functionNames);
+          break;
+        case 'calls':
+          callCount = parseInt(value, 10) || 1;
+          break;
+        case 'jump':
+        case 'jcnd':
+          skipPositionLine = true;
+          break;
+      }
+      continue;
+    }
+
+    if (colon > 0) {
+      const key = line.substring(0, colon);
+      const value = line.substring(colon + 1).trim();
+      if (key === 'events') {
+        events = value.split(/\s+/);
+      } else if (key === 'positions') {
+        positions = value.split(/\s+/);
+      } else if (key === 'summary' || key === 'totals') {
+        const values = value.split(/\s+/);
+        summary = Object.fromEntries(events.map((event, idx) => [event, parseInt(values[idx] || '0', 10)]));
+      }
+    }
+  }
+
+  if (!headerReported) reportHeader();
+  return { events, positions, summary };
+}
@@ -0,0 +1,219 @@
+import { createHash, randomBytes } from 'crypto';
+import fs from 'fs/promises';
+import os from 'os';
+import path from 'path';
+
+/**
+ * On-disk snapshots of parse results, shared by every server process
+ * (see cluster-server.mjs). A result is keyed by a hash of its inputs and
+ * stored as UTF-8 JSON under PROFILER_SNAPSHOT_DIR (default
+ * .profile-snapshots/ in the project root).
+ *
+ * - Publication is lock-free for readers: a snapshot is written to a
+ *   private temporary file and renamed into place, so a reader sees either
+ *   no file or a complete one.
+ * - Each result is built once across all processes: the first process to
+ *   create `<key>.lock` builds it, the others wait for the snapshot to
+ *   appear. A lock whose holder died, or that was not refreshed for
+ *   STALE_LOCK_MS, is taken over, so a crashed worker does not block a
+ *   profile forever.
+ * - Nothing is held in process memory between requests; repeat reads come
+ *   from the page cache, which all processes share. The parsed value is not
+ *   shared, though: every request that misses the in-flight promise
+ *   JSON.parses its own copy, so a large profile is held once per
+ *   concurrent request in each process.
+ */
+
+const STALE_LOCK_MS = 10 * 60 * 1000;
+const POLL_INTERVAL_MS = 100;
+const MAX_SNAPSHOT_BYTES = 2 * 1024 * 1024 * 1024; // pruned oldest-first past this
+
+export const snapshotDirectory = () =>
+  path.resolve(process.cwd(), process.env.PROFILER_SNAPSHOT_DIR || '.profile-snapshots');
+
+// Requests in this process already waiting on a key share one promise
+const inFlight = new Map<string, Promise<unknown>>();
+
+/**
+ * Identity of a file for snapshot keys; changes whenever the file is rewritten.
+ */
+export async function fileVersion(filePath: string): Promise<string> {
+  const stats = await fs.stat(filePath);
+  return `${filePath}:${stats.mtimeMs}:${stats.size}`;
+}
+
+export const snapshotKey = (parts: Array<string | Buffer>): string => {
+  const hash = createHash('sha1');
+  parts.forEach(part => hash.update(part).update('\0'));
+  return hash.digest('hex');
+};
+
+// Wrapped so a stored null is told apart from a missing snapshot
+const readSnapshot = async <T>(file: string): Promise<{ value: T } | null> => {
+  try {
+    return { value: JSON.parse(await fs.readFile(file, 'utf-8')) as T };
+  } catch (error) {
+    if ((error as NodeJS.ErrnoException).code === 'ENOENT') return null;
+    throw error;
+  }
+};
+
+const publishSnapshot = async (file: string, value: unknown) => {
+  const temporary = `${file}.${process.pid}.${randomBytes(4).toString('hex')}.tmp`;
+  try {
+    await fs.writeFile(temporary, JSON.stringify(value));
+    await fs.rename(temporary, file);
+  } catch (error) {
+    await fs.rm(temporary, { force: true });
+    throw error;
+  }
+};
+
+// Lock contents: host, pid and a token unique to this acquisition
+const lockOwner = () => `${os.hostname()} ${process.pid} ${randomBytes(8).toString('hex')}`;
+
+// A lock is stale when its holder is a dead process on this host, or when
+// nobody has refreshed it for STALE_LOCK_MS (a hung or remote holder)
+const isStaleLock = (owner: string, mtimeMs: number): boolean => {
+  if (Date.now() - mtimeMs >= STALE_LOCK_MS) return true;
+  const [host, pid] = owner.split(' ');
+  if (host !== os.hostname() || !pid) return false;
+  try {
+    process.kill(Number(pid), 0);
+    return false;
+  } catch (error) {
+    return (error as NodeJS.ErrnoException).code === 'ESRCH';
+  }
+};
+
+// Create a file exclusively; false when it already exists
+const createExclusive = async (file: string, owner: string): Promise<boolean> => {
+  try {
+    await fs.writeFile(file, owner, { flag: 'wx' });
+    return true;
+  } catch (error) {
+    if ((error as NodeJS.ErrnoException).code !== 'EEXIST') throw error;
+    return false;
+  }
+};
+
+/**
+ * Create the lock exclusively. Taking over a stale lock needs
+ * `<key>.lock.takeover` as well, so only one process at a time checks and
+ * replaces it; the others wait as they would for a live holder.
+ */
+const acquireLock = async (lockFile: string, owner: string): Promise<boolean> => {
+  if (await createExclusive(lockFile, owner)) return true;
+
+  const takeover = `${lockFile}.takeover`;
+  if (!(await createExclusive(takeover, owner))) {
+    // Held only for a few file operations, so an old one was left by a crash
+    const stats = await fs.stat(takeover).catch(() => null);
+    if (stats && Date.now() - stats.mtimeMs >= STALE_LOCK_MS) await fs.rm(takeover, { force: true });
+    return false;
+  }
+  try {
+    const [holder, stats] = await Promise.all([
+      fs.readFile(lockFile, 'utf-8').catch(() => null),
+      fs.stat(lockFile).catch(() => null)
+    ]);
+    if (holder !== null && stats && !isStaleLock(holder, stats.mtimeMs)) return false;
+    await fs.rm(lockFile, { force: true });
+    return await createExclusive(lockFile, owner);
+  } finally {
+    await fs.rm(takeover, { force: true });
+  }
+};
+
+// Remove the lock only while it is still ours
+const releaseLock = async (lockFile: string, owner: string) => {
+  const holder = await fs.readFile(lockFile, 'utf-8').catch(() => null);
+  if (holder === owner) await fs.rm(lockFile, { force: true });
+};
+
+const pruneSnapshots = async (directory: string) => {
+  const entries = await fs.readdir(directory);
+  const snapshots = await Promise.all(entries
+    .filter(name => name.endsWith('.json'))
+    .map(async name => {
+      const stats = await fs.stat(path.join(directory, name)).catch(() => null);
+      return { name, size: stats?.size || 0, atimeMs: stats?.atimeMs || 0 };
+    }));
+  let total = snapshots.reduce((sum, s) => sum + s.size, 0);
+  snapshots.sort((a, b) => a.atimeMs - b.atimeMs);
+  for (const snapshot of snapshots) {
+    if (total <= MAX_SNAPSHOT_BYTES) break;
+    await fs.rm(path.join(directory, snapshot.name), { force: true });
+    total -= snapshot.size;
+  }
+};
+
+const loadOrBuild = async <T>(key: string, build: () => Promise<T> | T): Promise<T> => {
+  const directory = snapshotDirectory();
+  const file = path.join(directory, `${key}.json`);
+  const lockFile = path.join(directory, `${key}.lock`);
+
+  const existing = await readSnapshot<T>(file);
+  if (existing) return existing.value;
+  await fs.mkdir(directory, { recursive: true });
+
+  const owner = lockOwner();
+  for (;;) {
+    if (await acquireLock(lockFile, owner)) {
+      // Keep the lock fresh through long builds so it is not taken for stale
+      const refresh = setInterval(() => {
+        const now = new Date();
+        fs.utimes(lockFile, now, now).catch(() => undefined);
+      }, STALE_LOCK_MS / 4);
+      try {
+        // Another process may have published between our read and the lock
+        const published = await readSnapshot<T>(file);
+        if (published) return published.value;
+        const value = await build();
+        try {
+          await publishSnapshot(file, value);
+          pruneSnapshots(directory).catch(error => console.error('Error pruning profile snapshots:', error));
+        } catch (error) {
+          console.error('Error publishing profile snapshot:', error);
+        }
+        return value;
+      } finally {
+        clearInterval(refresh);
+        await releaseLock(lockFile, owner);
+      }
+    }
+    await new Promise(resolve => setTimeout(resolve, POLL_INTERVAL_MS));
+    const published = await readSnapshot<T>(file);
+    if (published) return published.value;
+  }
+};
+
+/**
+ * The snapshot stored under `key`, or null if no process has published one.
+ */
+export async function loadSnapshot<T>(key: string): Promise<T | null> {
+  const snapshot = await readSnapshot<T>(path.join(snapshotDirectory(), `${key}.json`)).catch(() => null);
+  return snapshot ? snapshot.value : null;
+}
+
+/**
+ * Return the snapshot stored under `key`, building and publishing it with
+ * `build` if no process has yet. Falls back to building in this process
+ * when the snapshot directory cannot be written.
+ */
+export async function withSnapshot<T>(key: string, build: () => Promise<T> | T): Promise<T> {
+  const pending = inFlight.get(key) as Promise<T> | undefined;
+  if (pending) return pending;
+
+  const result = loadOrBuild(key, build).catch(async error => {
+    if (!['EACCES', 'EROFS', 'ENOSPC'].includes((error as NodeJS.ErrnoException).code || '')) throw error;
+    console.error('Error opening profile snapshots, parsing without them:', error);
+    return build();
+  });
+  inFlight.set(key, result);
+  try {
+    return await result;
+  } finally {
+    inFlight.delete(key);
+  }
+}
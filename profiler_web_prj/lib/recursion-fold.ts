@@ -0,0 +1,300 @@
+import { CachegrindData, CallInfo, FileCoverage, FunctionData, RecursionInfo } from '@/types/profiler';
+import { functionKey } from './call-graph';
+
+// callgrind --separate-recs=N names deeper recursion levels `func'2`, `func'3`, ...
+const SEPARATE_RECS_PATTERN = /^(.*)'(\d+)$/;
+
+interface WorkingFunction {
+  file: string;
+  name: string;
+  data: FunctionData;
+  depthTotals: Record<string, number>[];
+}
+
+export function splitRecursionLevel(functionName: string): { name: string; depth: number } {
+  const match = functionName.match(SEPARATE_RECS_PATTERN);
+  return match ? { name: match[1], depth: parseInt(match[2]) } : { name: functionName, depth: 1 };
+}
+
+const addEvents = (target: Record<string, number>, source: Record<string, number> | undefined, scale: number = 1) => {
+  Object.entries(source || {}).forEach(([event, value]) => {
+    target[event] = (target[event] || 0) + value * scale;
+  });
+};
+
+const mergeFunctionData = (target: FunctionData, source: FunctionData) => {
+  addEvents(target.totals, source.totals);
+  Object.entries(source.lines).forEach(([line, lineData]) => {
+    const existing = target.lines[Number(line)];
+    if (!existing) {
+      target.lines[Number(line)] = { ...lineData };
+      return;
+    }
+    Object.entries(lineData).forEach(([key, value]) => {
+      if (typeof value === 'number') {
+        existing[key] = ((existing[key] as number) || 0) + value;
+      }
+    });
+    existing.executed = existing.executed || lineData.executed;
+  });
+  target.coveredLines = Array.from(new Set([...target.coveredLines, ...source.coveredLines])).sort((a, b) => a - b);
+  target.uncoveredLines = target.uncoveredLines.filter(line => !target.coveredLines.includes(line));
+  if (source.pcData) {
+    target.pcData = { ...(target.pcData || {}), ...source.pcData };
+  }
+  if (source.calls) {
+    target.calls = [...(target.calls || []), ...source.calls];
+  }
+};
+
+/**
+ * Fold recursion in the function-level call graph so every recursive
+ * function appears once with its cost summed over all recursion depths.
+ *
+ * 1. `--separate-recs` levels (`func'2`, ...) are merged into their base
+ *    function, keeping the per-level totals as a depth histogram.
+ * 2. Recursive cycles (strongly connected components) are reduced to a
+ *    spanning tree from their heaviest entry. Recursive re-entry calls are
+ *    dropped and counted on the re-entered function instead.
+ * 3. Call edges inside a cycle get their inclusive cost recomputed from the
+ *    tree. Callgrind's own inclusive cost for these edges counts deeper
+ *    levels once per level, so summing it overstates the cost.
+ *
+ * Returns a new CachegrindData; the input is not modified.
+ */
+export function foldRecursion(data: CachegrindData): CachegrindData {
+  const costEvent = data.events.includes('Cy') ? 'Cy' : (data.events.includes('Ir') ? 'Ir' : data.events[0]);
+  let changed = false;
+
+  // Merge recursion levels into their base function
+  const functions = new Map<string, WorkingFunction>();
+  Object.entries(data.fileCoverage).forEach(([filename, fileData]) => {
+    Object.entries(fileData.functions || {}).forEach(([funcName, funcData]) => {
+      const { name, depth } = splitRecursionLevel(funcName);
+      const key = functionKey(filename, name);
+      let func = functions.get(key);
+      if (!func) {
+        func = {
+          file: filename,
+          name,
+          data: {
+            ...funcData,
+            lines: {},
+            totals: {},
+            coveredLines: [],
+            uncoveredLines: [...funcData.uncoveredLines],
+            pcData: funcData.pcData ? {} : undefined,
+            calls: undefined
+          },
+          depthTotals: []
+        };
+        functions.set(key, func);
+      }
+      mergeFunctionData(func.data, funcData);
+      func.depthTotals[depth - 1] = { ...funcData.totals };
+      if (depth > 1) changed = true;
+    });
+  });
+
+  // Point calls at the merged functions and combine calls from the same site
+  functions.forEach(func => {
+    if (!func.data.calls) return;
+    const merged = new Map<string, CallInfo>();
+    func.data.calls.forEach(call => {
+      const targetFunction = call.targetFunction ? splitRecursionLevel(call.targetFunction).name : call.targetFunction;
+      const key = `${call.sourcePc}|${call.targetFile || func.file}|${targetFunction}`;
+      const existing = merged.get(key);
+      if (existing) {
+        const inclusiveEvents = { ...(existing.inclusiveEvents || {}) };
+        addEvents(inclusiveEvents, call.inclusiveEvents);
+        merged.set(key, { ...existing, count: existing.count + call.count, inclusiveEvents });
+      } else {
+        merged.set(key, { ...call, targetFunction });
+      }
+    });
+    func.data.calls = Array.from(merged.values());
+  });
+
+  const targetKey = (func: WorkingFunction, call: CallInfo) => functionKey(call.targetFile || func.file, call.targetFunction || '');
+  const calleesOf = (func: WorkingFunction) =>
+    (func.data.calls || []).filter(call => call.targetFunction && functions.has(targetKey(func, call)));
+
+  // Strongly connected components (iterative Tarjan, recursion depth can be large)
+  const index = new Map<string, number>();
+  const lowLink = new Map<string, number>();
+  const onStack = new Set<string>();
+  const stack: string[] = [];
+  const componentOf = new Map<string, number>();
+  const components: string[][] = [];
+  let nextIndex = 0;
+
+  functions.forEach((_, startKey) => {
+    if (index.has(startKey)) return;
+    const work: Array<{ key: string; callees: string[]; position: number }> = [];
+    const visit = (key: string) => {
+      index.set(key, nextIndex);
+      lowLink.set(key, nextIndex);
+      nextIndex++;
+      stack.push(key);
+      onStack.add(key);
+      const func = functions.get(key)!;
+      work.push({ key, callees: calleesOf(func).map(call => targetKey(func, call)), position: 0 });
+    };
+    visit(startKey);
+
+    while (work.length > 0) {
+      const frame = work[work.length - 1];
+      if (frame.position < frame.callees.length) {
+        const callee = frame.callees[frame.position++];
+        if (!index.has(callee)) {
+          visit(callee);
+        } else if (onStack.has(callee)) {
+          lowLink.set(frame.key, Math.min(lowLink.get(frame.key)!, index.get(callee)!));
+        }
+        continue;
+      }
+
+      work.pop();
+      if (work.length > 0) {
+        const parent = work[work.length - 1].key;
+        lowLink.set(parent, Math.min(lowLink.get(parent)!, lowLink.get(frame.key)!));
+      }
+      if (lowLink.get(frame.key) === index.get(frame.key)) {
+        const component: string[] = [];
+        let member: string;
+        do {
+          member = stack.pop()!;
+          onStack.delete(member);
+          componentOf.set(member, components.length);
+          component.push(member);
+        } while (member !== frame.key);
+        components.push(component);
+      }
+    }
+  });
+
+  const recursion = new Map<string, RecursionInfo>();
+  const getRecursion = (key: string): RecursionInfo => {
+    let info = recursion.get(key);
+    if (!info) {
+      info = { depthTotals: [], entries: 0, reentries: 0 };
+      recursion.set(key, info);
+    }
+    return info;
+  };
+
+  components.forEach((component, componentIndex) => {
+    const members = new Set(component);
+    const isRecursive = component.length > 1 || component.some(key => {
+      const func = functions.get(key)!;
+      return calleesOf(func).some(call => targetKey(func, call) === key);
+    });
+    if (!isRecursive) return;
+    changed = true;
+
+    // Calls into the cycle from outside give the entry points and their weight
+    const entryWeight = new Map<string, number>();
+    functions.forEach((caller, callerKey) => {
+      if (componentOf.get(callerKey) === componentIndex) return;
+      calleesOf(caller).forEach(call => {
+        const target = targetKey(caller, call);
+        if (!members.has(target)) return;
+        entryWeight.set(target, (entryWeight.get(target) || 0) + (call.inclusiveEvents?.[costEvent] || 0));
+        getRecursion(target).entries += call.count;
+      });
+    });
+    const starts = [...component].sort((a, b) =>
+      (entryWeight.get(b) ?? -1) - (entryWeight.get(a) ?? -1)
+      || (functions.get(b)!.data.totals[costEvent] || 0) - (functions.get(a)!.data.totals[costEvent] || 0));
+
+    // Spanning tree over the cycle; every other call inside it is a re-entry
+    const treeParent = new Map<string, string>();
+    const order: string[] = [];
+    const seen = new Set<string>();
+    starts.forEach(start => {
+      if (seen.has(start)) return;
+      seen.add(start);
+      const queue = [start];
+      while (queue.length > 0) {
+        const key = queue.shift()!;
+        order.push(key);
+        const func = functions.get(key)!;
+        calleesOf(func).forEach(call => {
+          const target = targetKey(func, call);
+          if (!members.has(target) || seen.has(target)) return;
+          seen.add(target);
+          treeParent.set(target, key);
+          queue.push(target);
+        });
+      }
+    });
+
+    component.forEach(key => {
+      const func = functions.get(key)!;
+      const info = getRecursion(key);
+      if (component.length > 1) {
+        info.cycle = component.filter(other => other !== key).map(other => functions.get(other)!.name);
+      }
+      func.data.calls = (func.data.calls || []).filter(call => {
+        const target = call.targetFunction ? targetKey(func, call) : '';
+        if (!members.has(target) || treeParent.get(target) === key) return true;
+        getRecursion(target).reentries += call.count;
+        return false;
+      });
+    });
+
+    // Recompute inclusive cost bottom-up along the tree
+    const subtreeInclusive = new Map<string, Record<string, number>>();
+    [...order].reverse().forEach(key => {
+      const func = functions.get(key)!;
+      const inclusive: Record<string, number> = { ...func.data.totals };
+      const treeCalls = (func.data.calls || []).filter(call => call.targetFunction && members.has(targetKey(func, call)));
+      func.data.calls?.forEach(call => {
+        if (!treeCalls.includes(call)) addEvents(inclusive, call.inclusiveEvents);
+      });
+
+      // Parallel call sites to the same child share its subtree cost by their original weight
+      const byChild = new Map<string, CallInfo[]>();
+      treeCalls.forEach(call => {
+        const child = targetKey(func, call);
+        byChild.set(child, [...(byChild.get(child) || []), call]);
+      });
+      byChild.forEach((calls, child) => {
+        const childInclusive = subtreeInclusive.get(child) || {};
+        const totalWeight = calls.reduce((sum, call) => sum + (call.inclusiveEvents?.[costEvent] || call.count || 1), 0);
+        calls.forEach(call => {
+          const share = totalWeight > 0 ? (call.inclusiveEvents?.[costEvent] || call.count || 1) / totalWeight : 1 / calls.length;
+          const inclusiveEvents: Record<string, number> = {};
+          addEvents(inclusiveEvents, childInclusive, share);
+          Object.keys(inclusiveEvents).forEach(event => { inclusiveEvents[event] = Math.round(inclusiveEvents[event]); });
+          const callIndex = func.data.calls!.indexOf(call);
+          func.data.calls![callIndex] = { ...call, inclusiveEvents };
+        });
+        addEvents(inclusive, childInclusive);
+      });
+      subtreeInclusive.set(key, inclusive);
+    });
+  });
+
+  // Depth histograms come from --separate-recs levels
+  functions.forEach((func, key) => {
+    const levels = func.depthTotals.length;
+    if (levels <= 1 && !recursion.has(key)) return;
+    const info = getRecursion(key);
+    info.depthTotals = Array.from({ length: levels }, (_, depth) => func.depthTotals[depth] || {});
+    info.maxDepth = levels > 1 ? levels : undefined;
+  });
+
+  if (!changed) return data;
+
+  const fileCoverage: Record<string, FileCoverage> = {};
+  Object.entries(data.fileCoverage).forEach(([filename, fileData]) => {
+    fileCoverage[filename] = { ...fileData, functions: {} };
+  });
+  functions.forEach((func, key) => {
+    const info = recursion.get(key);
+    fileCoverage[func.file].functions[func.name] = info ? { ...func.data, recursion: info } : func.data;
+  });
+
+  return { ...data, fileCoverage };
+}
@@ -0,0 +1,188 @@
+import {
+  CallGraph,
+  CallGraphNode,
+  createApplicationCharger,
+  findApplicationObjects,
+  isApplicationNode
+} from './call-graph';
+import { globToRegExp } from './frame-collapse';
+
+/**
+ * Charge the cost of runtime function families (allocator, locking,
+ * memory and string routines) to the application code that causes it.
+ * A family's cost is the inclusive cost of the call edges entering it from
+ * outside the family. When such an edge starts in library code (printf
+ * calling strlen), its cost is passed up to that function's callers in
+ * proportion to the inclusive cost each caller edge carries, until it
+ * reaches an application frame. Cost that only reaches library roots
+ * (loader startup, exit handlers) is reported as unattributed.
+ *
+ * Family patterns only match functions outside the application objects,
+ * so application functions named like them (allocate_memory) are left alone.
+ */
+
+export interface RuntimeFamily {
+  name: string;
+  patterns: string[]; // glob patterns on function names
+  allocator?: boolean; // call sites into it are checked for pool or arena use
+}
+
+export const DEFAULT_RUNTIME_FAMILIES: RuntimeFamily[] = [
+  {
+    name: 'Allocator',
+    patterns: [
+      'malloc', 'free', 'calloc', 'realloc', 'cfree', 'memalign', 'aligned_alloc', 'posix_memalign', 'valloc',
+      'pvalloc', '__libc_*alloc', '__libc_free', '_int_*', 'tcache_*', 'malloc_consolidate', 'ptmalloc_init*',
+      'operator new*', 'operator delete*', 'strdup', 'strndup'
+    ],
+    allocator: true
+  },
+  {
+    name: 'Locking',
+    patterns: [
+      'pthread_mutex_*', 'pthread_rwlock_*', 'pthread_spin_*', 'pthread_cond_*', '__pthread_mutex_*',
+      '__lll_lock*', '__lll_unlock*', 'lll_*', 'futex_*', '__futex*', 'std::mutex::*', 'std::__atomic_futex*'
+    ]
+  },
+  {
+    name: 'Memory/string',
+    patterns: [
+      'memcpy*', 'memmove*', 'memset*', 'memcmp*', 'memchr*', 'memrchr*', 'mempcpy*', '__mem*', 'wmem*', '__wmem*',
+      'bcmp', 'bzero', '__bzero*', 'rawmemchr', '__rawmemchr*', 'str*', '__str*', 'wcs*', '__wcs*'
+    ]
+  }
+];
+
+const FAMILIES_STORAGE_KEY = 'profiler-runtime-families';
+
+export function loadRuntimeFamilies(): RuntimeFamily[] {
+  if (typeof window === 'undefined') return DEFAULT_RUNTIME_FAMILIES;
+  try {
+    const saved = localStorage.getItem(FAMILIES_STORAGE_KEY);
+    if (saved) {
+      const parsed = JSON.parse(saved);
+      if (Array.isArray(parsed)) return parsed;
+    }
+  } catch {
+    // Fall back to defaults on malformed settings
+  }
+  return DEFAULT_RUNTIME_FAMILIES;
+}
+
+export function saveRuntimeFamilies(families: RuntimeFamily[]): void {
+  localStorage.setItem(FAMILIES_STORAGE_KEY, JSON.stringify(families));
+}
+
+export interface FamilyTotal {
+  family: RuntimeFamily;
+  cost: number; // inclusive cost entering the family
+  calls: number;
+  attributed: number; // part charged to application frames
+}
+
+export interface FamilyCallerCost {
+  caller: CallGraphNode; // nearest application frame
+  family: RuntimeFamily;
+  cost: number;
+  calls: number; // calls into the family, apportioned like the cost
+  direct: number; // part of the cost from calls made by the caller itself
+  lines: number[]; // source lines of the caller's direct calls into the family
+}
+
+export interface PoolCandidate {
+  site: FamilyCallerCost;
+  share: number; // allocator cost as a fraction of the caller's inclusive cost
+  costPerCall: number;
+}
+
+export interface RuntimeFamilyAnalysis {
+  event: string;
+  total: number;
+  families: FamilyTotal[];
+  callers: FamilyCallerCost[]; // ranked by cost
+  poolCandidates: PoolCandidate[];
+}
+
+const MIN_POOL_CALLS = 100;
+const MIN_POOL_SHARE = 0.05;
+
+export function analyzeRuntimeFamilies(
+  graph: CallGraph,
+  families: RuntimeFamily[],
+  event: string,
+  total: number
+): RuntimeFamilyAnalysis {
+  const applicationObjects = findApplicationObjects(graph);
+  const matchers = families.map(family => family.patterns.filter(p => p.trim()).map(p => globToRegExp(p.trim())));
+  const familyOf = new Map<string, number>();
+  graph.nodes.forEach(node => {
+    if (isApplicationNode(node, applicationObjects)) return;
+    const index = matchers.findIndex(regexps => regexps.some(regexp => regexp.test(node.functionName)));
+    if (index >= 0) familyOf.set(node.key, index);
+  });
+  const isAppFrame = (node: CallGraphNode) => isApplicationNode(node, applicationObjects);
+  const chargeToApplication = createApplicationCharger(graph, isAppFrame);
+
+  const totals: FamilyTotal[] = families.map(family => ({ family, cost: 0, calls: 0, attributed: 0 }));
+  const charges = new Map<string, FamilyCallerCost>();
+  const charge = (caller: CallGraphNode, f: number, cost: number, calls: number, direct: boolean, line?: number) => {
+    const key = `${caller.key}\0${f}`;
+    let entry = charges.get(key);
+    if (!entry) {
+      entry = { caller, family: families[f], cost: 0, calls: 0, direct: 0, lines: [] };
+      charges.set(key, entry);
+    }
+    entry.cost += cost;
+    entry.calls += calls;
+    if (direct) entry.direct += cost;
+    if (line !== undefined && !entry.lines.includes(line)) entry.lines.push(line);
+    totals[f].attributed += cost;
+  };
+
+  families.forEach((_, f) => {
+    // Library frames holding [cost, calls] into the family that still has to reach an application caller
+    const held = new Map<CallGraphNode, number[]>();
+
+    graph.edges.forEach(edge => {
+      if (familyOf.get(edge.callee.key) !== f || familyOf.get(edge.caller.key) === f) return;
+      const cost = edge.inclusive[event] || 0;
+      totals[f].cost += cost;
+      totals[f].calls += edge.count;
+      if (isAppFrame(edge.caller)) {
+        charge(edge.caller, f, cost, edge.count, true, edge.call.sourceLine);
+        return;
+      }
+      const amounts = held.get(edge.caller);
+      if (amounts) {
+        amounts[0] += cost;
+        amounts[1] += edge.count;
+      } else {
+        held.set(edge.caller, [cost, edge.count]);
+      }
+    });
+
+    // Calls are apportioned like the cost
+    chargeToApplication(held, [event, event], (edge, [cost, calls]) => charge(edge.caller, f, cost, calls, false));
+  });
+
+  const callers = Array.from(charges.values()).sort((a, b) => b.cost - a.cost);
+  callers.forEach(entry => entry.lines.sort((a, b) => a - b));
+
+  // Frequent allocation that is a noticeable part of the caller's own work
+  const poolCandidates = callers
+    .filter(site => site.family.allocator && site.calls >= MIN_POOL_CALLS)
+    .map(site => {
+      const inclusive = site.caller.inclusive[event] || 0;
+      return { site, share: inclusive > 0 ? site.cost / inclusive : 0, costPerCall: site.calls > 0 ? site.cost / site.calls : 0 };
+    })
+    .filter(candidate => candidate.share >= MIN_POOL_SHARE)
+    .sort((a, b) => b.site.cost - a.site.cost);
+
+  return {
+    event,
+    total,
+    families: totals,
+    callers,
+    poolCandidates
+  };
+}
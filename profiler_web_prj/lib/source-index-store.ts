@@ -0,0 +1,113 @@
+import { createHash } from 'crypto';
+import { SourceIndex, SourceSearchResult } from './source-index';
+
+// Server-side, process-wide source index shared by the indexing action and the search route.
+// Each profile gets its own file set (scope); contents are shared between scopes. Under
+// cluster-server.mjs every worker has its own index: a worker asked about a scope it has not
+// seen rebuilds it from the scope's snapshot (see app/actions/source-search.ts).
+
+const sourceIndex = new SourceIndex();
+
+const MAX_SCOPES = 16; // least recently indexed or searched scopes are dropped past this
+
+interface SourceScope {
+  files: Map<string, string>; // path -> content hash
+  queued: number; // files in the latest batch
+  indexed: number;
+  dropped?: boolean;
+}
+
+const scopes = new Map<string, SourceScope>(); // oldest first
+const queue: Array<{ scope: SourceScope; file: string; content: string }> = [];
+let running = false;
+
+/**
+ * Scope key for a profile's source files: the same source directories and
+ * file list always give the same scope.
+ */
+export function sourceScopeKey(srcSubdirs: string[], files: string[]): string {
+  return createHash('sha1').update(JSON.stringify([srcSubdirs, [...files].sort()])).digest('hex');
+}
+
+const touchScope = (key: string): SourceScope | undefined => {
+  const scope = scopes.get(key);
+  if (scope) {
+    scopes.delete(key);
+    scopes.set(key, scope);
+  }
+  return scope;
+};
+
+export function hasSourceScope(key: string): boolean {
+  return scopes.has(key);
+}
+
+export function sourceIndexProgress(key: string): { indexed: number; total: number; done: boolean } {
+  const scope = scopes.get(key);
+  if (!scope) return { indexed: 0, total: 0, done: true };
+  return { indexed: scope.indexed, total: scope.queued, done: scope.indexed >= scope.queued };
+}
+
+export function searchSources(key: string, query: string): Generator<SourceSearchResult> {
+  return sourceIndex.search(query, touchScope(key)?.files || new Map());
+}
+
+/**
+ * Queue a profile's files for indexing under its scope and return
+ * immediately. Files the scope no longer references are released at once;
+ * the rest are hashed and indexed a few at a time, yielding to the event
+ * loop between batches so requests are still served while a large tree is
+ * being indexed.
+ */
+export function scheduleSourceIndexing(key: string, files: Array<{ file: string; content: string }>) {
+  let scope = touchScope(key);
+  if (!scope) {
+    scope = { files: new Map(), queued: 0, indexed: 0 };
+    scopes.set(key, scope);
+    while (scopes.size > MAX_SCOPES) {
+      const [oldestKey, oldest] = scopes.entries().next().value as [string, SourceScope];
+      scopes.delete(oldestKey);
+      oldest.files.forEach(hash => sourceIndex.releaseSource(hash));
+      oldest.files.clear();
+      oldest.dropped = true;
+    }
+  }
+
+  const current = scope;
+  const wanted = new Set(files.map(({ file }) => file));
+  current.files.forEach((hash, file) => {
+    if (wanted.has(file)) return;
+    sourceIndex.releaseSource(hash);
+    current.files.delete(file);
+  });
+  // Progress counts this batch only; a batch still queued for the scope is superseded
+  for (let i = queue.length - 1; i >= 0; i--) {
+    if (queue[i].scope === current) queue.splice(i, 1);
+  }
+  queue.push(...files.map(({ file, content }) => ({ scope: current, file, content })));
+  current.queued = files.length;
+  current.indexed = 0;
+  if (running) return;
+  running = true;
+
+  const step = () => {
+    const deadline = Date.now() + 20;
+    while (queue.length > 0 && Date.now() < deadline) {
+      const { scope, file, content } = queue.shift()!;
+      scope.indexed++;
+      if (scope.dropped) continue;
+      const hash = createHash('sha1').update(content).digest('hex');
+      const previous = scope.files.get(file);
+      if (previous === hash) continue;
+      sourceIndex.addSource(hash, content);
+      if (previous) sourceIndex.releaseSource(previous);
+      scope.files.set(file, hash);
+    }
+    if (queue.length > 0) {
+      setImmediate(step);
+    } else {
+      running = false;
+    }
+  };
+  setImmediate(step);
+}
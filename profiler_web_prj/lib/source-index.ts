@@ -0,0 +1,108 @@
+/**
+ * Trigram index over source contents for substring search. Contents are
+ * stored once per content hash and reference-counted, so the same file in
+ * several profiles (or under several paths) is indexed once. A search runs
+ * over one file set, path -> content hash, so each profile only sees the
+ * files it references.
+ */
+
+export interface SourceSearchHit {
+  line: number;
+  text: string;
+}
+
+export interface SourceSearchResult {
+  file: string;
+  hits: SourceSearchHit[];
+}
+
+interface IndexedSource {
+  lines: string[];
+  lowerLines: string[];
+  trigrams: Set<string>;
+  refs: number; // file set entries currently holding this content
+}
+
+const MAX_HITS_PER_FILE = 200;
+const MAX_LINE_LENGTH = 300;
+
+const trigramsOf = (text: string): Set<string> => {
+  const trigrams = new Set<string>();
+  for (let i = 0; i + 3 <= text.length; i++) trigrams.add(text.substring(i, i + 3));
+  return trigrams;
+};
+
+export class SourceIndex {
+  private byHash = new Map<string, IndexedSource>();
+  private postings = new Map<string, Set<string>>(); // trigram -> content hashes
+
+  // Take a reference on `content`, indexing it if no file set holds it yet
+  addSource(hash: string, content: string) {
+    let source = this.byHash.get(hash);
+    if (!source) {
+      const lines = content.split('\n');
+      const lowerLines = lines.map(line => line.toLowerCase());
+      source = { lines, lowerLines, trigrams: trigramsOf(lowerLines.join('\n')), refs: 0 };
+      this.byHash.set(hash, source);
+      source.trigrams.forEach(trigram => {
+        let hashes = this.postings.get(trigram);
+        if (!hashes) {
+          hashes = new Set();
+          this.postings.set(trigram, hashes);
+        }
+        hashes.add(hash);
+      });
+    }
+    source.refs++;
+  }
+
+  // Drop a reference; content nobody holds any more leaves the index
+  releaseSource(hash: string) {
+    const source = this.byHash.get(hash);
+    if (!source || --source.refs > 0) return;
+    this.byHash.delete(hash);
+    source.trigrams.forEach(trigram => {
+      const hashes = this.postings.get(trigram);
+      hashes?.delete(hash);
+      if (hashes && hashes.size === 0) this.postings.delete(trigram);
+    });
+  }
+
+  // Contents with every trigram of the query; all of them for queries under three characters
+  private candidates(needle: string, hashes: Set<string>): Set<string> {
+    if (needle.length < 3) return hashes;
+    const trigrams = Array.from(trigramsOf(needle))
+      .map(trigram => this.postings.get(trigram))
+      .sort((a, b) => (a?.size || 0) - (b?.size || 0));
+    if (trigrams.some(set => !set)) return new Set();
+    const [smallest, ...rest] = trigrams as Set<string>[];
+    return new Set(Array.from(smallest).filter(hash => hashes.has(hash) && rest.every(set => set.has(hash))));
+  }
+
+  /**
+   * Case-insensitive substring search over `files` (path -> content hash),
+   * one result per matching file, yielded as each file is verified so
+   * callers can stream them.
+   */
+  *search(query: string, files: Map<string, string>): Generator<SourceSearchResult> {
+    const needle = query.toLowerCase();
+    if (!needle) return;
+    const candidates = this.candidates(needle, new Set(files.values()));
+    const hitsByHash = new Map<string, SourceSearchHit[]>();
+    for (const [file, hash] of Array.from(files)) {
+      if (!candidates.has(hash)) continue;
+      let hits = hitsByHash.get(hash);
+      if (!hits) {
+        hits = [];
+        const source = this.byHash.get(hash);
+        for (let i = 0; source && i < source.lowerLines.length && hits.length < MAX_HITS_PER_FILE; i++) {
+          if (source.lowerLines[i].includes(needle)) {
+            hits.push({ line: i + 1, text: source.lines[i].trim().substring(0, MAX_LINE_LENGTH) });
+          }
+        }
+        hitsByHash.set(hash, hits);
+      }
+      if (hits.length > 0) yield { file, hits };
+    }
+  }
+}
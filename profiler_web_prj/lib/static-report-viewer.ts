@@ -0,0 +1,234 @@
+/**
+ * Styles and script embedded in the static HTML report (lib/static-report.ts).
+ * Plain browser JavaScript with no dependencies; it must not use template
+ * literals since it is itself kept in one.
+ */
+
+export const REPORT_STYLES = `
+body { margin: 0; font-family: system-ui, -apple-system, sans-serif; background: #f9fafb; color: #1f2937; }
+#app { max-width: 1200px; margin: 0 auto; padding: 32px 24px; }
+h1 { font-size: 28px; margin: 0 0 4px; }
+h2 { font-size: 18px; margin: 0 0 12px; }
+.subtitle { color: #6b7280; margin-bottom: 24px; }
+.card { background: #fff; border: 1px solid #e5e7eb; border-radius: 12px; padding: 20px; margin-bottom: 24px; }
+.grid { display: grid; grid-template-columns: repeat(auto-fill, minmax(180px, 1fr)); gap: 12px; }
+.stat { background: #f9fafb; border-radius: 8px; padding: 12px; }
+.stat .label { font-size: 12px; color: #6b7280; }
+.stat .value { font-size: 20px; font-weight: 700; }
+table { width: 100%; border-collapse: collapse; font-size: 13px; }
+th { text-align: left; font-weight: 500; color: #374151; border-bottom: 1px solid #e5e7eb; padding: 6px 8px; position: sticky; top: 0; background: #fff; }
+td { border-bottom: 1px solid #f3f4f6; padding: 4px 8px; }
+td.num, th.num { text-align: right; white-space: nowrap; }
+.mono { font-family: ui-monospace, Menlo, monospace; }
+.link { color: #1d4ed8; cursor: pointer; }
+.link:hover { text-decoration: underline; }
+.muted { color: #9ca3af; }
+.scroll { max-height: 480px; overflow-y: auto; }
+.icicle { position: relative; overflow: hidden; font-size: 11px; }
+.icicle div { position: absolute; height: 17px; line-height: 17px; overflow: hidden; white-space: nowrap; text-overflow: ellipsis; padding: 0 3px; box-sizing: border-box; border: 1px solid #fff; cursor: pointer; }
+details { margin-left: 16px; font-size: 13px; }
+summary { cursor: pointer; padding: 1px 0; }
+.source td { padding: 0 8px; white-space: pre; }
+.source tr.focus { outline: 2px solid #2563eb; }
+select { font-size: 13px; padding: 2px 4px; }
+`;
+
+export const REPORT_VIEWER_SCRIPT = `
+(function () {
+  var meta = JSON.parse(document.getElementById('report-meta').textContent);
+  var E = meta.events.length;
+  var app = document.getElementById('app');
+
+  function esc(text) {
+    return String(text).replace(/&/g, '&amp;').replace(/</g, '&lt;').replace(/>/g, '&gt;').replace(/"/g, '&quot;');
+  }
+  function fmt(n) { return Math.round(n).toLocaleString(); }
+  function pct(n) { return meta.total > 0 ? (100 * n / meta.total).toFixed(2) + '%' : ''; }
+  function baseName(file) { return file.split('/').pop() || file; }
+
+  // Blocks are gzipped and base64-encoded; decoded on first use
+  function decode(id) {
+    var binary = atob(document.getElementById(id).textContent.trim());
+    var bytes = new Uint8Array(binary.length);
+    for (var i = 0; i < binary.length; i++) bytes[i] = binary.charCodeAt(i);
+    var stream = new Blob([bytes]).stream().pipeThrough(new DecompressionStream('gzip'));
+    return new Response(stream).arrayBuffer();
+  }
+
+  function section(title, id) {
+    var card = document.createElement('div');
+    card.className = 'card';
+    if (id) card.id = id;
+    card.innerHTML = '<h2>' + esc(title) + '</h2>';
+    app.appendChild(card);
+    return card;
+  }
+
+  var header = document.createElement('div');
+  header.innerHTML = '<h1>' + esc(meta.projectName) + '</h1><div class="subtitle">Cost event ' +
+    esc(meta.events[meta.eventIndex]) + ' &middot; generated ' + esc(new Date(meta.generatedAt).toLocaleString()) + '</div>';
+  app.appendChild(header);
+
+  // Overview
+  var overview = section('Overview');
+  var stats = '<div class="grid">';
+  Object.keys(meta.summary).forEach(function (event) {
+    stats += '<div class="stat"><div class="label">' + esc(event) + '</div><div class="value">' + fmt(meta.summary[event]) + '</div></div>';
+  });
+  stats += '<div class="stat"><div class="label">Files</div><div class="value">' + fmt(meta.filesAnalyzed) + '</div></div>';
+  stats += '<div class="stat"><div class="label">Line coverage</div><div class="value">' + meta.coverage.percentage.toFixed(1) + '%</div></div>';
+  overview.insertAdjacentHTML('beforeend', stats + '</div>');
+
+  // Annotated files, decoded when opened
+  var fileIndex = {};
+  meta.files.forEach(function (f, i) { fileIndex[f.file] = i; });
+  var fileCard;
+  var fileView = document.createElement('div');
+
+  function showFile(i, focusLine) {
+    var info = meta.files[i];
+    fileView.innerHTML = '<p class="muted">Decoding ' + esc(info.file) + '...</p>';
+    fileCard.scrollIntoView();
+    decode('report-file-' + i).then(function (buffer) {
+      var costs = new Float64Array(buffer, 0, info.lineCount * E);
+      var text = new TextDecoder().decode(new Uint8Array(buffer, info.lineCount * E * 8)).split('\\n');
+      var ev = meta.eventIndex;
+      var max = 0;
+      for (var l = 0; l < info.lineCount; l++) max = Math.max(max, costs[l * E + ev]);
+      var head = '<tr><th class="num">Line</th>';
+      meta.events.forEach(function (event) { head += '<th class="num">' + esc(event) + '</th>'; });
+      var rows = [];
+      for (var line = 0; line < info.lineCount; line++) {
+        var cost = costs[line * E + ev];
+        if (!info.hasSource && cost === 0) continue;
+        var heat = max > 0 && cost > 0 ? 'background:hsl(0,85%,' + (97 - 30 * cost / max).toFixed(0) + '%)' : '';
+        var row = '<tr id="report-line-' + (line + 1) + '" style="' + heat + '"><td class="num muted">' + (line + 1) + '</td>';
+        for (var e = 0; e < E; e++) {
+          var value = costs[line * E + e];
+          row += '<td class="num">' + (value ? fmt(value) : '') + '</td>';
+        }
+        rows.push(row + '<td class="mono">' + esc(text[line] || '') + '</td></tr>');
+      }
+      fileView.innerHTML = '<div class="mono" style="margin-bottom:8px">' + esc(info.file) + ' &middot; ' + fmt(info.cost) + ' (' + pct(info.cost) + ')</div>' +
+        '<div class="scroll"><table class="source">' + head + '<th>Source</th></tr>' + rows.join('') + '</table></div>';
+      var target = focusLine && document.getElementById('report-line-' + focusLine);
+      if (target) {
+        target.className = 'focus';
+        target.scrollIntoView({ block: 'center' });
+      }
+    }, function (error) {
+      fileView.innerHTML = '<p>Failed to decode: ' + esc(error) + '</p>';
+    });
+  }
+
+  function functionLink(fnIndex, line) {
+    var fn = meta.functions[fnIndex];
+    var name = esc(fn[0]);
+    return fileIndex[fn[1]] !== undefined
+      ? '<span class="link" data-file="' + fileIndex[fn[1]] + '" data-line="' + (line || '') + '">' + name + '</span>'
+      : name;
+  }
+  document.addEventListener('click', function (event) {
+    var target = event.target.closest && event.target.closest('[data-file]');
+    if (target) showFile(Number(target.getAttribute('data-file')), Number(target.getAttribute('data-line')) || null);
+  });
+
+  // Top functions
+  var top = section('Top functions by self cost');
+  var table = '<div class="scroll"><table><tr><th>Function</th><th>File</th><th class="num">Self</th><th class="num">%</th><th class="num">Inclusive</th><th class="num">Calls</th></tr>';
+  meta.topFunctions.forEach(function (entry) {
+    var fn = meta.functions[entry.function];
+    table += '<tr><td class="mono">' + functionLink(entry.function, entry.line) + '</td><td class="mono muted" title="' + esc(fn[1]) + '">' +
+      esc(baseName(fn[1])) + '</td><td class="num">' + fmt(entry.self) + '</td><td class="num">' + pct(entry.self) +
+      '</td><td class="num">' + fmt(entry.inclusive) + '</td><td class="num">' + (entry.calls ? fmt(entry.calls) : '') + '</td></tr>';
+  });
+  top.insertAdjacentHTML('beforeend', table + '</table></div>');
+
+  var icicleCard = section('Icicle chart (inclusive cost, click to zoom)');
+  var treeCard = section('Call tree');
+
+  fileCard = section('Hot files');
+  var list = '<table><tr><th>File</th><th class="num">Cost</th><th class="num">%</th></tr>';
+  meta.files.forEach(function (f, i) {
+    list += '<tr><td class="mono"><span class="link" data-file="' + i + '">' + esc(f.file) + '</span>' +
+      (f.hasSource ? '' : ' <span class="muted">(no source)</span>') + '</td><td class="num">' + fmt(f.cost) + '</td><td class="num">' + pct(f.cost) + '</td></tr>';
+  });
+  fileCard.insertAdjacentHTML('beforeend', list + '</table>');
+  fileCard.appendChild(fileView);
+
+  decode('report-tree').then(function (buffer) {
+    var n = meta.treeCount;
+    var cost = new Float64Array(buffer, 0, n);
+    var parent = new Int32Array(buffer, n * 8, n);
+    var fn = new Int32Array(buffer, n * 12, n);
+    // Node n is a synthetic root over the real roots
+    var children = [];
+    for (var i = 0; i <= n; i++) children.push([]);
+    for (var j = 0; j < n; j++) children[parent[j] < 0 ? n : parent[j]].push(j);
+    var rootCost = 0;
+    children[n].forEach(function (c) { rootCost += cost[c]; });
+    function nodeCost(i) { return i === n ? rootCost : cost[i]; }
+    function nodeName(i) { return i === n ? 'all' : meta.functions[fn[i]][0]; }
+    var parentOf = function (i) { return i === n ? n : (parent[i] < 0 ? n : parent[i]); };
+
+    // Icicle: rows by depth, widths proportional to inclusive cost of the zoomed node
+    var icicle = document.createElement('div');
+    icicle.className = 'icicle';
+    icicleCard.appendChild(icicle);
+    var ROW = 18, MAX_DEPTH = 40;
+    function drawIcicle(zoom) {
+      var width = icicle.clientWidth || 1000;
+      var total = nodeCost(zoom) || 1;
+      var html = [];
+      var depth = 0;
+      function place(i, x, d, limit) {
+        // Never wider than what is left of the parent
+        var w = Math.min(width * nodeCost(i) / total, limit);
+        if (w < 2 || d >= MAX_DEPTH) return;
+        depth = Math.max(depth, d + 1);
+        var hue = (fn[i] * 47) % 60;
+        html.push('<div data-node="' + i + '" title="' + esc(nodeName(i)) + ' ' + fmt(nodeCost(i)) + ' (' + pct(nodeCost(i)) + ')" style="left:' +
+          x.toFixed(1) + 'px;top:' + (d * ROW) + 'px;width:' + w.toFixed(1) + 'px;background:hsl(' + (i === n ? 220 : hue) + ',80%,' + (i === zoom ? 70 : 80) + '%)">' +
+          esc(nodeName(i)) + '</div>');
+        var cx = x;
+        children[i].forEach(function (c) {
+          var cw = Math.min(width * nodeCost(c) / total, x + w - cx);
+          place(c, cx, d + 1, cw);
+          cx += cw;
+        });
+      }
+      place(zoom, 0, 0, width);
+      icicle.style.height = (depth * ROW) + 'px';
+      icicle.innerHTML = html.join('');
+      icicle.onclick = function (event) {
+        var node = event.target.getAttribute('data-node');
+        if (node === null) return;
+        node = Number(node);
+        drawIcicle(node === zoom ? parentOf(zoom) : node);
+      };
+    }
+    drawIcicle(n);
+
+    // Call tree: children are built when a node is first expanded
+    function treeNode(i) {
+      var details = document.createElement('details');
+      var summary = document.createElement('summary');
+      summary.innerHTML = '<span class="mono">' + (i === n ? 'all' : functionLink(fn[i])) + '</span> <span class="muted">' +
+        fmt(nodeCost(i)) + ' (' + pct(nodeCost(i)) + ')</span>';
+      details.appendChild(summary);
+      if (children[i].length === 0) summary.style.listStyle = 'none';
+      details.addEventListener('toggle', function () {
+        if (!details.open || details.childNodes.length > 1) return;
+        children[i].forEach(function (c) { details.appendChild(treeNode(c)); });
+      });
+      return details;
+    }
+    var rootNode = treeNode(n);
+    rootNode.open = true;
+    rootNode.style.marginLeft = '0';
+    treeCard.appendChild(rootNode);
+  }, function (error) {
+    icicleCard.insertAdjacentHTML('beforeend', '<p>This browser cannot decode the report data: ' + esc(error) + '</p>');
+  });
+})();
+`;
@@ -0,0 +1,232 @@
+import { CachegrindData } from '@/types/profiler';
+import { buildCallGraph, CallGraphNode } from './call-graph';
+import { REPORT_STYLES, REPORT_VIEWER_SCRIPT } from './static-report-viewer';
+
+/**
+ * Self-contained HTML report of a profile: overview, top functions, call
+ * tree and icicle chart, and annotated sources of the hottest files. Bulk
+ * data is embedded as gzipped, base64-encoded binary blocks in inert
+ * <script> tags, and each file's block is only decoded when it is opened,
+ * so the report opens straight from disk with no server.
+ *
+ * Binary layouts (all little-endian typed arrays):
+ *   tree:    Float64 cost[n], Int32 parent[n], Int32 function[n]
+ *   file i:  Float64 cost[lineCount * events] (row per line), then UTF-8 source
+ */
+
+export interface StaticReportOptions {
+  costEvent?: string;
+  topFunctions?: number;
+  hotFiles?: number;
+  minTreeFraction?: number; // call tree paths below this share of the total are dropped
+  maxTreeNodes?: number;
+}
+
+const MISSING_SOURCE = 'Source code not available';
+
+const gzip = async (bytes: Uint8Array): Promise<Uint8Array> => {
+  const stream = new Blob([bytes]).stream().pipeThrough(new CompressionStream('gzip'));
+  return new Uint8Array(await new Response(stream).arrayBuffer());
+};
+
+const toBase64 = (bytes: Uint8Array): string => {
+  let binary = '';
+  for (let i = 0; i < bytes.length; i += 0x8000) {
+    binary += String.fromCharCode(...Array.from(bytes.subarray(i, i + 0x8000)));
+  }
+  return btoa(binary);
+};
+
+const concatBytes = (parts: ArrayBufferView[]): Uint8Array => {
+  const result = new Uint8Array(parts.reduce((sum, part) => sum + part.byteLength, 0));
+  let offset = 0;
+  parts.forEach(part => {
+    result.set(new Uint8Array(part.buffer, part.byteOffset, part.byteLength), offset);
+    offset += part.byteLength;
+  });
+  return result;
+};
+
+const escapeHtml = (text: string) => text
+  .replace(/&/g, '&amp;')
+  .replace(/</g, '&lt;')
+  .replace(/>/g, '&gt;')
+  .replace(/"/g, '&quot;');
+
+// JSON inside a <script> block must not contain "</script>" or "<!--"
+const scriptJson = (value: unknown) => JSON.stringify(value).replace(/</g, '\\u003c');
+
+const dataBlock = async (id: string, bytes: Uint8Array) =>
+  `<script type="application/octet-stream" id="${id}">${toBase64(await gzip(bytes))}</script>`;
+
+/**
+ * Expand the call graph from its roots into a tree, breadth first, so the
+ * node limit trims the deepest levels. A function already on the current
+ * path is not expanded again. Costs are apportioned along each path, so a
+ * node's children never cost more than the node itself.
+ */
+function buildReportTree(
+  roots: CallGraphNode[],
+  event: string,
+  minCost: number,
+  maxNodes: number,
+  functionIndex: (node: CallGraphNode) => number
+) {
+  const cost: number[] = [];
+  const parent: number[] = [];
+  const fn: number[] = [];
+  const nodes: CallGraphNode[] = [];
+  const paths: Set<string>[] = [];
+  const add = (node: CallGraphNode, nodeCost: number, parentIndex: number) => {
+    const path = new Set(parentIndex >= 0 ? paths[parentIndex] : []);
+    path.add(node.key);
+    cost.push(nodeCost);
+    parent.push(parentIndex);
+    fn.push(functionIndex(node));
+    nodes.push(node);
+    paths.push(path);
+  };
+
+  roots
+    .filter(root => (root.inclusive[event] || 0) >= minCost)
+    .sort((a, b) => (b.inclusive[event] || 0) - (a.inclusive[event] || 0))
+    .forEach(root => { if (cost.length < maxNodes) add(root, root.inclusive[event] || 0, -1); });
+
+  for (let i = 0; i < nodes.length && cost.length < maxNodes; i++) {
+    // A function's edges are totals over every path that reaches it, so they
+    // are scaled to the share of its cost that arrived along this path
+    const inclusive = nodes[i].inclusive[event] || 0;
+    let scale = inclusive > 0 ? Math.min(1, cost[i] / inclusive) : 0;
+    const edges = nodes[i].callees
+      .filter(edge => !paths[i].has(edge.callee.key))
+      .map(edge => ({ edge, edgeCost: (edge.inclusive[event] || 0) * scale }));
+    // Children never add up to more than their parent, even where callgrind's
+    // edge costs overlap (recursion that was not folded)
+    const childTotal = edges.reduce((sum, child) => sum + child.edgeCost, 0);
+    if (childTotal > cost[i]) {
+      scale = cost[i] / childTotal;
+      edges.forEach(child => { child.edgeCost *= scale; });
+    }
+    const kept = edges
+      .filter(child => child.edgeCost >= minCost)
+      .sort((a, b) => b.edgeCost - a.edgeCost);
+    for (const { edge, edgeCost } of kept) {
+      if (cost.length >= maxNodes) break;
+      add(edge.callee, edgeCost, i);
+    }
+    paths[i] = new Set(); // only needed while children are added
+  }
+
+  return concatBytes([Float64Array.from(cost), Int32Array.from(parent), Int32Array.from(fn)]);
+}
+
+/**
+ * Build the report. `graphData` is the profile after frame collapsing,
+ * recursion folding and pruning, and is used for the functions and call
+ * tree; line costs and sources come from `data`.
+ */
+export async function buildStaticReport(
+  data: CachegrindData,
+  graphData: CachegrindData,
+  options: StaticReportOptions = {}
+): Promise<string> {
+  const events = data.events;
+  const event = options.costEvent && events.includes(options.costEvent)
+    ? options.costEvent
+    : (events.includes('Cy') ? 'Cy' : (events.includes('Ir') ? 'Ir' : events[0]));
+  const total = data.summaryTotals[event] || 0;
+
+  const graph = buildCallGraph(graphData);
+  const functions: [string, string][] = [];
+  const functionIds = new Map<string, number>();
+  const functionIndex = (node: CallGraphNode) => {
+    let id = functionIds.get(node.key);
+    if (id === undefined) {
+      id = functions.length;
+      functions.push([node.functionName, node.file]);
+      functionIds.set(node.key, id);
+    }
+    return id;
+  };
+
+  const topFunctions = Array.from(graph.nodes.values())
+    .filter(node => (node.self[event] || 0) > 0)
+    .sort((a, b) => (b.self[event] || 0) - (a.self[event] || 0))
+    .slice(0, options.topFunctions ?? 100)
+    .map(node => ({
+      function: functionIndex(node),
+      self: node.self[event] || 0,
+      inclusive: node.inclusive[event] || 0,
+      calls: node.callers.reduce((sum, edge) => sum + edge.count, 0),
+      line: node.data?.startLine
+    }));
+
+  const tree = buildReportTree(
+    graph.roots,
+    event,
+    total * (options.minTreeFraction ?? 0.001),
+    options.maxTreeNodes ?? 20000,
+    functionIndex
+  );
+
+  const hotFiles = Object.entries(data.fileCoverage)
+    .map(([file, coverage]) => ({
+      file,
+      coverage,
+      cost: Object.values(coverage.functions).reduce((sum, fn) => sum + (fn.totals[event] || 0), 0)
+    }))
+    .filter(entry => entry.cost > 0)
+    .sort((a, b) => b.cost - a.cost)
+    .slice(0, options.hotFiles ?? 30);
+
+  const fileMeta: { file: string; cost: number; lineCount: number; hasSource: boolean }[] = [];
+  const fileBlocks: string[] = [];
+  for (const [i, { file, coverage, cost }] of Array.from(hotFiles.entries())) {
+    const source = coverage.sourceCode !== MISSING_SOURCE ? coverage.sourceCode : '';
+    let lineCount = source ? source.split('\n').length : 0;
+    Object.values(coverage.functions).forEach(fn => {
+      Object.keys(fn.lines || {}).forEach(line => { lineCount = Math.max(lineCount, Number(line)); });
+    });
+    const costs = new Float64Array(lineCount * events.length);
+    Object.values(coverage.functions).forEach(fn => {
+      Object.entries(fn.lines || {}).forEach(([lineKey, lineData]) => {
+        const row = (Number(lineKey) - 1) * events.length;
+        if (row < 0) return;
+        events.forEach((e, j) => {
+          const value = lineData[e];
+          if (typeof value === 'number') costs[row + j] += value;
+        });
+      });
+    });
+    fileMeta.push({ file, cost, lineCount, hasSource: !!source });
+    fileBlocks.push(await dataBlock(`report-file-${i}`, concatBytes([costs, new TextEncoder().encode(source)])));
+  }
+
+  const meta = {
+    projectName: data.projectName,
+    generatedAt: new Date().toISOString(),
+    events,
+    eventIndex: events.indexOf(event),
+    total,
+    summary: data.summaryTotals,
+    coverage: { covered: data.coveredLines, total: data.totalLines, percentage: data.coveragePercentage },
+    filesAnalyzed: data.filesAnalyzed,
+    functions,
+    topFunctions,
+    treeCount: tree.byteLength / 16,
+    files: fileMeta
+  };
+
+  return [
+    '<!DOCTYPE html>',
+    '<html lang="en"><head><meta charset="utf-8">',
+    `<title>${escapeHtml(data.projectName)} - Profile Report</title>`,
+    `<style>${REPORT_STYLES}</style>`,
+    '</head><body><div id="app"></div>',
+    `<script type="application/json" id="report-meta">${scriptJson(meta)}</script>`,
+    await dataBlock('report-tree', tree),
+    ...fileBlocks,
+    `<script>${REPORT_VIEWER_SCRIPT}</script>`,
+    '</body></html>'
+  ].join('\n');
+}
@@ -0,0 +1,148 @@
+import { CachegrindData } from '@/types/profiler';
+import {
+  CallGraph,
+  CallGraphNode,
+  buildCallGraph,
+  createApplicationCharger,
+  findApplicationObjects,
+  heaviestCallerPath,
+  isApplicationNode
+} from './call-graph';
+
+export const SYS_COUNT_EVENT = 'sysCount';
+export const SYS_TIME_EVENT = 'sysTime';
+
+export interface SyscallSite {
+  caller: CallGraphNode; // nearest application frame
+  entry: CallGraphNode | null; // first library function called, null for syscalls made directly by the caller
+  path: CallGraphNode[]; // application call path ending at the caller
+  calls: number;
+  sysCount: number;
+  sysTime: number;
+  timePerSyscall: number;
+}
+
+export interface SyscallFunctionCost {
+  node: CallGraphNode;
+  isApplication: boolean;
+  sysCount: number;
+  sysTime: number;
+  selfSysCount: number;
+  selfSysTime: number;
+  timePerSyscall: number;
+}
+
+export interface SyscallAnalysis {
+  totalSysCount: number;
+  totalSysTime: number;
+  timeUnit: string;
+  sites: SyscallSite[];
+  functions: SyscallFunctionCost[];
+  unattributedSysCount: number; // cost in library code with no application caller (e.g. loader startup)
+  unattributedSysTime: number;
+}
+
+export function hasSyscallEvents(data: CachegrindData): boolean {
+  return data.events.includes(SYS_COUNT_EVENT) || data.events.includes(SYS_TIME_EVENT);
+}
+
+/**
+ * Analyze --collect-systime events. Syscall cost reached from library code
+ * (libc wrappers and the like) is charged to the nearest application caller:
+ * each library function's own syscalls climb its caller edges until they
+ * cross into application code, so syscalls made under a callback are
+ * charged to the callback and not again to the code that called the
+ * library.
+ */
+export function analyzeSyscalls(data: CachegrindData, graph: CallGraph = buildCallGraph(data)): SyscallAnalysis {
+  const applicationObjects = findApplicationObjects(graph);
+  const isApp = (node: CallGraphNode) => isApplicationNode(node, applicationObjects);
+  const rankEvent = data.events.includes(SYS_TIME_EVENT) ? SYS_TIME_EVENT : SYS_COUNT_EVENT;
+
+  const totalSysCount = data.summaryTotals[SYS_COUNT_EVENT] || 0;
+  const totalSysTime = data.summaryTotals[SYS_TIME_EVENT] || 0;
+
+  const sites: SyscallSite[] = [];
+  let attributedCount = 0;
+  let attributedTime = 0;
+
+  const addSite = (caller: CallGraphNode, entry: CallGraphNode | null, calls: number, sysCount: number, sysTime: number) => {
+    if (sysCount === 0 && sysTime === 0) return;
+    attributedCount += sysCount;
+    attributedTime += sysTime;
+    sites.push({
+      caller,
+      entry,
+      path: [],
+      calls,
+      sysCount,
+      sysTime,
+      timePerSyscall: sysCount > 0 ? sysTime / sysCount : 0
+    });
+  };
+
+  // Syscalls issued directly from application code (inline asm, static binaries)
+  const held = new Map<CallGraphNode, number[]>();
+  graph.nodes.forEach(node => {
+    const sysCount = node.self[SYS_COUNT_EVENT] || 0;
+    const sysTime = node.self[SYS_TIME_EVENT] || 0;
+    if (isApp(node)) addSite(node, null, 0, sysCount, sysTime);
+    else if (sysCount !== 0 || sysTime !== 0) held.set(node, [sysCount, sysTime]);
+  });
+
+  // Repeated call sites into the same wrapper become one entry
+  const byCallee = new Map<string, { caller: CallGraphNode; callee: CallGraphNode; sysCount: number; sysTime: number }>();
+  createApplicationCharger(graph, isApp)(held, [SYS_COUNT_EVENT, SYS_TIME_EVENT], (edge, [sysCount, sysTime]) => {
+    const key = `${edge.caller.key}\0${edge.callee.key}`;
+    const entry = byCallee.get(key);
+    if (entry) {
+      entry.sysCount += sysCount;
+      entry.sysTime += sysTime;
+    } else {
+      byCallee.set(key, { caller: edge.caller, callee: edge.callee, sysCount, sysTime });
+    }
+  });
+  byCallee.forEach(({ caller, callee, sysCount, sysTime }) => {
+    const calls = caller.callees.reduce((sum, edge) => edge.callee === callee ? sum + edge.count : sum, 0);
+    addSite(caller, callee, calls, sysCount, sysTime);
+  });
+
+  const byTime = rankEvent === SYS_TIME_EVENT;
+  sites.sort((a, b) => (byTime ? b.sysTime - a.sysTime : 0) || (b.sysCount - a.sysCount));
+
+  // Call paths are only resolved for the sites that will be shown
+  sites.slice(0, 100).forEach(site => {
+    site.path = heaviestCallerPath(site.caller, rankEvent, 12, isApp);
+  });
+
+  const functions: SyscallFunctionCost[] = [];
+  graph.nodes.forEach(node => {
+    const sysCount = node.inclusive[SYS_COUNT_EVENT] || 0;
+    const sysTime = node.inclusive[SYS_TIME_EVENT] || 0;
+    if (sysCount === 0 && sysTime === 0) return;
+    functions.push({
+      node,
+      isApplication: isApp(node),
+      sysCount,
+      sysTime,
+      selfSysCount: node.self[SYS_COUNT_EVENT] || 0,
+      selfSysTime: node.self[SYS_TIME_EVENT] || 0,
+      timePerSyscall: sysCount > 0 ? sysTime / sysCount : 0
+    });
+  });
+  functions.sort((a, b) => (byTime ? b.sysTime - a.sysTime : 0) || (b.sysCount - a.sysCount));
+
+  const description = data.eventDescriptions?.[SYS_TIME_EVENT] || '';
+  const unitMatch = description.match(/\(([^)]*)\)/);
+  const timeUnit = unitMatch ? unitMatch[1].replace(/^elapsed\s+/, '') : '';
+
+  return {
+    totalSysCount,
+    totalSysTime,
+    timeUnit,
+    sites,
+    functions,
+    unattributedSysCount: totalSysCount - attributedCount,
+    unattributedSysTime: totalSysTime - attributedTime
+  };
+}
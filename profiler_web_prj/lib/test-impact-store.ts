@@ -0,0 +1,53 @@
+import fs from 'fs/promises';
+import { TestImpactIndex } from './test-impact';
+import { findProfileFiles, mapWithConcurrency, resolveOutputPath, toProjectRelative } from './output-paths';
+
+// Server-side, process-wide test impact indexes, one per output/ directory
+
+interface IndexState {
+  index: TestImpactIndex;
+  versions: Map<string, string>; // run path -> "mtime:size" when ingested
+}
+
+const indexes = new Map<string, IndexState>();
+
+/**
+ * Return the index for a directory under output/, ingesting dumps that are
+ * new or changed since the last call and retiring ones that were deleted.
+ */
+export async function getTestImpactIndex(directory: string = 'output'): Promise<TestImpactIndex> {
+  const resolvedPath = resolveOutputPath(directory);
+  if (!resolvedPath) {
+    throw new Error('Access denied: Path is outside output directory');
+  }
+
+  let state = indexes.get(resolvedPath);
+  if (!state) {
+    state = { index: new TestImpactIndex(), versions: new Map() };
+    indexes.set(resolvedPath, state);
+  }
+  const { index, versions } = state;
+
+  const files = await findProfileFiles(resolvedPath);
+  const present = new Set(files.map(toProjectRelative));
+  Array.from(versions.keys()).forEach(run => {
+    if (!present.has(run)) {
+      index.removeRun(run);
+      versions.delete(run);
+    }
+  });
+
+  const stats = await mapWithConcurrency(files, 16, async file => ({ file, stats: await fs.stat(file) }));
+  const changed = stats.filter(({ file, stats }) =>
+    versions.get(toProjectRelative(file)) !== `${stats.mtimeMs}:${stats.size}`);
+
+  // Read in parallel, ingest in order so run ids stay stable for a given tree
+  const contents = await mapWithConcurrency(changed, 8, ({ file }) => fs.readFile(file, 'utf-8'));
+  changed.forEach(({ file, stats }, i) => {
+    const run = toProjectRelative(file);
+    index.addRun(run, contents[i]);
+    versions.set(run, `${stats.mtimeMs}:${stats.size}`);
+  });
+
+  return index;
+}
@@ -0,0 +1,311 @@
+import { scanProfile } from './profile-scanner';
+
+/**
+ * Inverted index from functions and source lines to the test runs that
+ * executed them, with each run's cost. Runs are added one dump at a time;
+ * re-ingesting a run retires its previous entries instead of rebuilding.
+ * Once retired runs make up COMPACT_RETIRED_SHARE of all run ids, their
+ * postings are dropped and the remaining runs renumbered, so an index that
+ * sees the same dumps rewritten on every CI pipeline stays bounded.
+ */
+
+export interface RunCost {
+  run: string;
+  cost: number; // inclusive cost for functions, self cost for lines
+  calls?: number; // times the function was called in this run
+}
+
+export interface ImpactTarget {
+  file?: string; // path or path suffix, e.g. "src/io.c"
+  functionName?: string;
+  line?: number;
+}
+
+export interface ImpactSelection {
+  runs: string[]; // minimal set of runs covering every reachable target
+  covered: ImpactTarget[];
+  uncovered: ImpactTarget[]; // targets no run executes
+}
+
+interface Postings {
+  runs: number[];
+  costs: number[];
+  calls?: number[];
+}
+
+const COMPACT_RETIRED_SHARE = 0.25;
+
+const addPosting = (postings: Postings, run: number, cost: number, calls?: number) => {
+  const last = postings.runs.length - 1;
+  // Runs are ingested one at a time, so repeated hits from the same run are adjacent
+  if (last >= 0 && postings.runs[last] === run) {
+    postings.costs[last] += cost;
+    if (postings.calls && calls !== undefined) postings.calls[last] += calls;
+    return;
+  }
+  postings.runs.push(run);
+  postings.costs.push(cost);
+  if (postings.calls) postings.calls.push(calls || 0);
+};
+
+export class TestImpactIndex {
+  private runNames: string[] = [];
+  private liveRuns = new Map<string, number>(); // run name -> current run id
+  private retired = new Set<number>();
+  private functions = new Map<string, Postings>(); // `${file}:${function}` -> postings
+  private functionsByName = new Map<string, Set<string>>(); // function name -> keys
+  private lines = new Map<string, Map<number, Postings>>(); // file -> line -> postings
+  private filesByBasename = new Map<string, Set<string>>();
+  costEvent = '';
+
+  get runCount(): number {
+    return this.liveRuns.size;
+  }
+
+  hasRun(run: string): boolean {
+    return this.liveRuns.has(run);
+  }
+
+  removeRun(run: string) {
+    const id = this.liveRuns.get(run);
+    if (id === undefined) return;
+    this.retired.add(id);
+    this.liveRuns.delete(run);
+    if (this.retired.size >= this.runNames.length * COMPACT_RETIRED_SHARE) this.compact();
+  }
+
+  // Drop retired runs' postings and renumber the live runs in ingestion order
+  private compact() {
+    const renumbered = new Int32Array(this.runNames.length).fill(-1);
+    const runNames: string[] = [];
+    this.runNames.forEach((name, id) => {
+      if (this.retired.has(id)) return;
+      renumbered[id] = runNames.length;
+      runNames.push(name);
+    });
+    this.runNames = runNames;
+    this.liveRuns = new Map(runNames.map((name, id) => [name, id]));
+    this.retired.clear();
+
+    // Postings keep their order, so hits from one run stay adjacent
+    const prune = (postings: Postings): boolean => {
+      let kept = 0;
+      postings.runs.forEach((run, i) => {
+        if (renumbered[run] < 0) return;
+        postings.runs[kept] = renumbered[run];
+        postings.costs[kept] = postings.costs[i];
+        if (postings.calls) postings.calls[kept] = postings.calls[i];
+        kept++;
+      });
+      postings.runs.length = kept;
+      postings.costs.length = kept;
+      if (postings.calls) postings.calls.length = kept;
+      return kept > 0;
+    };
+
+    this.functions.forEach((postings, key) => {
+      if (!prune(postings)) this.functions.delete(key);
+    });
+    this.functionsByName.forEach((keys, name) => {
+      keys.forEach(key => { if (!this.functions.has(key)) keys.delete(key); });
+      if (keys.size === 0) this.functionsByName.delete(name);
+    });
+    this.lines.forEach((fileLines, file) => {
+      fileLines.forEach((postings, line) => {
+        if (!prune(postings)) fileLines.delete(line);
+      });
+      if (fileLines.size > 0) return;
+      this.lines.delete(file);
+      const base = file.split('/').pop() || file;
+      const files = this.filesByBasename.get(base);
+      if (files?.delete(file) && files.size === 0) this.filesByBasename.delete(base);
+    });
+  }
+
+  /**
+   * Add one dump to the index. Function cost is inclusive (self plus
+   * non-recursive calls), line cost is self cost, both in the Cy event if
+   * present and Ir otherwise.
+   */
+  addRun(run: string, content: string) {
+    this.removeRun(run);
+    const id = this.runNames.length;
+    this.runNames.push(run);
+    this.liveRuns.set(run, id);
+
+    let costIndex = 0;
+    const functionCosts = new Map<string, { file: string; name: string; cost: number }>();
+    const callCounts = new Map<string, number>();
+    const functionEntry = (file: string, name: string) => {
+      const key = `${file}:${name}`;
+      let entry = functionCosts.get(key);
+      if (!entry) {
+        entry = { file, name, cost: 0 };
+        functionCosts.set(key, entry);
+      }
+      return entry;
+    };
+
+    scanProfile(content, {
+      onHeader: (events) => {
+        const event = events.includes('Cy') ? 'Cy' : (events.includes('Ir') ? 'Ir' : events[0]);
+        costIndex = Math.max(0, events.indexOf(event));
+        if (!this.costEvent) this.costEvent = event;
+      },
+      onCost: (file, functionName, line, costs, functionFile) => {
+        const cost = costs[costIndex] || 0;
+        if (file && file !== '???' && line > 0) {
+          let fileLines = this.lines.get(file);
+          if (!fileLines) {
+            fileLines = new Map();
+            this.lines.set(file, fileLines);
+            const base = file.split('/').pop() || file;
+            if (!this.filesByBasename.has(base)) this.filesByBasename.set(base, new Set());
+            this.filesByBasename.get(base)!.add(file);
+          }
+          let postings = fileLines.get(line);
+          if (!postings) {
+            postings = { runs: [], costs: [] };
+            fileLines.set(line, postings);
+          }
+          addPosting(postings, id, cost);
+        }
+        functionEntry(functionFile, functionName).cost += cost;
+      },
+      onCall: (_file, functionName, _line, targetFile, targetFunction, count, inclusive, functionFile) => {
+        const targetKey = `${targetFile}:${targetFunction}`;
+        callCounts.set(targetKey, (callCounts.get(targetKey) || 0) + count);
+        if (targetFunction === functionName) return;
+        functionEntry(functionFile, functionName).cost += inclusive[costIndex] || 0;
+      }
+    });
+
+    functionCosts.forEach(({ file, name, cost }, key) => {
+      let postings = this.functions.get(key);
+      if (!postings) {
+        postings = { runs: [], costs: [], calls: [] };
+        this.functions.set(key, postings);
+        if (!this.functionsByName.has(name)) this.functionsByName.set(name, new Set());
+        this.functionsByName.get(name)!.add(key);
+      }
+      addPosting(postings, id, cost, callCounts.get(key) || 0);
+    });
+  }
+
+  private matchFiles(file: string): string[] {
+    if (this.lines.has(file)) return [file];
+    const base = file.split('/').pop() || file;
+    const candidates = this.filesByBasename.get(base);
+    if (!candidates) return [];
+    const suffix = file.startsWith('/') ? file : `/${file}`;
+    return Array.from(candidates).filter(candidate => candidate === file || candidate.endsWith(suffix));
+  }
+
+  private collect(postingsList: Postings[]): RunCost[] {
+    const byRun = new Map<number, RunCost>();
+    postingsList.forEach(postings => {
+      postings.runs.forEach((run, i) => {
+        if (this.retired.has(run)) return;
+        const existing = byRun.get(run);
+        if (existing) {
+          existing.cost += postings.costs[i];
+          if (postings.calls) existing.calls = (existing.calls || 0) + postings.calls[i];
+        } else {
+          byRun.set(run, {
+            run: this.runNames[run],
+            cost: postings.costs[i],
+            calls: postings.calls ? postings.calls[i] : undefined
+          });
+        }
+      });
+    });
+    return Array.from(byRun.values()).sort((a, b) => b.cost - a.cost);
+  }
+
+  /**
+   * Runs that executed a function, heaviest first. Without a file, every
+   * function of that name matches (static functions in different files).
+   */
+  runsForFunction(functionName: string, file?: string): RunCost[] {
+    const keys = this.functionsByName.get(functionName);
+    if (!keys) return [];
+    const files = file ? new Set(this.matchFiles(file)) : null;
+    const postings = Array.from(keys)
+      .filter(key => !files || files.has(key.substring(0, key.length - functionName.length - 1)))
+      .map(key => this.functions.get(key)!);
+    return this.collect(postings);
+  }
+
+  runsForLine(file: string, line: number): RunCost[] {
+    const postings = this.matchFiles(file)
+      .map(match => this.lines.get(match)!.get(line))
+      .filter((p): p is Postings => !!p);
+    return this.collect(postings);
+  }
+
+  runsForTarget(target: ImpactTarget): RunCost[] {
+    if (target.functionName) return this.runsForFunction(target.functionName, target.file);
+    if (target.file && target.line !== undefined) return this.runsForLine(target.file, target.line);
+    return [];
+  }
+
+  /**
+   * Pick a small set of runs that together execute every changed target
+   * (greedy set cover), preferring cheaper runs when coverage ties.
+   */
+  selectRuns(targets: ImpactTarget[]): ImpactSelection {
+    const runTargets = new Map<string, Set<number>>();
+    const runCost = new Map<string, number>();
+    const uncovered: ImpactTarget[] = [];
+
+    targets.forEach((target, index) => {
+      const runs = this.runsForTarget(target);
+      if (runs.length === 0) {
+        uncovered.push(target);
+        return;
+      }
+      runs.forEach(({ run, cost }) => {
+        if (!runTargets.has(run)) runTargets.set(run, new Set());
+        runTargets.get(run)!.add(index);
+        runCost.set(run, (runCost.get(run) || 0) + cost);
+      });
+    });
+
+    const remaining = new Set<number>();
+    runTargets.forEach(indices => indices.forEach(index => remaining.add(index)));
+    const covered = Array.from(remaining).sort((a, b) => a - b).map(index => targets[index]);
+
+    const selected: string[] = [];
+    while (remaining.size > 0) {
+      let best = '';
+      let bestGain = 0;
+      runTargets.forEach((indices, run) => {
+        let gain = 0;
+        indices.forEach(index => { if (remaining.has(index)) gain++; });
+        if (gain > bestGain || (gain === bestGain && gain > 0 && (runCost.get(run) || 0) < (runCost.get(best) || 0))) {
+          best = run;
+          bestGain = gain;
+        }
+      });
+      if (bestGain === 0) break;
+      selected.push(best);
+      runTargets.get(best)!.forEach(index => remaining.delete(index));
+      runTargets.delete(best);
+    }
+
+    return { runs: selected, covered, uncovered };
+  }
+}
+
+/**
+ * Parse a target spec as used in CI: "func", "file:func" or "file:line".
+ * The file part must have an extension so C++ names like "ns::f" stay whole.
+ */
+export function parseImpactTarget(spec: string): ImpactTarget {
+  const trimmed = spec.trim();
+  const match = trimmed.match(/^([^:]*\.[A-Za-z0-9]+):(?!:)(.+)$/);
+  if (!match) return { functionName: trimmed };
+  const [, file, rest] = match;
+  if (/^\d+$/.test(rest)) return { file, line: parseInt(rest, 10) };
+  return { file, functionName: rest };
+}
@@ -0,0 +1,289 @@
+import { CallGraph, CallGraphNode } from './call-graph';
+
+/**
+ * What-if model of speeding up functions. Savings in a function's self
+ * cost are propagated to the inclusive cost of its callers, split over
+ * the call edges into it in proportion to the inclusive cost each edge
+ * carries. Cycles (recursion, mutual recursion) are condensed into one
+ * component first: a component's saving reaches every member, scaled by
+ * the member's share of the component's inclusive cost, and leaves the
+ * component only through edges coming from outside it.
+ *
+ * Savings are linear, so a change to one function only touches its
+ * ancestors: they are visited callees-first and nothing else is recomputed.
+ */
+
+export type WhatIfTarget =
+  | { kind: 'function'; key: string }
+  | { kind: 'object'; objectFile: string };
+
+export interface WhatIfAdjustment {
+  id: number;
+  target: WhatIfTarget;
+  mode: 'factor' | 'reduction'; // divide self cost by value, or subtract value from it
+  value: number;
+}
+
+export interface WhatIfHotspot {
+  node: CallGraphNode;
+  self: number;
+  newSelf: number;
+  newInclusive: number;
+}
+
+interface CallerShare {
+  component: number;
+  share: number;
+}
+
+export class WhatIfModel {
+  readonly nodes: CallGraphNode[];
+  readonly baseTotal: number;
+  private index = new Map<string, number>();
+  private self: Float64Array;
+  private inclusive: Float64Array;
+  private component: Int32Array; // node -> component, numbered callees first
+  private componentInclusive: Float64Array;
+  private callers: CallerShare[][]; // per component
+  private savedSelf: Float64Array;
+  private savedInclusive: Float64Array; // per component
+  private savedTotal = 0;
+
+  constructor(graph: CallGraph, readonly event: string) {
+    this.nodes = Array.from(graph.nodes.values());
+    this.nodes.forEach((node, i) => this.index.set(node.key, i));
+    this.self = Float64Array.from(this.nodes, node => node.self[event] || 0);
+    this.inclusive = Float64Array.from(this.nodes, node => node.inclusive[event] || 0);
+    this.baseTotal = this.self.reduce((sum, value) => sum + value, 0);
+    this.savedSelf = new Float64Array(this.nodes.length);
+
+    this.component = this.stronglyConnectedComponents();
+    const componentCount = this.component.reduce((max, c) => Math.max(max, c + 1), 0);
+    this.componentInclusive = new Float64Array(componentCount);
+    this.savedInclusive = new Float64Array(componentCount);
+    this.nodes.forEach((_, i) => {
+      const c = this.component[i];
+      this.componentInclusive[c] = Math.max(this.componentInclusive[c], this.inclusive[i]);
+    });
+
+    // Each caller component's share of a component's cost is its part of the
+    // inclusive cost entering the component from outside
+    const incoming = new Float64Array(componentCount);
+    const shares: Map<number, number>[] = Array.from({ length: componentCount }, () => new Map());
+    graph.edges.forEach(edge => {
+      const from = this.component[this.index.get(edge.caller.key)!];
+      const to = this.component[this.index.get(edge.callee.key)!];
+      if (from === to) return;
+      const cost = edge.inclusive[event] || 0;
+      incoming[to] += cost;
+      shares[to].set(from, (shares[to].get(from) || 0) + cost);
+    });
+    this.callers = shares.map((bySource, c) => Array.from(bySource.entries())
+      .filter(([, cost]) => cost > 0)
+      .map(([component, cost]) => ({ component, share: cost / incoming[c] })));
+  }
+
+  // Iterative Tarjan; components come out callees first
+  private stronglyConnectedComponents(): Int32Array {
+    const n = this.nodes.length;
+    const component = new Int32Array(n).fill(-1);
+    const order = new Int32Array(n).fill(-1);
+    const low = new Int32Array(n);
+    const onStack = new Uint8Array(n);
+    const stack: number[] = [];
+    let counter = 0;
+    let components = 0;
+    const callees = this.nodes.map(node => node.callees.map(edge => this.index.get(edge.callee.key)!));
+
+    for (let root = 0; root < n; root++) {
+      if (order[root] >= 0) continue;
+      const frames: { node: number; next: number }[] = [{ node: root, next: 0 }];
+      order[root] = low[root] = counter++;
+      stack.push(root);
+      onStack[root] = 1;
+      while (frames.length > 0) {
+        const frame = frames[frames.length - 1];
+        const v = frame.node;
+        if (frame.next < callees[v].length) {
+          const w = callees[v][frame.next++];
+          if (order[w] < 0) {
+            order[w] = low[w] = counter++;
+            stack.push(w);
+            onStack[w] = 1;
+            frames.push({ node: w, next: 0 });
+          } else if (onStack[w]) {
+            low[v] = Math.min(low[v], order[w]);
+          }
+          continue;
+        }
+        frames.pop();
+        if (frames.length > 0) {
+          const parent = frames[frames.length - 1].node;
+          low[parent] = Math.min(low[parent], low[v]);
+        }
+        if (low[v] === order[v]) {
+          let w: number;
+          do {
+            w = stack.pop()!;
+            onStack[w] = 0;
+            component[w] = components;
+          } while (w !== v);
+          components++;
+        }
+      }
+    }
+    return component;
+  }
+
+  indexOf(key: string): number | undefined {
+    return this.index.get(key);
+  }
+
+  baseSelf(i: number): number {
+    return this.self[i];
+  }
+
+  /**
+   * Set how much of node i's self cost is saved and push the difference
+   * up through its ancestors.
+   */
+  setSaving(i: number, saved: number) {
+    const delta = saved - this.savedSelf[i];
+    if (delta === 0) return;
+    this.savedSelf[i] = saved;
+    this.savedTotal += delta;
+
+    // Components are numbered callees first, so taking the lowest pending one
+    // guarantees all of its contributions have arrived
+    const pending = new Map<number, number>([[this.component[i], delta]]);
+    const heap = [this.component[i]];
+    const push = (c: number) => {
+      heap.push(c);
+      for (let k = heap.length - 1; k > 0;) {
+        const parent = (k - 1) >> 1;
+        if (heap[parent] <= heap[k]) break;
+        [heap[parent], heap[k]] = [heap[k], heap[parent]];
+        k = parent;
+      }
+    };
+    const pop = () => {
+      const top = heap[0];
+      const last = heap.pop()!;
+      if (heap.length > 0) {
+        heap[0] = last;
+        for (let k = 0; ;) {
+          const left = 2 * k + 1;
+          const right = left + 1;
+          let smallest = k;
+          if (left < heap.length && heap[left] < heap[smallest]) smallest = left;
+          if (right < heap.length && heap[right] < heap[smallest]) smallest = right;
+          if (smallest === k) break;
+          [heap[smallest], heap[k]] = [heap[k], heap[smallest]];
+          k = smallest;
+        }
+      }
+      return top;
+    };
+
+    while (heap.length > 0) {
+      const c = pop();
+      const amount = pending.get(c)!;
+      pending.delete(c);
+      this.savedInclusive[c] += amount;
+      this.callers[c].forEach(({ component, share }) => {
+        if (!pending.has(component)) {
+          pending.set(component, 0);
+          push(component);
+        }
+        pending.set(component, pending.get(component)! + amount * share);
+      });
+    }
+  }
+
+  /**
+   * Apply a full set of adjustments. Only nodes whose saving changes since
+   * the last call are propagated.
+   */
+  apply(adjustments: WhatIfAdjustment[]) {
+    const remaining = new Map<number, number>();
+    const objectSelf = new Map<string, number>();
+    adjustments.forEach(adjustment => {
+      if (adjustment.target.kind !== 'object') return;
+      const objectFile = adjustment.target.objectFile;
+      if (objectSelf.has(objectFile)) return;
+      objectSelf.set(objectFile, this.nodes.reduce((sum, node, i) => node.objectFile === objectFile ? sum + this.self[i] : sum, 0));
+    });
+
+    adjustments.forEach(adjustment => {
+      const { target } = adjustment;
+      const members = target.kind === 'function'
+        ? [this.index.get(target.key)].filter((i): i is number => i !== undefined)
+        : this.nodes.flatMap((node, i) => node.objectFile === target.objectFile ? [i] : []);
+      const targetSelf = target.kind === 'object' ? objectSelf.get(target.objectFile)! : 0;
+      members.forEach(i => {
+        const current = remaining.get(i) ?? this.self[i];
+        let next = current;
+        if (adjustment.mode === 'factor') {
+          next = current / Math.max(1, adjustment.value);
+        } else {
+          // An object's reduction is spread over its functions by self cost
+          const amount = target.kind === 'object'
+            ? (targetSelf > 0 ? adjustment.value * this.self[i] / targetSelf : 0)
+            : adjustment.value;
+          next = current - amount;
+        }
+        remaining.set(i, Math.max(0, next));
+      });
+    });
+
+    this.savedSelf.forEach((saved, i) => {
+      if (saved !== 0 && !remaining.has(i)) this.setSaving(i, 0);
+    });
+    remaining.forEach((value, i) => this.setSaving(i, this.self[i] - value));
+  }
+
+  get newTotal(): number {
+    return this.baseTotal - this.savedTotal;
+  }
+
+  newSelf(i: number): number {
+    return this.self[i] - this.savedSelf[i];
+  }
+
+  newInclusive(i: number): number {
+    const c = this.component[i];
+    const scale = this.componentInclusive[c] > 0 ? this.inclusive[i] / this.componentInclusive[c] : 0;
+    return Math.max(0, this.inclusive[i] - this.savedInclusive[c] * scale);
+  }
+
+  /**
+   * Amdahl bound: the total if the adjusted functions cost nothing at all.
+   */
+  bestCaseTotal(adjustments: WhatIfAdjustment[]): number {
+    const targeted = new Set<number>();
+    adjustments.forEach(({ target }) => {
+      if (target.kind === 'function') {
+        const i = this.index.get(target.key);
+        if (i !== undefined) targeted.add(i);
+      } else {
+        this.nodes.forEach((node, i) => { if (node.objectFile === target.objectFile) targeted.add(i); });
+      }
+    });
+    let removed = 0;
+    targeted.forEach(i => { removed += this.self[i]; });
+    return this.baseTotal - removed;
+  }
+
+  topHotspots(limit: number): WhatIfHotspot[] {
+    const order = Array.from(this.nodes.keys())
+      .filter(i => this.newSelf(i) > 0)
+      .sort((a, b) => this.newSelf(b) - this.newSelf(a))
+      .slice(0, limit);
+    return order.map(i => ({
+      node: this.nodes[i],
+      self: this.self[i],
+      newSelf: this.newSelf(i),
+      newInclusive: this.newInclusive(i)
+    }));
+  }
+}
@@ -9,10 +9,15 @@ export interface CachegrindData {
   filesAnalyzed: number;
   fileCoverage: Record<string, FileCoverage>;
   summaryTotals: Record<string, number>;
+  eventDescriptions?: Record<string, string>; // event: lines, e.g. sysTime -> "sysTime (elapsed ms)"
   cachegrindFile: string;
   isCallgrind?: boolean;
+  granularity?: ParseGranularity; // Detail kept at parse time; 'instr' when absent
+  sourceDump?: string; // Server path of the dump, used to load omitted detail on demand
 }
 
+export type ParseGranularity = 'function' | 'line' | 'instr';
+
 export interface FileCoverage {
   sourceFilePath: string;
   totalLines: number;
@@ -39,11 +44,30 @@ export interface FunctionData {
   file?: string;
   pcData?: Record<string, PcLineData>; // PC -> line mapping
   calls?: CallInfo[]; // Function calls made by this function
+  jumps?: JumpInfo[]; // Jumps within the function, when recorded with --collect-jumps=yes and kept at instruction granularity
+  recursion?: RecursionInfo; // Set when recursion has been folded into this function
+  prunedCalls?: number; // Set on "[other]" buckets: number of pruned calls folded into it
+}
+
+export interface RecursionInfo {
+  depthTotals: Record<string, number>[]; // Cost per recursion level from --separate-recs; the last level includes all deeper ones
+  maxDepth?: number; // Number of separate recursion levels recorded
+  entries: number; // Calls from outside the recursion
+  reentries: number; // Recursive calls folded into this function
+  cycle?: string[]; // Other functions in the same mutually recursive cycle
+}
+
+export interface JumpInfo {
+  sourcePc: string; // The jump instruction
+  targetPc: string;
+  count: number; // Times the jump was taken
+  executed?: number; // Conditional jumps (jcnd=): times the branch was evaluated, taken or not
 }
 
 export interface CallInfo {
   targetFile?: string; // cfi: target file
   targetFunction?: string; // cfn: target function name
+  targetObject?: string; // cob: target object file
   count: number; // number of calls
   sourcePc: string; // PC where the call is made
   sourceLine?: number; // line number where the call is made
@@ -71,10 +95,20 @@ export interface AssemblyData {
 export interface AssemblyInstruction {
   pc: string;
   instruction: string;
+  line?: number; // Source line from objdump -l, when requested
   events?: Record<string, number>;
   executed?: boolean;
 }
 
+export interface FunctionSymbol {
+  address: string; // hex, e.g. 0x401126
+  size: number; // bytes
+  type: string; // nm symbol type: T/t text, W/w weak
+  name: string;
+  file?: string; // Source file of the definition, from debug info
+  line?: number;
+}
+
 export interface ParsedFile {
   name: string;
   size: number;
@@ -93,4 +127,6 @@ export interface CallTreeNode {
   selfTime: number;
   children: CallTreeNode[];
   calls?: CallInfo[];
+  recursion?: RecursionInfo;
+  prunedCalls?: number;
 }
\ No newline at end of file